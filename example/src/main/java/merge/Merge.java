@@ -0,0 +1,44 @@
+package merge;
+
+import static com.ardikars.jxnet.Jxnet.*;
+
+import com.ardikars.jxnet.*;
+
+/**
+ * Merge savefiles into one savefile ordered by timestamp.
+ * Usage: Merge [-d window] output input...
+ */
+public class Merge {
+
+    public static void main(String[] args) {
+        int window = 0;
+        int first = 0;
+        if (args.length > 1 && args[0].equals("-d")) {
+            window = Integer.parseInt(args[1]);
+            first = 2;
+        }
+        if (args.length - first < 2) {
+            System.err.println("Usage: Merge [-d window] output input...");
+            exit(-1);
+        }
+        String[] inputs = new String[args.length - first - 1];
+        System.arraycopy(args, first + 1, inputs, 0, inputs.length);
+        StringBuilder errbuf = new StringBuilder();
+        PcapMerger merger = PcapMerger.open(inputs, errbuf);
+        if (merger == null) {
+            System.err.println(errbuf.toString());
+            exit(-2);
+        }
+        merger.setDeduplication(window);
+        PcapDumper dumper = PcapDumpOpen(merger.getPcap(), args[first]);
+        long count = merger.dump(dumper);
+        PcapDumpClose(dumper);
+        System.out.println("Merged " + count + " packets, " + merger.getDuplicates() + " duplicates dropped.");
+        merger.close();
+    }
+
+    public static void exit(int status) {
+        System.exit(status);
+    }
+
+}
@@ -11,13 +11,25 @@ LOCAL_MODULE := jxnet
 
 LOCAL_SRC_FILES := \
 	src/jxnet.c \
+	src/bpf.c \
 	src/ids.c \
 	src/utils.c \
 	src/preconditions.c \
-	src/mac_address.c
+	src/mac_address.c \
+	src/packet_ring.c \
+	src/capture_ring.c \
+	src/bpf_jit.c \
+	src/mapped_pcap.c \
+	src/async_dumper.c \
+	src/compressed_file.c \
+	src/packet_summary.c
 
 LOCAL_STATIC_LIBRARIES := libpcap
 
+LOCAL_CFLAGS := -DHAVE_ZLIB
+
+LOCAL_LDLIBS := -lz
+
 LOCAL_C_INCLUDES := $(LOCAL_PATH)/libpcap
 include $(BUILD_SHARED_LIBRARY)
 include $(LOCAL_PATH)/libpcap/Android.mk
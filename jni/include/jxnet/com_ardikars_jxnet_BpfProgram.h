@@ -15,6 +15,38 @@ extern "C" {
 JNIEXPORT void JNICALL Java_com_ardikars_jxnet_BpfProgram_initBpfProgram
   (JNIEnv *, jobject);
 
+/*
+ * Class:     com_ardikars_jxnet_BpfProgram
+ * Method:    matchesBuffer
+ * Signature: (Ljava/nio/ByteBuffer;III)I
+ */
+JNIEXPORT jint JNICALL Java_com_ardikars_jxnet_BpfProgram_matchesBuffer
+  (JNIEnv *, jobject, jobject, jint, jint, jint);
+
+/*
+ * Class:     com_ardikars_jxnet_BpfProgram
+ * Method:    matchesArray
+ * Signature: ([BIII)I
+ */
+JNIEXPORT jint JNICALL Java_com_ardikars_jxnet_BpfProgram_matchesArray
+  (JNIEnv *, jobject, jbyteArray, jint, jint, jint);
+
+/*
+ * Class:     com_ardikars_jxnet_BpfProgram
+ * Method:    matchesBatch
+ * Signature: (Ljava/nio/ByteBuffer;I[J)I
+ */
+JNIEXPORT jint JNICALL Java_com_ardikars_jxnet_BpfProgram_matchesBatch
+  (JNIEnv *, jobject, jobject, jint, jlongArray);
+
+/*
+ * Class:     com_ardikars_jxnet_BpfProgram
+ * Method:    compileJit
+ * Signature: ()Z
+ */
+JNIEXPORT jboolean JNICALL Java_com_ardikars_jxnet_BpfProgram_compileJit
+  (JNIEnv *, jobject);
+
 #ifdef __cplusplus
 }
 #endif
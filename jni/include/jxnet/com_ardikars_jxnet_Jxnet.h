@@ -41,6 +41,38 @@ JNIEXPORT jint JNICALL Java_com_ardikars_jxnet_Jxnet_PcapLoop
 JNIEXPORT jint JNICALL Java_com_ardikars_jxnet_Jxnet_PcapDispatch
   (JNIEnv *, jclass, jobject, jint, jobject, jobject);
 
+/*
+ * Class:     com_ardikars_jxnet_Jxnet
+ * Method:    PcapLoopReuse
+ * Signature: (Lcom/ardikars/jxnet/Pcap;ILcom/ardikars/jxnet/PcapHandler;Ljava/lang/Object;)I
+ */
+JNIEXPORT jint JNICALL Java_com_ardikars_jxnet_Jxnet_PcapLoopReuse
+  (JNIEnv *, jclass, jobject, jint, jobject, jobject);
+
+/*
+ * Class:     com_ardikars_jxnet_Jxnet
+ * Method:    PcapDispatchReuse
+ * Signature: (Lcom/ardikars/jxnet/Pcap;ILcom/ardikars/jxnet/PcapHandler;Ljava/lang/Object;)I
+ */
+JNIEXPORT jint JNICALL Java_com_ardikars_jxnet_Jxnet_PcapDispatchReuse
+  (JNIEnv *, jclass, jobject, jint, jobject, jobject);
+
+/*
+ * Class:     com_ardikars_jxnet_Jxnet
+ * Method:    PcapDispatchBatch
+ * Signature: (Lcom/ardikars/jxnet/Pcap;Ljava/nio/ByteBuffer;I)I
+ */
+JNIEXPORT jint JNICALL Java_com_ardikars_jxnet_Jxnet_PcapDispatchBatch
+  (JNIEnv *, jclass, jobject, jobject, jint);
+
+/*
+ * Class:     com_ardikars_jxnet_Jxnet
+ * Method:    PcapDispatchSummary
+ * Signature: (Lcom/ardikars/jxnet/Pcap;Ljava/nio/ByteBuffer;II)I
+ */
+JNIEXPORT jint JNICALL Java_com_ardikars_jxnet_Jxnet_PcapDispatchSummary
+  (JNIEnv *, jclass, jobject, jobject, jint, jint);
+
 /*
  * Class:     com_ardikars_jxnet_Jxnet
  * Method:    PcapDumpOpen
@@ -89,6 +121,14 @@ JNIEXPORT jint JNICALL Java_com_ardikars_jxnet_Jxnet_PcapSetFilter
 JNIEXPORT jint JNICALL Java_com_ardikars_jxnet_Jxnet_PcapSendPacket
   (JNIEnv *, jclass, jobject, jobject, jint);
 
+/*
+ * Class:     com_ardikars_jxnet_Jxnet
+ * Method:    PcapSendBatch
+ * Signature: (Lcom/ardikars/jxnet/Pcap;Ljava/nio/ByteBuffer;[I[II)I
+ */
+JNIEXPORT jint JNICALL Java_com_ardikars_jxnet_Jxnet_PcapSendBatch
+  (JNIEnv *, jclass, jobject, jobject, jintArray, jintArray, jint);
+
 /*
  * Class:     com_ardikars_jxnet_Jxnet
  * Method:    PcapNext
@@ -393,6 +433,54 @@ JNIEXPORT jint JNICALL Java_com_ardikars_jxnet_Jxnet_PcapActivate
 JNIEXPORT jint JNICALL Java_com_ardikars_jxnet_Jxnet_PcapSetDirection
   (JNIEnv *, jclass, jobject, jobject);
 
+/*
+ * Class:     com_ardikars_jxnet_Jxnet
+ * Method:    PcapSetFanout
+ * Signature: (Lcom/ardikars/jxnet/Pcap;II)I
+ */
+JNIEXPORT jint JNICALL Java_com_ardikars_jxnet_Jxnet_PcapSetFanout
+  (JNIEnv *, jclass, jobject, jint, jint);
+
+/*
+ * Class:     com_ardikars_jxnet_Jxnet
+ * Method:    PcapSetJitFilter
+ * Signature: (Lcom/ardikars/jxnet/Pcap;Lcom/ardikars/jxnet/BpfProgram;)I
+ */
+JNIEXPORT jint JNICALL Java_com_ardikars_jxnet_Jxnet_PcapSetJitFilter
+  (JNIEnv *, jclass, jobject, jobject);
+
+/*
+ * Class:     com_ardikars_jxnet_Jxnet
+ * Method:    PcapGetTStampPrecision
+ * Signature: (Lcom/ardikars/jxnet/Pcap;)I
+ */
+JNIEXPORT jint JNICALL Java_com_ardikars_jxnet_Jxnet_PcapGetTStampPrecision
+  (JNIEnv *, jclass, jobject);
+
+/*
+ * Class:     com_ardikars_jxnet_Jxnet
+ * Method:    PcapDumpOpenCompressed
+ * Signature: (Lcom/ardikars/jxnet/Pcap;Ljava/lang/String;II)Lcom/ardikars/jxnet/PcapDumper;
+ */
+JNIEXPORT jobject JNICALL Java_com_ardikars_jxnet_Jxnet_PcapDumpOpenCompressed
+  (JNIEnv *, jclass, jobject, jstring, jint, jint);
+
+/*
+ * Class:     com_ardikars_jxnet_Jxnet
+ * Method:    PcapDumpBatch
+ * Signature: (Lcom/ardikars/jxnet/PcapDumper;Ljava/nio/ByteBuffer;I)I
+ */
+JNIEXPORT jint JNICALL Java_com_ardikars_jxnet_Jxnet_PcapDumpBatch__Lcom_ardikars_jxnet_PcapDumper_2Ljava_nio_ByteBuffer_2I
+  (JNIEnv *, jclass, jobject, jobject, jint);
+
+/*
+ * Class:     com_ardikars_jxnet_Jxnet
+ * Method:    PcapDumpBatch
+ * Signature: (Lcom/ardikars/jxnet/PcapDumper;[BI)I
+ */
+JNIEXPORT jint JNICALL Java_com_ardikars_jxnet_Jxnet_PcapDumpBatch__Lcom_ardikars_jxnet_PcapDumper_2_3BI
+  (JNIEnv *, jclass, jobject, jbyteArray, jint);
+
 #ifdef __cplusplus
 }
 #endif
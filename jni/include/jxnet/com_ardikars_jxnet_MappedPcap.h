@@ -0,0 +1,55 @@
+/* DO NOT EDIT THIS FILE - it is machine generated */
+#include <jni.h>
+/* Header for class com_ardikars_jxnet_MappedPcap */
+
+#ifndef _Included_com_ardikars_jxnet_MappedPcap
+#define _Included_com_ardikars_jxnet_MappedPcap
+#ifdef __cplusplus
+extern "C" {
+#endif
+#undef com_ardikars_jxnet_MappedPcap_FILE_HEADER_LENGTH
+#define com_ardikars_jxnet_MappedPcap_FILE_HEADER_LENGTH 24L
+#undef com_ardikars_jxnet_MappedPcap_RECORD_HEADER_LENGTH
+#define com_ardikars_jxnet_MappedPcap_RECORD_HEADER_LENGTH 16L
+#undef com_ardikars_jxnet_MappedPcap_DEFAULT_WINDOW_SIZE
+#define com_ardikars_jxnet_MappedPcap_DEFAULT_WINDOW_SIZE 67108864L
+#undef com_ardikars_jxnet_MappedPcap_MAGIC
+#define com_ardikars_jxnet_MappedPcap_MAGIC -1582119980L
+#undef com_ardikars_jxnet_MappedPcap_MAGIC_NSEC
+#define com_ardikars_jxnet_MappedPcap_MAGIC_NSEC -1582154675L
+/*
+ * Class:     com_ardikars_jxnet_MappedPcap
+ * Method:    openFile
+ * Signature: (Ljava/lang/String;Ljava/lang/StringBuilder;)J
+ */
+JNIEXPORT jlong JNICALL Java_com_ardikars_jxnet_MappedPcap_openFile
+  (JNIEnv *, jclass, jstring, jobject);
+
+/*
+ * Class:     com_ardikars_jxnet_MappedPcap
+ * Method:    fileSize
+ * Signature: (J)J
+ */
+JNIEXPORT jlong JNICALL Java_com_ardikars_jxnet_MappedPcap_fileSize
+  (JNIEnv *, jclass, jlong);
+
+/*
+ * Class:     com_ardikars_jxnet_MappedPcap
+ * Method:    mapWindow
+ * Signature: (JJI)Ljava/nio/ByteBuffer;
+ */
+JNIEXPORT jobject JNICALL Java_com_ardikars_jxnet_MappedPcap_mapWindow
+  (JNIEnv *, jclass, jlong, jlong, jint);
+
+/*
+ * Class:     com_ardikars_jxnet_MappedPcap
+ * Method:    closeFile
+ * Signature: (J)V
+ */
+JNIEXPORT void JNICALL Java_com_ardikars_jxnet_MappedPcap_closeFile
+  (JNIEnv *, jclass, jlong);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
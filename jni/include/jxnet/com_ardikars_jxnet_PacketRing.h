@@ -0,0 +1,85 @@
+/* DO NOT EDIT THIS FILE - it is machine generated */
+#include <jni.h>
+/* Header for class com_ardikars_jxnet_PacketRing */
+
+#ifndef _Included_com_ardikars_jxnet_PacketRing
+#define _Included_com_ardikars_jxnet_PacketRing
+#ifdef __cplusplus
+extern "C" {
+#endif
+#undef com_ardikars_jxnet_PacketRing_BLOCK_STATUS_OFFSET
+#define com_ardikars_jxnet_PacketRing_BLOCK_STATUS_OFFSET 8L
+#undef com_ardikars_jxnet_PacketRing_BLOCK_NUM_PKTS_OFFSET
+#define com_ardikars_jxnet_PacketRing_BLOCK_NUM_PKTS_OFFSET 12L
+#undef com_ardikars_jxnet_PacketRing_BLOCK_FIRST_PKT_OFFSET
+#define com_ardikars_jxnet_PacketRing_BLOCK_FIRST_PKT_OFFSET 16L
+#undef com_ardikars_jxnet_PacketRing_BLOCK_SEQ_NUM_OFFSET
+#define com_ardikars_jxnet_PacketRing_BLOCK_SEQ_NUM_OFFSET 24L
+#undef com_ardikars_jxnet_PacketRing_PKT_NEXT_OFFSET
+#define com_ardikars_jxnet_PacketRing_PKT_NEXT_OFFSET 0L
+#undef com_ardikars_jxnet_PacketRing_PKT_SEC_OFFSET
+#define com_ardikars_jxnet_PacketRing_PKT_SEC_OFFSET 4L
+#undef com_ardikars_jxnet_PacketRing_PKT_NSEC_OFFSET
+#define com_ardikars_jxnet_PacketRing_PKT_NSEC_OFFSET 8L
+#undef com_ardikars_jxnet_PacketRing_PKT_SNAPLEN_OFFSET
+#define com_ardikars_jxnet_PacketRing_PKT_SNAPLEN_OFFSET 12L
+#undef com_ardikars_jxnet_PacketRing_PKT_LEN_OFFSET
+#define com_ardikars_jxnet_PacketRing_PKT_LEN_OFFSET 16L
+#undef com_ardikars_jxnet_PacketRing_PKT_STATUS_OFFSET
+#define com_ardikars_jxnet_PacketRing_PKT_STATUS_OFFSET 20L
+#undef com_ardikars_jxnet_PacketRing_PKT_MAC_OFFSET
+#define com_ardikars_jxnet_PacketRing_PKT_MAC_OFFSET 24L
+#undef com_ardikars_jxnet_PacketRing_PKT_RXHASH_OFFSET
+#define com_ardikars_jxnet_PacketRing_PKT_RXHASH_OFFSET 28L
+/*
+ * Class:     com_ardikars_jxnet_PacketRing
+ * Method:    openRing
+ * Signature: (Ljava/lang/String;IIIZLjava/lang/StringBuilder;)J
+ */
+JNIEXPORT jlong JNICALL Java_com_ardikars_jxnet_PacketRing_openRing
+  (JNIEnv *, jclass, jstring, jint, jint, jint, jboolean, jobject);
+
+/*
+ * Class:     com_ardikars_jxnet_PacketRing
+ * Method:    mapRing
+ * Signature: (J)Ljava/nio/ByteBuffer;
+ */
+JNIEXPORT jobject JNICALL Java_com_ardikars_jxnet_PacketRing_mapRing
+  (JNIEnv *, jclass, jlong);
+
+/*
+ * Class:     com_ardikars_jxnet_PacketRing
+ * Method:    nextBlock
+ * Signature: (JI)I
+ */
+JNIEXPORT jint JNICALL Java_com_ardikars_jxnet_PacketRing_nextBlock
+  (JNIEnv *, jclass, jlong, jint);
+
+/*
+ * Class:     com_ardikars_jxnet_PacketRing
+ * Method:    releaseBlock
+ * Signature: (J)V
+ */
+JNIEXPORT void JNICALL Java_com_ardikars_jxnet_PacketRing_releaseBlock
+  (JNIEnv *, jclass, jlong);
+
+/*
+ * Class:     com_ardikars_jxnet_PacketRing
+ * Method:    setFilter
+ * Signature: (JLcom/ardikars/jxnet/BpfProgram;)I
+ */
+JNIEXPORT jint JNICALL Java_com_ardikars_jxnet_PacketRing_setFilter
+  (JNIEnv *, jclass, jlong, jobject);
+
+/*
+ * Class:     com_ardikars_jxnet_PacketRing
+ * Method:    closeRing
+ * Signature: (J)V
+ */
+JNIEXPORT void JNICALL Java_com_ardikars_jxnet_PacketRing_closeRing
+  (JNIEnv *, jclass, jlong);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
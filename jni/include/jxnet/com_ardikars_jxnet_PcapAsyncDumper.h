@@ -0,0 +1,57 @@
+/* DO NOT EDIT THIS FILE - it is machine generated */
+#include <jni.h>
+/* Header for class com_ardikars_jxnet_PcapAsyncDumper */
+
+#ifndef _Included_com_ardikars_jxnet_PcapAsyncDumper
+#define _Included_com_ardikars_jxnet_PcapAsyncDumper
+#ifdef __cplusplus
+extern "C" {
+#endif
+#undef com_ardikars_jxnet_PcapAsyncDumper_DEFAULT_BUFFER_SIZE
+#define com_ardikars_jxnet_PcapAsyncDumper_DEFAULT_BUFFER_SIZE 4194304L
+#undef com_ardikars_jxnet_PcapAsyncDumper_DEFAULT_BUFFER_COUNT
+#define com_ardikars_jxnet_PcapAsyncDumper_DEFAULT_BUFFER_COUNT 16L
+/*
+ * Class:     com_ardikars_jxnet_PcapAsyncDumper
+ * Method:    openDumper
+ * Signature: (Lcom/ardikars/jxnet/Pcap;Ljava/lang/String;IIZJLjava/lang/StringBuilder;)J
+ */
+JNIEXPORT jlong JNICALL Java_com_ardikars_jxnet_PcapAsyncDumper_openDumper
+  (JNIEnv *, jclass, jobject, jstring, jint, jint, jboolean, jlong, jobject);
+
+/*
+ * Class:     com_ardikars_jxnet_PcapAsyncDumper
+ * Method:    dump
+ * Signature: (JIIIILjava/nio/ByteBuffer;I)I
+ */
+JNIEXPORT jint JNICALL Java_com_ardikars_jxnet_PcapAsyncDumper_dump
+  (JNIEnv *, jclass, jlong, jint, jint, jint, jint, jobject, jint);
+
+/*
+ * Class:     com_ardikars_jxnet_PcapAsyncDumper
+ * Method:    dispatch
+ * Signature: (JLcom/ardikars/jxnet/Pcap;IZ)I
+ */
+JNIEXPORT jint JNICALL Java_com_ardikars_jxnet_PcapAsyncDumper_dispatch
+  (JNIEnv *, jclass, jlong, jobject, jint, jboolean);
+
+/*
+ * Class:     com_ardikars_jxnet_PcapAsyncDumper
+ * Method:    stats
+ * Signature: (J[J)V
+ */
+JNIEXPORT void JNICALL Java_com_ardikars_jxnet_PcapAsyncDumper_stats
+  (JNIEnv *, jclass, jlong, jlongArray);
+
+/*
+ * Class:     com_ardikars_jxnet_PcapAsyncDumper
+ * Method:    closeDumper
+ * Signature: (JLjava/lang/StringBuilder;)I
+ */
+JNIEXPORT jint JNICALL Java_com_ardikars_jxnet_PcapAsyncDumper_closeDumper
+  (JNIEnv *, jclass, jlong, jobject);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
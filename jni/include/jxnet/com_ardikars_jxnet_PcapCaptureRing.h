@@ -0,0 +1,81 @@
+/* DO NOT EDIT THIS FILE - it is machine generated */
+#include <jni.h>
+/* Header for class com_ardikars_jxnet_PcapCaptureRing */
+
+#ifndef _Included_com_ardikars_jxnet_PcapCaptureRing
+#define _Included_com_ardikars_jxnet_PcapCaptureRing
+#ifdef __cplusplus
+extern "C" {
+#endif
+#undef com_ardikars_jxnet_PcapCaptureRing_HEADER_LENGTH
+#define com_ardikars_jxnet_PcapCaptureRing_HEADER_LENGTH 16L
+#undef com_ardikars_jxnet_PcapCaptureRing_HEAD_OFFSET
+#define com_ardikars_jxnet_PcapCaptureRing_HEAD_OFFSET 0L
+#undef com_ardikars_jxnet_PcapCaptureRing_TAIL_OFFSET
+#define com_ardikars_jxnet_PcapCaptureRing_TAIL_OFFSET 64L
+#undef com_ardikars_jxnet_PcapCaptureRing_STATUS_OFFSET
+#define com_ardikars_jxnet_PcapCaptureRing_STATUS_OFFSET 128L
+#undef com_ardikars_jxnet_PcapCaptureRing_DROPPED_OFFSET
+#define com_ardikars_jxnet_PcapCaptureRing_DROPPED_OFFSET 136L
+#undef com_ardikars_jxnet_PcapCaptureRing_DATA_OFFSET
+#define com_ardikars_jxnet_PcapCaptureRing_DATA_OFFSET 192L
+/*
+ * Class:     com_ardikars_jxnet_PcapCaptureRing
+ * Method:    startRing
+ * Signature: (Lcom/ardikars/jxnet/Pcap;I)J
+ */
+JNIEXPORT jlong JNICALL Java_com_ardikars_jxnet_PcapCaptureRing_startRing
+  (JNIEnv *, jclass, jobject, jint);
+
+/*
+ * Class:     com_ardikars_jxnet_PcapCaptureRing
+ * Method:    mapRing
+ * Signature: (J)Ljava/nio/ByteBuffer;
+ */
+JNIEXPORT jobject JNICALL Java_com_ardikars_jxnet_PcapCaptureRing_mapRing
+  (JNIEnv *, jclass, jlong);
+
+/*
+ * Class:     com_ardikars_jxnet_PcapCaptureRing
+ * Method:    sharedAddress
+ * Signature: (J)J
+ */
+JNIEXPORT jlong JNICALL Java_com_ardikars_jxnet_PcapCaptureRing_sharedAddress
+  (JNIEnv *, jclass, jlong);
+
+/*
+ * Class:     com_ardikars_jxnet_PcapCaptureRing
+ * Method:    loadVolatile
+ * Signature: (J)J
+ */
+JNIEXPORT jlong JNICALL Java_com_ardikars_jxnet_PcapCaptureRing_loadVolatile
+  (JNIEnv *, jclass, jlong);
+
+/*
+ * Class:     com_ardikars_jxnet_PcapCaptureRing
+ * Method:    storeOrdered
+ * Signature: (JJ)V
+ */
+JNIEXPORT void JNICALL Java_com_ardikars_jxnet_PcapCaptureRing_storeOrdered
+  (JNIEnv *, jclass, jlong, jlong);
+
+/*
+ * Class:     com_ardikars_jxnet_PcapCaptureRing
+ * Method:    stopRing
+ * Signature: (J)V
+ */
+JNIEXPORT void JNICALL Java_com_ardikars_jxnet_PcapCaptureRing_stopRing
+  (JNIEnv *, jclass, jlong);
+
+/*
+ * Class:     com_ardikars_jxnet_PcapCaptureRing
+ * Method:    closeRing
+ * Signature: (J)V
+ */
+JNIEXPORT void JNICALL Java_com_ardikars_jxnet_PcapCaptureRing_closeRing
+  (JNIEnv *, jclass, jlong);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -0,0 +1,467 @@
+/**
+ * Copyright (C) 2017  Ardika Rommy Sanjaya
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE
+#endif
+
+#include <jni.h>
+#include <pcap.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../include/jxnet/com_ardikars_jxnet_PcapAsyncDumper.h"
+#include "ids.h"
+#include "utils.h"
+#include "preconditions.h"
+
+#if !defined(WIN32)
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <unistd.h>
+
+#define ASYNC_DUMPER_ALIGN 4096
+
+/* classic savefile headers, written in host byte order like pcap_dump_open() does */
+typedef struct async_dumper_file_header {
+	bpf_u_int32 magic;
+	u_short version_major;
+	u_short version_minor;
+	bpf_int32 thiszone;
+	bpf_u_int32 sigfigs;
+	bpf_u_int32 snaplen;
+	bpf_u_int32 linktype;
+} async_dumper_file_header_t;
+
+typedef struct async_dumper_pkthdr {
+	bpf_u_int32 tv_sec;
+	bpf_u_int32 tv_usec;
+	bpf_u_int32 caplen;
+	bpf_u_int32 len;
+} async_dumper_pkthdr_t;
+
+/*
+ * The file is written as one byte stream cut into buffer_count buffers of buffer_size bytes,
+ * used round robin. The capture thread fills buffer (produced % buffer_count) and hands it over
+ * when it is exactly full, so every write() but the last one is buffer_size long and aligned,
+ * as O_DIRECT requires. The writer thread writes buffers in order; a buffer can be filled again
+ * once written. Nothing ever blocks the capture thread: a packet that does not fit in the free
+ * buffers is dropped and counted.
+ */
+typedef struct async_dumper {
+	int fd;
+	int direct;
+	u_char *buffers;
+	size_t buffer_size;
+	unsigned int buffer_count;
+	size_t fill;
+	uint64_t produced;
+	uint64_t written;
+	uint64_t bytes_written;
+	uint64_t packets;
+	uint64_t dropped;
+	int error;
+	int running;
+	int started;
+	pthread_mutex_t lock;
+	pthread_cond_t cond;
+	pthread_t thread;
+} async_dumper_t;
+
+static async_dumper_t *GetAsyncDumper(JNIEnv *env, jlong address) {
+	async_dumper_t *dumper = (async_dumper_t *) JlongToPointer(address);
+	if (dumper == NULL) {
+		ThrowNew(env, ILLEGAL_STATE_EXCEPTION, "PcapAsyncDumper is closed.");
+	}
+	return dumper;
+}
+
+static u_char *async_dumper_buffer(async_dumper_t *dumper, uint64_t seq) {
+	return dumper->buffers + (size_t) (seq % dumper->buffer_count) * dumper->buffer_size;
+}
+
+static int async_dumper_write(async_dumper_t *dumper, const u_char *buf, size_t len) {
+	while (len > 0) {
+		ssize_t n = write(dumper->fd, buf, len);
+		if (n < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+			return errno;
+		}
+		buf += n;
+		len -= (size_t) n;
+		__atomic_add_fetch(&dumper->bytes_written, (uint64_t) n, __ATOMIC_RELAXED);
+	}
+	return 0;
+}
+
+static void *async_dumper_run(void *arg) {
+	async_dumper_t *dumper = (async_dumper_t *) arg;
+	for (;;) {
+		pthread_mutex_lock(&dumper->lock);
+		while (dumper->written == __atomic_load_n(&dumper->produced, __ATOMIC_ACQUIRE) && dumper->running) {
+			pthread_cond_wait(&dumper->cond, &dumper->lock);
+		}
+		uint64_t produced = __atomic_load_n(&dumper->produced, __ATOMIC_ACQUIRE);
+		pthread_mutex_unlock(&dumper->lock);
+		if (dumper->written == produced) {
+			break;
+		}
+		while (dumper->written < produced) {
+			if (dumper->error == 0) {
+				dumper->error = async_dumper_write(dumper,
+						async_dumper_buffer(dumper, dumper->written), dumper->buffer_size);
+			}
+			__atomic_store_n(&dumper->written, dumper->written + 1, __ATOMIC_RELEASE);
+		}
+	}
+	return NULL;
+}
+
+/* capture thread only */
+static int async_dumper_append(async_dumper_t *dumper, const u_char *p1, size_t len1, const u_char *p2, size_t len2) {
+	uint64_t free_buffers = dumper->buffer_count
+			- (dumper->produced - __atomic_load_n(&dumper->written, __ATOMIC_ACQUIRE));
+	if (free_buffers == 0
+			|| len1 + len2 > (dumper->buffer_size - dumper->fill) + (free_buffers - 1) * dumper->buffer_size) {
+		__atomic_store_n(&dumper->dropped, dumper->dropped + 1, __ATOMIC_RELAXED);
+		return -1;
+	}
+	const u_char *p = p1;
+	size_t len = len1;
+	int part;
+	for (part = 0; part < 2; part++) {
+		while (len > 0) {
+			size_t n = dumper->buffer_size - dumper->fill;
+			if (n > len) {
+				n = len;
+			}
+			memcpy(async_dumper_buffer(dumper, dumper->produced) + dumper->fill, p, n);
+			dumper->fill += n;
+			p += n;
+			len -= n;
+			if (dumper->fill == dumper->buffer_size) {
+				dumper->fill = 0;
+				pthread_mutex_lock(&dumper->lock);
+				__atomic_store_n(&dumper->produced, dumper->produced + 1, __ATOMIC_RELEASE);
+				pthread_cond_signal(&dumper->cond);
+				pthread_mutex_unlock(&dumper->lock);
+			}
+		}
+		p = p2;
+		len = len2;
+	}
+	__atomic_store_n(&dumper->packets, dumper->packets + 1, __ATOMIC_RELAXED);
+	return 0;
+}
+
+static int async_dumper_dump(async_dumper_t *dumper, bpf_u_int32 tv_sec, bpf_u_int32 tv_usec,
+		bpf_u_int32 caplen, bpf_u_int32 len, const u_char *data) {
+	async_dumper_pkthdr_t hdr;
+	hdr.tv_sec = tv_sec;
+	hdr.tv_usec = tv_usec;
+	hdr.caplen = caplen;
+	hdr.len = len;
+	return async_dumper_append(dumper, (const u_char *) &hdr, sizeof(hdr), data, caplen);
+}
+
+/* User data of one dispatch: the filter of the Pcap is taken for each call, never kept */
+typedef struct async_dumper_dispatch {
+	async_dumper_t *dumper;
+	bpf_jit_filter_t *filter;
+} async_dumper_dispatch_t;
+
+static void async_dumper_callback(u_char *user, const struct pcap_pkthdr *pkt_header, const u_char *pkt_data) {
+	async_dumper_dispatch_t *dispatch = (async_dumper_dispatch_t *) user;
+	if (dispatch->filter != NULL
+			&& bpf_jit_filter_run(dispatch->filter, pkt_data, pkt_header->len, pkt_header->caplen) == 0) {
+		return;
+	}
+	async_dumper_dump(dispatch->dumper, (bpf_u_int32) pkt_header->ts.tv_sec, (bpf_u_int32) pkt_header->ts.tv_usec,
+			pkt_header->caplen, pkt_header->len, pkt_data);
+}
+
+static void async_dumper_free(async_dumper_t *dumper) {
+	if (dumper->fd >= 0) {
+		close(dumper->fd);
+	}
+	pthread_cond_destroy(&dumper->cond);
+	pthread_mutex_destroy(&dumper->lock);
+	free(dumper->buffers);
+	free(dumper);
+}
+
+#endif
+
+/*
+ * Class:     com_ardikars_jxnet_PcapAsyncDumper
+ * Method:    openDumper
+ * Signature: (Lcom/ardikars/jxnet/Pcap;Ljava/lang/String;IIZJLjava/lang/StringBuilder;)J
+ */
+JNIEXPORT jlong JNICALL Java_com_ardikars_jxnet_PcapAsyncDumper_openDumper
+  (JNIEnv *env, jclass jcls, jobject jpcap, jstring jfname, jint jbuffer_size, jint jbuffer_count,
+		  jboolean jdirect, jlong jpreallocate, jobject jerrbuf) {
+
+#if defined(WIN32)
+	ThrowNew(env, NOT_SUPPORTED_PLATFORM_EXCEPTION, NULL);
+	return 0;
+#else
+
+	if (CheckNotNull(env, jpcap, NULL) == NULL) return 0;
+	if (CheckNotNull(env, jfname, NULL) == NULL) return 0;
+	if (CheckNotNull(env, jerrbuf, NULL) == NULL) return 0;
+	if (!CheckArgument(env, (jbuffer_size >= ASYNC_DUMPER_ALIGN && (jbuffer_size % ASYNC_DUMPER_ALIGN) == 0),
+			"Buffer size must be a multiple of 4096.")) return 0;
+	if (!CheckArgument(env, (jbuffer_count >= 2), "Buffer count must be at least 2.")) return 0;
+	if (!CheckArgument(env, (jpreallocate >= 0), NULL)) return 0;
+
+	pcap_t *pcap = GetPcap(env, jpcap); // Exception already thrown
+
+	if (pcap == NULL) {
+		return 0;
+	}
+
+	async_dumper_t *dumper = (async_dumper_t *) calloc(1, sizeof(async_dumper_t));
+	void *buffers = NULL;
+
+	if (dumper == NULL || posix_memalign(&buffers, ASYNC_DUMPER_ALIGN, (size_t) jbuffer_size * (size_t) jbuffer_count) != 0) {
+		free(dumper);
+		SetStringBuilder(env, jerrbuf, "PcapAsyncDumper out of memory");
+		return 0;
+	}
+
+	dumper->buffers = (u_char *) buffers;
+	dumper->buffer_size = (size_t) jbuffer_size;
+	dumper->buffer_count = (unsigned int) jbuffer_count;
+	pthread_mutex_init(&dumper->lock, NULL);
+	pthread_cond_init(&dumper->cond, NULL);
+
+	int flags = O_WRONLY | O_CREAT | O_TRUNC;
+#ifdef O_DIRECT
+	if (jdirect == JNI_TRUE) {
+		flags |= O_DIRECT;
+		dumper->direct = 1;
+	}
+#endif
+
+	const char *fname = (*env)->GetStringUTFChars(env, jfname, 0);
+	dumper->fd = open(fname, flags, 0644);
+	(*env)->ReleaseStringUTFChars(env, jfname, fname);
+
+	if (dumper->fd < 0) {
+		SetStringBuilder(env, jerrbuf, strerror(errno));
+		async_dumper_free(dumper);
+		return 0;
+	}
+
+#if defined(HAVE_FALLOCATE) && defined(FALLOC_FL_KEEP_SIZE)
+	if (jpreallocate > 0) {
+		fallocate(dumper->fd, FALLOC_FL_KEEP_SIZE, 0, (off_t) jpreallocate); // best effort
+	}
+#endif
+
+	async_dumper_file_header_t hdr;
+	hdr.magic = 0xa1b2c3d4;
+#ifdef PCAP_TSTAMP_PRECISION_NANO
+	if (pcap_get_tstamp_precision(pcap) == PCAP_TSTAMP_PRECISION_NANO) {
+		hdr.magic = 0xa1b23c4d;
+	}
+#endif
+	hdr.version_major = PCAP_VERSION_MAJOR;
+	hdr.version_minor = PCAP_VERSION_MINOR;
+	hdr.thiszone = 0;
+	hdr.sigfigs = 0;
+	hdr.snaplen = (bpf_u_int32) pcap_snapshot(pcap);
+	hdr.linktype = (bpf_u_int32) pcap_datalink(pcap);
+	memcpy(dumper->buffers, &hdr, sizeof(hdr));
+	dumper->fill = sizeof(hdr);
+	dumper->running = 1;
+
+	if (pthread_create(&dumper->thread, NULL, async_dumper_run, dumper) != 0) {
+		SetStringBuilder(env, jerrbuf, "Unable to start writer thread");
+		async_dumper_free(dumper);
+		return 0;
+	}
+	dumper->started = 1;
+
+	return PointerToJlong(dumper);
+#endif
+  }
+
+/*
+ * Class:     com_ardikars_jxnet_PcapAsyncDumper
+ * Method:    dump
+ * Signature: (JIIIILjava/nio/ByteBuffer;I)I
+ */
+JNIEXPORT jint JNICALL Java_com_ardikars_jxnet_PcapAsyncDumper_dump
+  (JNIEnv *env, jclass jcls, jlong jaddress, jint jtv_sec, jint jtv_usec, jint jcaplen, jint jlen,
+		  jobject jbuf, jint joffset) {
+
+#if defined(WIN32)
+	ThrowNew(env, NOT_SUPPORTED_PLATFORM_EXCEPTION, NULL);
+	return -1;
+#else
+	async_dumper_t *dumper = GetAsyncDumper(env, jaddress); // Exception already thrown
+
+	if (dumper == NULL) {
+		return -1;
+	}
+
+	if (CheckNotNull(env, jbuf, NULL) == NULL) return -1;
+
+	u_char *buf = (u_char *) (*env)->GetDirectBufferAddress(env, jbuf);
+
+	if (buf == NULL) {
+		ThrowNew(env, ILLEGAL_ARGUMENT_EXCEPTION, "Buffer must be direct.");
+		return -1;
+	}
+
+	if (!CheckArgument(env, (joffset >= 0 && jcaplen >= 0
+			&& (jlong) joffset + jcaplen <= (*env)->GetDirectBufferCapacity(env, jbuf)), NULL)) return -1;
+
+	return (jint) async_dumper_dump(dumper, (bpf_u_int32) jtv_sec, (bpf_u_int32) jtv_usec,
+			(bpf_u_int32) jcaplen, (bpf_u_int32) jlen, buf + joffset);
+#endif
+  }
+
+/*
+ * Class:     com_ardikars_jxnet_PcapAsyncDumper
+ * Method:    dispatch
+ * Signature: (JLcom/ardikars/jxnet/Pcap;IZ)I
+ */
+JNIEXPORT jint JNICALL Java_com_ardikars_jxnet_PcapAsyncDumper_dispatch
+  (JNIEnv *env, jclass jcls, jlong jaddress, jobject jpcap, jint jcnt, jboolean jloop) {
+
+#if defined(WIN32)
+	ThrowNew(env, NOT_SUPPORTED_PLATFORM_EXCEPTION, NULL);
+	return -1;
+#else
+	async_dumper_t *dumper = GetAsyncDumper(env, jaddress); // Exception already thrown
+
+	if (dumper == NULL) {
+		return -1;
+	}
+
+	if (CheckNotNull(env, jpcap, NULL) == NULL) return -1;
+
+	pcap_t *pcap = GetPcap(env, jpcap); // Exception already thrown
+
+	if (pcap == NULL) {
+		return -1;
+	}
+
+	async_dumper_dispatch_t dispatch;
+	dispatch.dumper = dumper;
+	dispatch.filter = AcquirePcapFilter(env, jpcap);
+
+	int r;
+	if (jloop == JNI_TRUE) {
+		r = pcap_loop(pcap, (int) jcnt, async_dumper_callback, (u_char *) &dispatch);
+	} else {
+		r = pcap_dispatch(pcap, (int) jcnt, async_dumper_callback, (u_char *) &dispatch);
+	}
+	bpf_jit_filter_free(dispatch.filter);
+	return r;
+#endif
+  }
+
+/*
+ * Class:     com_ardikars_jxnet_PcapAsyncDumper
+ * Method:    stats
+ * Signature: (J[J)V
+ */
+JNIEXPORT void JNICALL Java_com_ardikars_jxnet_PcapAsyncDumper_stats
+  (JNIEnv *env, jclass jcls, jlong jaddress, jlongArray jstats) {
+
+#if defined(WIN32)
+	ThrowNew(env, NOT_SUPPORTED_PLATFORM_EXCEPTION, NULL);
+#else
+	async_dumper_t *dumper = GetAsyncDumper(env, jaddress); // Exception already thrown
+
+	if (dumper == NULL) {
+		return;
+	}
+
+	if (CheckNotNull(env, jstats, NULL) == NULL) return;
+	if (!CheckArgument(env, ((*env)->GetArrayLength(env, jstats) >= 4), NULL)) return;
+
+	jlong stats[4];
+	stats[0] = (jlong) (__atomic_load_n(&dumper->produced, __ATOMIC_ACQUIRE)
+			- __atomic_load_n(&dumper->written, __ATOMIC_ACQUIRE));
+	stats[1] = (jlong) __atomic_load_n(&dumper->bytes_written, __ATOMIC_RELAXED);
+	stats[2] = (jlong) __atomic_load_n(&dumper->dropped, __ATOMIC_RELAXED);
+	stats[3] = (jlong) __atomic_load_n(&dumper->packets, __ATOMIC_RELAXED);
+	(*env)->SetLongArrayRegion(env, jstats, 0, 4, stats);
+#endif
+  }
+
+/*
+ * Class:     com_ardikars_jxnet_PcapAsyncDumper
+ * Method:    closeDumper
+ * Signature: (JLjava/lang/StringBuilder;)I
+ */
+JNIEXPORT jint JNICALL Java_com_ardikars_jxnet_PcapAsyncDumper_closeDumper
+  (JNIEnv *env, jclass jcls, jlong jaddress, jobject jerrbuf) {
+
+#if defined(WIN32)
+	ThrowNew(env, NOT_SUPPORTED_PLATFORM_EXCEPTION, NULL);
+	return -1;
+#else
+	async_dumper_t *dumper = (async_dumper_t *) JlongToPointer(jaddress);
+
+	if (dumper == NULL) {
+		return 0;
+	}
+
+	if (dumper->started) {
+		pthread_mutex_lock(&dumper->lock);
+		dumper->running = 0;
+		pthread_cond_signal(&dumper->cond);
+		pthread_mutex_unlock(&dumper->lock);
+		pthread_join(dumper->thread, NULL);
+		dumper->started = 0;
+	}
+
+	/* the last, partial buffer: O_DIRECT only takes whole blocks */
+	if (dumper->error == 0 && dumper->fill > 0) {
+#ifdef O_DIRECT
+		if (dumper->direct) {
+			fcntl(dumper->fd, F_SETFL, fcntl(dumper->fd, F_GETFL) & ~O_DIRECT);
+		}
+#endif
+		dumper->error = async_dumper_write(dumper, async_dumper_buffer(dumper, dumper->produced), dumper->fill);
+	}
+
+	int error = dumper->error;
+	if (close(dumper->fd) < 0 && error == 0) {
+		error = errno;
+	}
+	dumper->fd = -1;
+	async_dumper_free(dumper);
+
+	if (error != 0) {
+		if (jerrbuf != NULL) {
+			SetStringBuilder(env, jerrbuf, strerror(error));
+		}
+		return -1;
+	}
+	return 0;
+#endif
+  }
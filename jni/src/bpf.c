@@ -16,7 +16,9 @@
  */
 
 #include <pcap.h>
+#include <stdint.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "ids.h"
 #include "utils.h"
@@ -45,4 +47,178 @@ JNIEXPORT void JNICALL Java_com_ardikars_jxnet_BpfProgram_initBpfProgram
 
         SetBpfProgram(env, jobj, fp);
   }
-  
\ No newline at end of file
+  
+static struct bpf_program *GetCompiledBpfProgram(JNIEnv *env, jobject jobj) {
+	struct bpf_program *fp = GetBpfProgram(env, jobj); // Exception already thrown
+	if (fp == NULL) {
+		return NULL;
+	}
+	if (fp->bf_insns == NULL) {
+		ThrowNew(env, ILLEGAL_STATE_EXCEPTION, "BpfProgram is not compiled.");
+		return NULL;
+	}
+	return fp;
+}
+
+static bpf_jit_filter_t *GetBpfJitFilter(JNIEnv *env, jobject jobj) {
+	return (bpf_jit_filter_t *) JlongToPointer((*env)->GetLongField(env, jobj, BpfProgramJitAddressFID));
+}
+
+/* run the JIT-compiled copy of the program if there is one, the interpreter otherwise */
+static u_int bpf_program_run(const struct bpf_program *fp, const bpf_jit_filter_t *filter,
+		const u_char *p, u_int wirelen, u_int buflen) {
+	if (filter != NULL) {
+		return bpf_jit_filter_run(filter, p, wirelen, buflen);
+	}
+	return bpf_filter(fp->bf_insns, p, wirelen, buflen);
+}
+
+/*
+ * Class:     com_ardikars_jxnet_BpfProgram
+ * Method:    compileJit
+ * Signature: ()Z
+ */
+JNIEXPORT jboolean JNICALL Java_com_ardikars_jxnet_BpfProgram_compileJit
+  (JNIEnv *env, jobject jobj) {
+
+	struct bpf_program *fp = GetCompiledBpfProgram(env, jobj); // Exception already thrown
+
+	if (fp == NULL) {
+		return JNI_FALSE;
+	}
+
+	bpf_jit_filter_t *filter = bpf_jit_filter_new(fp, 1);
+
+	if (filter == NULL) {
+		ThrowNew(env, BPF_PROGRAM_CLOSE_EXCEPTION, "BpfProgram out of memory");
+		return JNI_FALSE;
+	}
+
+	bpf_jit_filter_free(GetBpfJitFilter(env, jobj));
+	(*env)->SetLongField(env, jobj, BpfProgramJitAddressFID, PointerToJlong(filter));
+	return filter->func != NULL ? JNI_TRUE : JNI_FALSE;
+  }
+
+/*
+ * Class:     com_ardikars_jxnet_BpfProgram
+ * Method:    matchesBuffer
+ * Signature: (Ljava/nio/ByteBuffer;III)I
+ */
+JNIEXPORT jint JNICALL Java_com_ardikars_jxnet_BpfProgram_matchesBuffer
+  (JNIEnv *env, jobject jobj, jobject jbuf, jint joffset, jint jcaplen, jint jwirelen) {
+
+	if (CheckNotNull(env, jbuf, NULL) == NULL) return -1;
+
+	struct bpf_program *fp = GetCompiledBpfProgram(env, jobj); // Exception already thrown
+
+	if (fp == NULL) {
+		return -1;
+	}
+
+	u_char *buf = (u_char *) (*env)->GetDirectBufferAddress(env, jbuf);
+
+	if (buf == NULL) {
+		ThrowNew(env, NULL_PTR_EXCEPTION, "Unable to retrive address from ByteBuffer");
+		return -1;
+	}
+
+	if (!CheckArgument(env, (joffset >= 0 && jcaplen >= 0
+			&& (jlong) joffset + jcaplen <= (*env)->GetDirectBufferCapacity(env, jbuf)), NULL)) return -1;
+
+	return (jint) bpf_program_run(fp, GetBpfJitFilter(env, jobj), buf + joffset, (u_int) jwirelen, (u_int) jcaplen);
+  }
+
+/*
+ * Class:     com_ardikars_jxnet_BpfProgram
+ * Method:    matchesArray
+ * Signature: ([BIII)I
+ */
+JNIEXPORT jint JNICALL Java_com_ardikars_jxnet_BpfProgram_matchesArray
+  (JNIEnv *env, jobject jobj, jbyteArray jdata, jint joffset, jint jcaplen, jint jwirelen) {
+
+	if (CheckNotNull(env, jdata, NULL) == NULL) return -1;
+
+	struct bpf_program *fp = GetCompiledBpfProgram(env, jobj); // Exception already thrown
+
+	if (fp == NULL) {
+		return -1;
+	}
+
+	if (!CheckArgument(env, (joffset >= 0 && jcaplen >= 0
+			&& (jlong) joffset + jcaplen <= (*env)->GetArrayLength(env, jdata)), NULL)) return -1;
+
+	bpf_jit_filter_t *filter = GetBpfJitFilter(env, jobj);
+	u_char *data = (u_char *) (*env)->GetPrimitiveArrayCritical(env, jdata, NULL);
+
+	if (data == NULL) {
+		return -1;
+	}
+
+	u_int ret = bpf_program_run(fp, filter, data + joffset, (u_int) jwirelen, (u_int) jcaplen);
+	(*env)->ReleasePrimitiveArrayCritical(env, jdata, data, JNI_ABORT);
+	return (jint) ret;
+  }
+
+/*
+ * Class:     com_ardikars_jxnet_BpfProgram
+ * Method:    matchesBatch
+ * Signature: (Ljava/nio/ByteBuffer;I[J)I
+ */
+JNIEXPORT jint JNICALL Java_com_ardikars_jxnet_BpfProgram_matchesBatch
+  (JNIEnv *env, jobject jobj, jobject jbuf, jint jcount, jlongArray jbitmap) {
+
+	if (CheckNotNull(env, jbuf, NULL) == NULL) return -1;
+	if (CheckNotNull(env, jbitmap, NULL) == NULL) return -1;
+	if (!CheckArgument(env, (jcount >= 0 && (jlong) (*env)->GetArrayLength(env, jbitmap) * 64 >= jcount),
+			"Bitmap is too small.")) return -1;
+
+	struct bpf_program *fp = GetCompiledBpfProgram(env, jobj); // Exception already thrown
+
+	if (fp == NULL) {
+		return -1;
+	}
+
+	u_char *buf = (u_char *) (*env)->GetDirectBufferAddress(env, jbuf);
+
+	if (buf == NULL) {
+		ThrowNew(env, NULL_PTR_EXCEPTION, "Unable to retrive address from ByteBuffer");
+		return -1;
+	}
+
+	size_t capacity = (size_t) (*env)->GetDirectBufferCapacity(env, jbuf);
+	bpf_jit_filter_t *filter = GetBpfJitFilter(env, jobj);
+	jlong *bitmap = (jlong *) (*env)->GetPrimitiveArrayCritical(env, jbitmap, NULL);
+
+	if (bitmap == NULL) {
+		return -1;
+	}
+
+	memset(bitmap, 0, sizeof(jlong) * (((size_t) jcount + 63) / 64));
+
+	size_t offset = 0;
+	jint matched = 0;
+	jint i;
+	for (i = 0; i < jcount; i++) {
+		if (offset + sizeof(pcap_batch_pkthdr_t) > capacity) {
+			break;
+		}
+		const pcap_batch_pkthdr_t *hdr = (const pcap_batch_pkthdr_t *) (buf + offset);
+		offset += sizeof(pcap_batch_pkthdr_t);
+		if (hdr->caplen > capacity - offset) {
+			break;
+		}
+		if (bpf_program_run(fp, filter, buf + offset, hdr->len, hdr->caplen) != 0) {
+			bitmap[i >> 6] |= (jlong) (((uint64_t) 1) << (i & 63));
+			matched++;
+		}
+		offset += hdr->caplen;
+	}
+
+	(*env)->ReleasePrimitiveArrayCritical(env, jbitmap, bitmap, 0);
+
+	if (i < jcount) {
+		ThrowNew(env, ILLEGAL_ARGUMENT_EXCEPTION, "Packet record is out of buffer bounds.");
+		return -1;
+	}
+	return matched;
+  }
@@ -0,0 +1,447 @@
+/**
+ * Copyright (C) 2017  Ardika Rommy Sanjaya
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <pcap.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "bpf_jit.h"
+
+#if defined(__x86_64__) && !defined(WIN32) && !defined(_WIN32)
+#define BPF_JIT_X86_64
+#include <sys/mman.h>
+#endif
+
+#ifdef BPF_JIT_X86_64
+
+/*
+ * Classic BPF to x86-64 (System V) translator.
+ *
+ * Register usage:
+ *   eax  A            ecx  X
+ *   rdi  packet       r8d  buflen (caplen)    r9d  wirelen
+ *   esi, edx          scratch (load offset, division)
+ *   [rsp - 64]        M[0..15], in the red zone (generated code is a leaf function)
+ *
+ * Every jump is emitted in its rel32 form, so instruction sizes do not depend on jump
+ * distances: the first pass records instruction offsets, the second pass emits the code.
+ * Loads outside the captured data and division by zero return 0, as the interpreter does.
+ */
+
+#define CC_B	0x2
+#define CC_AE	0x3
+#define CC_E	0x4
+#define CC_NE	0x5
+#define CC_BE	0x6
+#define CC_A	0x7
+
+#define MEM_DISP(k) ((u_char) (-64 + 4 * (int) (k)))
+
+typedef struct bpf_jit_ctx {
+	u_char *buf;
+	size_t len;
+	size_t *addrs;
+	size_t ret0;
+} bpf_jit_ctx_t;
+
+static void emit(bpf_jit_ctx_t *ctx, const u_char *bytes, size_t n) {
+	if (ctx->buf != NULL) {
+		memcpy(ctx->buf + ctx->len, bytes, n);
+	}
+	ctx->len += n;
+}
+
+#define EMIT(ctx, ...) do { \
+		const u_char __code[] = { __VA_ARGS__ }; \
+		emit(ctx, __code, sizeof(__code)); \
+	} while (0)
+
+static void emit_u32(bpf_jit_ctx_t *ctx, uint32_t v) {
+	EMIT(ctx, (u_char) v, (u_char) (v >> 8), (u_char) (v >> 16), (u_char) (v >> 24));
+}
+
+static void emit_rel32(bpf_jit_ctx_t *ctx, size_t target) {
+	emit_u32(ctx, (uint32_t) (int32_t) ((int64_t) target - (int64_t) (ctx->len + 4)));
+}
+
+static void emit_jmp(bpf_jit_ctx_t *ctx, size_t target) {
+	EMIT(ctx, 0xe9);
+	emit_rel32(ctx, target);
+}
+
+static void emit_jcc(bpf_jit_ctx_t *ctx, u_char cc, size_t target) {
+	EMIT(ctx, 0x0f, (u_char) (0x80 | cc));
+	emit_rel32(ctx, target);
+}
+
+/* A = P[k:size] or P[X+k:size], big endian */
+static void emit_load(bpf_jit_ctx_t *ctx, u_char size, int indirect, uint32_t k) {
+	EMIT(ctx, 0xbe);				/* mov esi, k */
+	emit_u32(ctx, k);
+	if (indirect) {
+		EMIT(ctx, 0x01, 0xce);			/* add esi, ecx */
+		emit_jcc(ctx, CC_B, ctx->ret0);		/* jc ret0 */
+	}
+	EMIT(ctx, 0x48, 0x8d, 0x56, size);		/* lea rdx, [rsi + size] */
+	EMIT(ctx, 0x4c, 0x39, 0xc2);			/* cmp rdx, r8 */
+	emit_jcc(ctx, CC_A, ctx->ret0);			/* ja ret0 */
+	switch (size) {
+	case 4:
+		EMIT(ctx, 0x8b, 0x04, 0x37);		/* mov eax, [rdi + rsi] */
+		EMIT(ctx, 0x0f, 0xc8);			/* bswap eax */
+		break;
+	case 2:
+		EMIT(ctx, 0x0f, 0xb7, 0x04, 0x37);	/* movzx eax, word [rdi + rsi] */
+		EMIT(ctx, 0x66, 0xc1, 0xc0, 0x08);	/* rol ax, 8 */
+		break;
+	default:
+		EMIT(ctx, 0x0f, 0xb6, 0x04, 0x37);	/* movzx eax, byte [rdi + rsi] */
+		break;
+	}
+}
+
+static void emit_div(bpf_jit_ctx_t *ctx, int by_x, uint32_t k, int mod) {
+	if (by_x) {
+		EMIT(ctx, 0x85, 0xc9);			/* test ecx, ecx */
+		emit_jcc(ctx, CC_E, ctx->ret0);		/* jz ret0 */
+		EMIT(ctx, 0x31, 0xd2);			/* xor edx, edx */
+		EMIT(ctx, 0xf7, 0xf1);			/* div ecx */
+	} else {
+		if (k == 0) {
+			emit_jmp(ctx, ctx->ret0);
+			return;
+		}
+		EMIT(ctx, 0xbe);			/* mov esi, k */
+		emit_u32(ctx, k);
+		EMIT(ctx, 0x31, 0xd2);			/* xor edx, edx */
+		EMIT(ctx, 0xf7, 0xf6);			/* div esi */
+	}
+	if (mod) {
+		EMIT(ctx, 0x89, 0xd0);			/* mov eax, edx */
+	}
+}
+
+/* conditional jump to jt/jf after the flags have been set */
+static void emit_branch(bpf_jit_ctx_t *ctx, u_int pc, const struct bpf_insn *insn, u_char cc_true, u_char cc_false) {
+	size_t target_true = ctx->addrs[pc + 1 + insn->jt];
+	size_t target_false = ctx->addrs[pc + 1 + insn->jf];
+	if (insn->jt != 0 && insn->jf != 0) {
+		emit_jcc(ctx, cc_true, target_true);
+		emit_jmp(ctx, target_false);
+	} else if (insn->jt != 0) {
+		emit_jcc(ctx, cc_true, target_true);
+	} else if (insn->jf != 0) {
+		emit_jcc(ctx, cc_false, target_false);
+	}
+}
+
+/* returns 0 on success, -1 if an instruction is not supported */
+static int bpf_jit_emit(bpf_jit_ctx_t *ctx, const struct bpf_insn *insns, u_int len) {
+	u_int pc;
+
+	ctx->len = 0;
+	EMIT(ctx, 0x41, 0x89, 0xd0);			/* mov r8d, edx */
+	EMIT(ctx, 0x41, 0x89, 0xf1);			/* mov r9d, esi */
+	EMIT(ctx, 0x31, 0xc0);				/* xor eax, eax */
+	EMIT(ctx, 0x31, 0xc9);				/* xor ecx, ecx */
+
+	for (pc = 0; pc < len; pc++) {
+		const struct bpf_insn *insn = &insns[pc];
+		uint32_t k = insn->k;
+		ctx->addrs[pc] = ctx->len;
+
+		switch (insn->code) {
+		case BPF_RET|BPF_K:
+			EMIT(ctx, 0xb8);			/* mov eax, k */
+			emit_u32(ctx, k);
+			EMIT(ctx, 0xc3);			/* ret */
+			break;
+		case BPF_RET|BPF_A:
+			EMIT(ctx, 0xc3);			/* ret */
+			break;
+
+		case BPF_LD|BPF_W|BPF_ABS:
+			emit_load(ctx, 4, 0, k);
+			break;
+		case BPF_LD|BPF_H|BPF_ABS:
+			emit_load(ctx, 2, 0, k);
+			break;
+		case BPF_LD|BPF_B|BPF_ABS:
+			emit_load(ctx, 1, 0, k);
+			break;
+		case BPF_LD|BPF_W|BPF_IND:
+			emit_load(ctx, 4, 1, k);
+			break;
+		case BPF_LD|BPF_H|BPF_IND:
+			emit_load(ctx, 2, 1, k);
+			break;
+		case BPF_LD|BPF_B|BPF_IND:
+			emit_load(ctx, 1, 1, k);
+			break;
+		case BPF_LD|BPF_W|BPF_LEN:
+			EMIT(ctx, 0x44, 0x89, 0xc8);		/* mov eax, r9d */
+			break;
+		case BPF_LDX|BPF_W|BPF_LEN:
+			EMIT(ctx, 0x44, 0x89, 0xc9);		/* mov ecx, r9d */
+			break;
+		case BPF_LDX|BPF_MSH|BPF_B:
+			EMIT(ctx, 0xbe);			/* mov esi, k */
+			emit_u32(ctx, k);
+			EMIT(ctx, 0x48, 0x8d, 0x56, 0x01);	/* lea rdx, [rsi + 1] */
+			EMIT(ctx, 0x4c, 0x39, 0xc2);		/* cmp rdx, r8 */
+			emit_jcc(ctx, CC_A, ctx->ret0);		/* ja ret0 */
+			EMIT(ctx, 0x0f, 0xb6, 0x0c, 0x37);	/* movzx ecx, byte [rdi + rsi] */
+			EMIT(ctx, 0x83, 0xe1, 0x0f);		/* and ecx, 0xf */
+			EMIT(ctx, 0xc1, 0xe1, 0x02);		/* shl ecx, 2 */
+			break;
+		case BPF_LD|BPF_IMM:
+			EMIT(ctx, 0xb8);			/* mov eax, k */
+			emit_u32(ctx, k);
+			break;
+		case BPF_LDX|BPF_IMM:
+			EMIT(ctx, 0xb9);			/* mov ecx, k */
+			emit_u32(ctx, k);
+			break;
+		case BPF_LD|BPF_MEM:
+			EMIT(ctx, 0x8b, 0x44, 0x24, MEM_DISP(k));	/* mov eax, M[k] */
+			break;
+		case BPF_LDX|BPF_MEM:
+			EMIT(ctx, 0x8b, 0x4c, 0x24, MEM_DISP(k));	/* mov ecx, M[k] */
+			break;
+		case BPF_ST:
+			EMIT(ctx, 0x89, 0x44, 0x24, MEM_DISP(k));	/* mov M[k], eax */
+			break;
+		case BPF_STX:
+			EMIT(ctx, 0x89, 0x4c, 0x24, MEM_DISP(k));	/* mov M[k], ecx */
+			break;
+
+		case BPF_JMP|BPF_JA:
+			emit_jmp(ctx, ctx->addrs[pc + 1 + k]);
+			break;
+		case BPF_JMP|BPF_JGT|BPF_K:
+		case BPF_JMP|BPF_JGE|BPF_K:
+		case BPF_JMP|BPF_JEQ|BPF_K:
+			EMIT(ctx, 0x3d);			/* cmp eax, k */
+			emit_u32(ctx, k);
+			break;
+		case BPF_JMP|BPF_JSET|BPF_K:
+			EMIT(ctx, 0xa9);			/* test eax, k */
+			emit_u32(ctx, k);
+			break;
+		case BPF_JMP|BPF_JGT|BPF_X:
+		case BPF_JMP|BPF_JGE|BPF_X:
+		case BPF_JMP|BPF_JEQ|BPF_X:
+			EMIT(ctx, 0x39, 0xc8);			/* cmp eax, ecx */
+			break;
+		case BPF_JMP|BPF_JSET|BPF_X:
+			EMIT(ctx, 0x85, 0xc8);			/* test eax, ecx */
+			break;
+
+		case BPF_ALU|BPF_ADD|BPF_X:
+			EMIT(ctx, 0x01, 0xc8);			/* add eax, ecx */
+			break;
+		case BPF_ALU|BPF_SUB|BPF_X:
+			EMIT(ctx, 0x29, 0xc8);			/* sub eax, ecx */
+			break;
+		case BPF_ALU|BPF_MUL|BPF_X:
+			EMIT(ctx, 0x0f, 0xaf, 0xc1);		/* imul eax, ecx */
+			break;
+		case BPF_ALU|BPF_DIV|BPF_X:
+			emit_div(ctx, 1, 0, 0);
+			break;
+		case BPF_ALU|BPF_MOD|BPF_X:
+			emit_div(ctx, 1, 0, 1);
+			break;
+		case BPF_ALU|BPF_AND|BPF_X:
+			EMIT(ctx, 0x21, 0xc8);			/* and eax, ecx */
+			break;
+		case BPF_ALU|BPF_OR|BPF_X:
+			EMIT(ctx, 0x09, 0xc8);			/* or eax, ecx */
+			break;
+		case BPF_ALU|BPF_XOR|BPF_X:
+			EMIT(ctx, 0x31, 0xc8);			/* xor eax, ecx */
+			break;
+		case BPF_ALU|BPF_LSH|BPF_X:
+			EMIT(ctx, 0xd3, 0xe0);			/* shl eax, cl */
+			break;
+		case BPF_ALU|BPF_RSH|BPF_X:
+			EMIT(ctx, 0xd3, 0xe8);			/* shr eax, cl */
+			break;
+		case BPF_ALU|BPF_ADD|BPF_K:
+			EMIT(ctx, 0x05);			/* add eax, k */
+			emit_u32(ctx, k);
+			break;
+		case BPF_ALU|BPF_SUB|BPF_K:
+			EMIT(ctx, 0x2d);			/* sub eax, k */
+			emit_u32(ctx, k);
+			break;
+		case BPF_ALU|BPF_MUL|BPF_K:
+			EMIT(ctx, 0x69, 0xc0);			/* imul eax, eax, k */
+			emit_u32(ctx, k);
+			break;
+		case BPF_ALU|BPF_DIV|BPF_K:
+			emit_div(ctx, 0, k, 0);
+			break;
+		case BPF_ALU|BPF_MOD|BPF_K:
+			emit_div(ctx, 0, k, 1);
+			break;
+		case BPF_ALU|BPF_AND|BPF_K:
+			EMIT(ctx, 0x25);			/* and eax, k */
+			emit_u32(ctx, k);
+			break;
+		case BPF_ALU|BPF_OR|BPF_K:
+			EMIT(ctx, 0x0d);			/* or eax, k */
+			emit_u32(ctx, k);
+			break;
+		case BPF_ALU|BPF_XOR|BPF_K:
+			EMIT(ctx, 0x35);			/* xor eax, k */
+			emit_u32(ctx, k);
+			break;
+		case BPF_ALU|BPF_LSH|BPF_K:
+			EMIT(ctx, 0xc1, 0xe0, (u_char) k);	/* shl eax, k */
+			break;
+		case BPF_ALU|BPF_RSH|BPF_K:
+			EMIT(ctx, 0xc1, 0xe8, (u_char) k);	/* shr eax, k */
+			break;
+		case BPF_ALU|BPF_NEG:
+			EMIT(ctx, 0xf7, 0xd8);			/* neg eax */
+			break;
+
+		case BPF_MISC|BPF_TAX:
+			EMIT(ctx, 0x89, 0xc1);			/* mov ecx, eax */
+			break;
+		case BPF_MISC|BPF_TXA:
+			EMIT(ctx, 0x89, 0xc8);			/* mov eax, ecx */
+			break;
+
+		default:
+			return -1;
+		}
+
+		switch (insn->code) {
+		case BPF_JMP|BPF_JGT|BPF_K:
+		case BPF_JMP|BPF_JGT|BPF_X:
+			emit_branch(ctx, pc, insn, CC_A, CC_BE);
+			break;
+		case BPF_JMP|BPF_JGE|BPF_K:
+		case BPF_JMP|BPF_JGE|BPF_X:
+			emit_branch(ctx, pc, insn, CC_AE, CC_B);
+			break;
+		case BPF_JMP|BPF_JEQ|BPF_K:
+		case BPF_JMP|BPF_JEQ|BPF_X:
+			emit_branch(ctx, pc, insn, CC_E, CC_NE);
+			break;
+		case BPF_JMP|BPF_JSET|BPF_K:
+		case BPF_JMP|BPF_JSET|BPF_X:
+			emit_branch(ctx, pc, insn, CC_NE, CC_E);
+			break;
+		}
+	}
+
+	ctx->addrs[len] = ctx->len;
+	ctx->ret0 = ctx->len;
+	EMIT(ctx, 0x31, 0xc0);				/* ret0: xor eax, eax */
+	EMIT(ctx, 0xc3);				/* ret */
+	return 0;
+}
+
+static int bpf_jit_compile(bpf_jit_filter_t *filter) {
+	bpf_jit_ctx_t ctx;
+	memset(&ctx, 0, sizeof(ctx));
+	ctx.addrs = (size_t *) calloc(filter->len + 1, sizeof(size_t));
+	if (ctx.addrs == NULL) {
+		return -1;
+	}
+
+	/* first pass: sizes and offsets only */
+	if (bpf_jit_emit(&ctx, filter->insns, filter->len) != 0) {
+		free(ctx.addrs);
+		return -1;
+	}
+
+	size_t size = ctx.len;
+	void *code = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if (code == MAP_FAILED) {
+		free(ctx.addrs);
+		return -1;
+	}
+
+	/* second pass: emit with the final offsets */
+	ctx.buf = (u_char *) code;
+	if (bpf_jit_emit(&ctx, filter->insns, filter->len) != 0 || ctx.len != size
+			|| mprotect(code, size, PROT_READ | PROT_EXEC) != 0) {
+		munmap(code, size);
+		free(ctx.addrs);
+		return -1;
+	}
+
+	free(ctx.addrs);
+	filter->func = (bpf_jit_func_t) (uintptr_t) code;
+	filter->size = size;
+	return 0;
+}
+
+#endif
+
+bpf_jit_filter_t *bpf_jit_filter_new(const struct bpf_program *fp, int jit) {
+	if (fp == NULL || fp->bf_insns == NULL || fp->bf_len == 0) {
+		return NULL;
+	}
+
+	bpf_jit_filter_t *filter = (bpf_jit_filter_t *) calloc(1, sizeof(bpf_jit_filter_t));
+	if (filter == NULL) {
+		return NULL;
+	}
+
+	filter->len = fp->bf_len;
+	filter->refs = 1;
+	filter->insns = (struct bpf_insn *) malloc(sizeof(struct bpf_insn) * fp->bf_len);
+	if (filter->insns == NULL) {
+		free(filter);
+		return NULL;
+	}
+	memcpy(filter->insns, fp->bf_insns, sizeof(struct bpf_insn) * fp->bf_len);
+
+#ifdef BPF_JIT_X86_64
+	/* bpf_validate() guarantees in-range jumps and a terminating return */
+	if (jit && bpf_validate(filter->insns, (int) filter->len)) {
+		bpf_jit_compile(filter);
+	}
+#endif
+	return filter;
+}
+
+bpf_jit_filter_t *bpf_jit_filter_ref(bpf_jit_filter_t *filter) {
+	if (filter != NULL) {
+		__sync_add_and_fetch(&filter->refs, 1);
+	}
+	return filter;
+}
+
+void bpf_jit_filter_free(bpf_jit_filter_t *filter) {
+	if (filter == NULL || __sync_sub_and_fetch(&filter->refs, 1) > 0) {
+		return;
+	}
+#ifdef BPF_JIT_X86_64
+	if (filter->func != NULL) {
+		munmap((void *) (uintptr_t) filter->func, filter->size);
+	}
+#endif
+	free(filter->insns);
+	free(filter);
+}
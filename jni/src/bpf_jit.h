@@ -0,0 +1,57 @@
+/**
+ * Copyright (C) 2017  Ardika Rommy Sanjaya
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _JXNET_BPF_JIT_H
+#define _JXNET_BPF_JIT_H
+
+#include <pcap.h>
+#include <stddef.h>
+
+typedef u_int (*bpf_jit_func_t)(const u_char *p, u_int wirelen, u_int buflen);
+
+/*
+ * Private copy of a compiled filter. func is native code generated from insns,
+ * or NULL if the program could not be translated (or JIT is not available on this
+ * platform), in which case insns are run by the libpcap interpreter.
+ * A filter is reference counted, so a running loop or capture thread keeps it alive
+ * while the filter of its Pcap is replaced or closed.
+ */
+typedef struct bpf_jit_filter {
+	bpf_jit_func_t func;
+	size_t size;
+	struct bpf_insn *insns;
+	u_int len;
+	int refs;
+} bpf_jit_filter_t;
+
+/* New filter holding one reference */
+bpf_jit_filter_t *bpf_jit_filter_new(const struct bpf_program *fp, int jit);
+
+/* Take one more reference, filter may be NULL */
+bpf_jit_filter_t *bpf_jit_filter_ref(bpf_jit_filter_t *filter);
+
+/* Drop a reference, the filter is freed with the last one */
+void bpf_jit_filter_free(bpf_jit_filter_t *filter);
+
+static inline u_int bpf_jit_filter_run(const bpf_jit_filter_t *filter, const u_char *p, u_int wirelen, u_int buflen) {
+	if (filter->func != NULL) {
+		return filter->func(p, wirelen, buflen);
+	}
+	return bpf_filter(filter->insns, p, wirelen, buflen);
+}
+
+#endif
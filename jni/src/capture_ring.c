@@ -0,0 +1,306 @@
+/**
+ * Copyright (C) 2017  Ardika Rommy Sanjaya
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <jni.h>
+#include <pcap.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../include/jxnet/com_ardikars_jxnet_PcapCaptureRing.h"
+#include "ids.h"
+#include "utils.h"
+#include "preconditions.h"
+
+#if !defined(WIN32)
+#include <pthread.h>
+
+/*
+ * Memory shared with Java. Producer and consumer indices live on their own cache lines;
+ * records start at CAPTURE_RING_DATA and are 16 byte aligned pcap_batch_pkthdr_t + data.
+ * Offsets must match PcapCaptureRing.java.
+ */
+#define CAPTURE_RING_HEAD 0
+#define CAPTURE_RING_TAIL 64
+#define CAPTURE_RING_STATUS 128
+#define CAPTURE_RING_DROPPED 136
+#define CAPTURE_RING_DATA 192
+
+#define CAPTURE_RING_RUNNING 0
+#define CAPTURE_RING_STOPPED 1
+#define CAPTURE_RING_ERROR -1
+
+/* caplen of a record that only pads to the end of the ring */
+#define CAPTURE_RING_WRAP 0xffffffff
+
+#define CAPTURE_RING_ALIGN(x) (((x) + 15) & ~((size_t) 15))
+
+typedef struct capture_ring {
+	pcap_t *pcap;
+	bpf_jit_filter_t *filter;
+	u_char *shared;
+	u_char *data;
+	size_t capacity;
+	uint64_t head;
+	uint64_t dropped;
+	volatile int running;
+	int started;
+	pthread_t thread;
+} capture_ring_t;
+
+#define CAPTURE_RING_U64(ring, offset) ((uint64_t *) ((ring)->shared + (offset)))
+#define CAPTURE_RING_I64(ring, offset) ((int64_t *) ((ring)->shared + (offset)))
+
+static void capture_ring_callback(u_char *user, const struct pcap_pkthdr *pkt_header, const u_char *pkt_data) {
+	capture_ring_t *ring = (capture_ring_t *) user;
+	if (ring->filter != NULL
+			&& bpf_jit_filter_run(ring->filter, pkt_data, pkt_header->len, pkt_header->caplen) == 0) {
+		return;
+	}
+	size_t need = CAPTURE_RING_ALIGN(sizeof(pcap_batch_pkthdr_t) + pkt_header->caplen);
+	uint64_t tail = __atomic_load_n(CAPTURE_RING_U64(ring, CAPTURE_RING_TAIL), __ATOMIC_ACQUIRE);
+	uint64_t head = ring->head;
+	size_t pos = (size_t) (head & (ring->capacity - 1));
+	size_t contiguous = ring->capacity - pos;
+	size_t skip = (need > contiguous) ? contiguous : 0;
+
+	if (need > ring->capacity || head + skip + need - tail > ring->capacity) {
+		ring->dropped++;
+		__atomic_store_n(CAPTURE_RING_U64(ring, CAPTURE_RING_DROPPED), ring->dropped, __ATOMIC_RELAXED);
+		return;
+	}
+
+	if (skip > 0) {
+		pcap_batch_pkthdr_t *wrap = (pcap_batch_pkthdr_t *) (ring->data + pos);
+		wrap->caplen = CAPTURE_RING_WRAP;
+		pos = 0;
+	}
+
+	pcap_batch_pkthdr_t *hdr = (pcap_batch_pkthdr_t *) (ring->data + pos);
+	hdr->tv_sec = (bpf_u_int32) pkt_header->ts.tv_sec;
+	hdr->tv_usec = (bpf_u_int32) pkt_header->ts.tv_usec;
+	hdr->caplen = pkt_header->caplen;
+	hdr->len = pkt_header->len;
+	memcpy(ring->data + pos + sizeof(pcap_batch_pkthdr_t), pkt_data, pkt_header->caplen);
+
+	ring->head = head + skip + need;
+	__atomic_store_n(CAPTURE_RING_U64(ring, CAPTURE_RING_HEAD), ring->head, __ATOMIC_RELEASE);
+}
+
+static void *capture_ring_run(void *arg) {
+	capture_ring_t *ring = (capture_ring_t *) arg;
+	int64_t status = CAPTURE_RING_STOPPED;
+	while (ring->running) {
+		int r = pcap_dispatch(ring->pcap, -1, capture_ring_callback, (u_char *) ring);
+		if (r == -1) {
+			status = CAPTURE_RING_ERROR;
+			break;
+		}
+		if (r == -2 || (r == 0 && pcap_file(ring->pcap) != NULL)) {
+			break;
+		}
+	}
+	__atomic_store_n(CAPTURE_RING_I64(ring, CAPTURE_RING_STATUS), status, __ATOMIC_RELEASE);
+	return NULL;
+}
+
+static capture_ring_t *GetCaptureRing(JNIEnv *env, jlong address) {
+	capture_ring_t *ring = (capture_ring_t *) JlongToPointer(address);
+	if (ring == NULL) {
+		ThrowNew(env, ILLEGAL_STATE_EXCEPTION, "PcapCaptureRing is closed.");
+	}
+	return ring;
+}
+
+static void capture_ring_stop(capture_ring_t *ring) {
+	if (ring->started) {
+		ring->running = 0;
+		pcap_breakloop(ring->pcap);
+		pthread_join(ring->thread, NULL);
+		ring->started = 0;
+	}
+}
+#endif
+
+/*
+ * Class:     com_ardikars_jxnet_PcapCaptureRing
+ * Method:    startRing
+ * Signature: (Lcom/ardikars/jxnet/Pcap;I)J
+ */
+JNIEXPORT jlong JNICALL Java_com_ardikars_jxnet_PcapCaptureRing_startRing
+  (JNIEnv *env, jclass jcls, jobject jpcap, jint jcapacity) {
+
+#if defined(WIN32)
+	ThrowNew(env, NOT_SUPPORTED_PLATFORM_EXCEPTION, NULL);
+	return 0;
+#else
+
+	if (CheckNotNull(env, jpcap, NULL) == NULL) return 0;
+	if (!CheckArgument(env, (jcapacity >= 4096 && (jcapacity & (jcapacity - 1)) == 0),
+			"Capacity must be a power of two, at least 4096.")) return 0;
+
+	pcap_t *pcap = GetPcap(env, jpcap); // Exception already thrown
+
+	if (pcap == NULL) {
+		return 0;
+	}
+
+	capture_ring_t *ring = (capture_ring_t *) calloc(1, sizeof(capture_ring_t));
+	void *shared = NULL;
+
+	if (ring == NULL || posix_memalign(&shared, 64, CAPTURE_RING_DATA + (size_t) jcapacity) != 0) {
+		free(ring);
+		ThrowNew(env, JXNET_EXCEPTION, "PcapCaptureRing out of memory");
+		return 0;
+	}
+
+	memset(shared, 0, CAPTURE_RING_DATA);
+	ring->pcap = pcap;
+	ring->filter = AcquirePcapFilter(env, jpcap);
+	ring->shared = (u_char *) shared;
+	ring->data = ring->shared + CAPTURE_RING_DATA;
+	ring->capacity = (size_t) jcapacity;
+	ring->running = 1;
+
+	if (pthread_create(&ring->thread, NULL, capture_ring_run, ring) != 0) {
+		bpf_jit_filter_free(ring->filter);
+		free(shared);
+		free(ring);
+		ThrowNew(env, JXNET_EXCEPTION, "Unable to start capture thread");
+		return 0;
+	}
+	ring->started = 1;
+
+	return PointerToJlong(ring);
+#endif
+  }
+
+/*
+ * Class:     com_ardikars_jxnet_PcapCaptureRing
+ * Method:    mapRing
+ * Signature: (J)Ljava/nio/ByteBuffer;
+ */
+JNIEXPORT jobject JNICALL Java_com_ardikars_jxnet_PcapCaptureRing_mapRing
+  (JNIEnv *env, jclass jcls, jlong jaddress) {
+
+#if defined(WIN32)
+	ThrowNew(env, NOT_SUPPORTED_PLATFORM_EXCEPTION, NULL);
+	return NULL;
+#else
+	capture_ring_t *ring = GetCaptureRing(env, jaddress); // Exception already thrown
+
+	if (ring == NULL) {
+		return NULL;
+	}
+	return (*env)->NewDirectByteBuffer(env, ring->shared, (jlong) (CAPTURE_RING_DATA + ring->capacity));
+#endif
+  }
+
+/*
+ * Class:     com_ardikars_jxnet_PcapCaptureRing
+ * Method:    sharedAddress
+ * Signature: (J)J
+ */
+JNIEXPORT jlong JNICALL Java_com_ardikars_jxnet_PcapCaptureRing_sharedAddress
+  (JNIEnv *env, jclass jcls, jlong jaddress) {
+
+#if defined(WIN32)
+	ThrowNew(env, NOT_SUPPORTED_PLATFORM_EXCEPTION, NULL);
+	return 0;
+#else
+	capture_ring_t *ring = GetCaptureRing(env, jaddress); // Exception already thrown
+
+	if (ring == NULL) {
+		return 0;
+	}
+	return PointerToJlong(ring->shared);
+#endif
+  }
+
+/*
+ * Class:     com_ardikars_jxnet_PcapCaptureRing
+ * Method:    loadVolatile
+ * Signature: (J)J
+ */
+JNIEXPORT jlong JNICALL Java_com_ardikars_jxnet_PcapCaptureRing_loadVolatile
+  (JNIEnv *env, jclass jcls, jlong jaddress) {
+
+#if defined(WIN32)
+	ThrowNew(env, NOT_SUPPORTED_PLATFORM_EXCEPTION, NULL);
+	return 0;
+#else
+	return (jlong) __atomic_load_n((uint64_t *) JlongToPointer(jaddress), __ATOMIC_ACQUIRE);
+#endif
+  }
+
+/*
+ * Class:     com_ardikars_jxnet_PcapCaptureRing
+ * Method:    storeOrdered
+ * Signature: (JJ)V
+ */
+JNIEXPORT void JNICALL Java_com_ardikars_jxnet_PcapCaptureRing_storeOrdered
+  (JNIEnv *env, jclass jcls, jlong jaddress, jlong jvalue) {
+
+#if defined(WIN32)
+	ThrowNew(env, NOT_SUPPORTED_PLATFORM_EXCEPTION, NULL);
+#else
+	__atomic_store_n((uint64_t *) JlongToPointer(jaddress), (uint64_t) jvalue, __ATOMIC_RELEASE);
+#endif
+  }
+
+/*
+ * Class:     com_ardikars_jxnet_PcapCaptureRing
+ * Method:    stopRing
+ * Signature: (J)V
+ */
+JNIEXPORT void JNICALL Java_com_ardikars_jxnet_PcapCaptureRing_stopRing
+  (JNIEnv *env, jclass jcls, jlong jaddress) {
+
+#if defined(WIN32)
+	ThrowNew(env, NOT_SUPPORTED_PLATFORM_EXCEPTION, NULL);
+#else
+	capture_ring_t *ring = GetCaptureRing(env, jaddress); // Exception already thrown
+
+	if (ring == NULL) {
+		return;
+	}
+	capture_ring_stop(ring);
+#endif
+  }
+
+/*
+ * Class:     com_ardikars_jxnet_PcapCaptureRing
+ * Method:    closeRing
+ * Signature: (J)V
+ */
+JNIEXPORT void JNICALL Java_com_ardikars_jxnet_PcapCaptureRing_closeRing
+  (JNIEnv *env, jclass jcls, jlong jaddress) {
+
+#if defined(WIN32)
+	ThrowNew(env, NOT_SUPPORTED_PLATFORM_EXCEPTION, NULL);
+#else
+	capture_ring_t *ring = GetCaptureRing(env, jaddress); // Exception already thrown
+
+	if (ring == NULL) {
+		return;
+	}
+	capture_ring_stop(ring);
+	bpf_jit_filter_free(ring->filter);
+	free(ring->shared);
+	free(ring);
+#endif
+  }
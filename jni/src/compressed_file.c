@@ -0,0 +1,579 @@
+/**
+ * Copyright (C) 2017  Ardika Rommy Sanjaya
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE
+#endif
+
+#include <pcap.h>
+#include <errno.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "compressed_file.h"
+
+#if !defined(WIN32)
+#include <fcntl.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/types.h>
+
+#ifdef HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+#ifdef HAVE_ZSTD
+#include <zstd.h>
+#endif
+
+#define COMPRESSED_FILE_CHUNK (1 << 20)
+#define COMPRESSED_FILE_CHUNKS 4
+
+/*
+ * Common head of the reader and writer cookies. position counts uncompressed bytes,
+ * so ftell() (and pcap_dump_ftell()) report offsets in the uncompressed savefile.
+ */
+typedef struct compressed_file {
+	uint64_t position;
+	ssize_t (*read)(struct compressed_file *, char *, size_t);
+	ssize_t (*write)(struct compressed_file *, const char *, size_t);
+	int (*close)(struct compressed_file *);
+} compressed_file_t;
+
+static ssize_t compressed_file_read(void *cookie, char *buf, size_t size) {
+	compressed_file_t *file = (compressed_file_t *) cookie;
+	ssize_t n = file->read(file, buf, size);
+	if (n > 0) {
+		file->position += (uint64_t) n;
+	}
+	return n;
+}
+
+static ssize_t compressed_file_write(void *cookie, const char *buf, size_t size) {
+	compressed_file_t *file = (compressed_file_t *) cookie;
+	ssize_t n = file->write(file, buf, size);
+	if (n > 0) {
+		file->position += (uint64_t) n;
+	}
+	return n;
+}
+
+static int compressed_file_close(void *cookie) {
+	compressed_file_t *file = (compressed_file_t *) cookie;
+	return file->close(file);
+}
+
+#if defined(__GLIBC__)
+static int compressed_file_seek(void *cookie, off64_t *offset, int whence) {
+	if (whence != SEEK_CUR || *offset != 0) {
+		errno = ESPIPE;
+		return -1;
+	}
+	*offset = (off64_t) ((compressed_file_t *) cookie)->position;
+	return 0;
+}
+#else
+static int compressed_file_funread(void *cookie, char *buf, int size) {
+	return (int) compressed_file_read(cookie, buf, (size_t) size);
+}
+
+static int compressed_file_funwrite(void *cookie, const char *buf, int size) {
+	return (int) compressed_file_write(cookie, buf, (size_t) size);
+}
+
+static fpos_t compressed_file_seek(void *cookie, fpos_t offset, int whence) {
+	if (whence != SEEK_CUR || offset != 0) {
+		errno = ESPIPE;
+		return (fpos_t) -1;
+	}
+	return (fpos_t) ((compressed_file_t *) cookie)->position;
+}
+#endif
+
+/* wrap a cookie into a stdio stream: fopencookie() on glibc, funopen() elsewhere */
+static FILE *compressed_file_stream(compressed_file_t *file, int writing) {
+#if defined(__GLIBC__)
+	cookie_io_functions_t io;
+	io.read = writing ? NULL : compressed_file_read;
+	io.write = writing ? compressed_file_write : NULL;
+	io.seek = compressed_file_seek;
+	io.close = compressed_file_close;
+	return fopencookie(file, writing ? "wb" : "rb", io);
+#else
+	return funopen(file, writing ? NULL : compressed_file_funread, writing ? compressed_file_funwrite : NULL,
+			compressed_file_seek, compressed_file_close);
+#endif
+}
+
+static ssize_t compressed_file_read_fd(int fd, u_char *buf, size_t size) {
+	ssize_t n;
+	do {
+		n = read(fd, buf, size);
+	} while (n < 0 && errno == EINTR);
+	return n;
+}
+
+static int compressed_file_write_fd(int fd, const u_char *buf, size_t size) {
+	while (size > 0) {
+		ssize_t n = write(fd, buf, size);
+		if (n < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+			return -1;
+		}
+		buf += n;
+		size -= (size_t) n;
+	}
+	return 0;
+}
+
+typedef struct compressed_reader {
+	compressed_file_t base;
+	int fd;
+	int codec;
+	int eof;
+	u_char *in;
+	size_t in_len;
+	size_t in_pos;
+#ifdef HAVE_ZLIB
+	z_stream zs;
+#endif
+#ifdef HAVE_ZSTD
+	ZSTD_DStream *zds;
+#endif
+} compressed_reader_t;
+
+/* 1 if input is available, 0 at end of file, -1 on error */
+static int compressed_reader_fill(compressed_reader_t *reader) {
+	if (reader->in_pos < reader->in_len) {
+		return 1;
+	}
+	if (reader->eof) {
+		return 0;
+	}
+	ssize_t n = compressed_file_read_fd(reader->fd, reader->in, COMPRESSED_FILE_CHUNK);
+	if (n < 0) {
+		return -1;
+	}
+	if (n == 0) {
+		reader->eof = 1;
+		return 0;
+	}
+	reader->in_len = (size_t) n;
+	reader->in_pos = 0;
+	return 1;
+}
+
+static ssize_t compressed_reader_read(compressed_file_t *file, char *buf, size_t size) {
+	compressed_reader_t *reader = (compressed_reader_t *) file;
+	size_t out = 0;
+	while (out < size) {
+		int more = compressed_reader_fill(reader);
+		size_t available = reader->in_len - reader->in_pos;
+		size_t produced = 0;
+		if (more < 0) {
+			return -1;
+		}
+		switch (reader->codec) {
+#ifdef HAVE_ZLIB
+		case COMPRESSED_FILE_GZIP: {
+			reader->zs.next_in = reader->in + reader->in_pos;
+			reader->zs.avail_in = (uInt) available;
+			reader->zs.next_out = (Bytef *) buf + out;
+			reader->zs.avail_out = (uInt) (size - out);
+			int ret = inflate(&reader->zs, Z_NO_FLUSH);
+			reader->in_pos += available - reader->zs.avail_in;
+			produced = (size - out) - reader->zs.avail_out;
+			if (ret == Z_STREAM_END) {
+				inflateReset(&reader->zs); /* concatenated gzip members */
+			} else if (ret != Z_OK && ret != Z_BUF_ERROR) {
+				errno = EIO;
+				return -1;
+			}
+			break;
+		}
+#endif
+#ifdef HAVE_ZSTD
+		case COMPRESSED_FILE_ZSTD: {
+			ZSTD_inBuffer input = { reader->in + reader->in_pos, available, 0 };
+			ZSTD_outBuffer output = { buf + out, size - out, 0 };
+			size_t ret = ZSTD_decompressStream(reader->zds, &output, &input);
+			if (ZSTD_isError(ret)) {
+				errno = EIO;
+				return -1;
+			}
+			reader->in_pos += input.pos;
+			produced = output.pos;
+			break;
+		}
+#endif
+		default:
+			produced = (available < size - out) ? available : size - out;
+			memcpy(buf + out, reader->in + reader->in_pos, produced);
+			reader->in_pos += produced;
+			break;
+		}
+		out += produced;
+		if (!more && produced == 0) {
+			break;
+		}
+	}
+	return (ssize_t) out;
+}
+
+static int compressed_reader_close(compressed_file_t *file) {
+	compressed_reader_t *reader = (compressed_reader_t *) file;
+#ifdef HAVE_ZLIB
+	if (reader->codec == COMPRESSED_FILE_GZIP) {
+		inflateEnd(&reader->zs);
+	}
+#endif
+#ifdef HAVE_ZSTD
+	if (reader->zds != NULL) {
+		ZSTD_freeDStream(reader->zds);
+	}
+#endif
+	int r = close(reader->fd);
+	free(reader->in);
+	free(reader);
+	return r;
+}
+
+typedef struct compressed_writer {
+	compressed_file_t base;
+	int fd;
+	int codec;
+	int error;
+	int finishing;
+	u_char *chunks;
+	size_t lengths[COMPRESSED_FILE_CHUNKS];
+	size_t fill;
+	uint64_t produced;
+	uint64_t consumed;
+	u_char *out;
+	pthread_mutex_t lock;
+	pthread_cond_t cond;
+	pthread_t thread;
+#ifdef HAVE_ZLIB
+	z_stream zs;
+#endif
+#ifdef HAVE_ZSTD
+	ZSTD_CStream *zcs;
+#endif
+} compressed_writer_t;
+
+static u_char *compressed_writer_chunk(compressed_writer_t *writer, uint64_t seq) {
+	return writer->chunks + (size_t) (seq % COMPRESSED_FILE_CHUNKS) * COMPRESSED_FILE_CHUNK;
+}
+
+/* compression thread: compress and write one chunk, or finish the stream if data is NULL */
+static int compressed_writer_compress(compressed_writer_t *writer, const u_char *data, size_t len) {
+	switch (writer->codec) {
+#ifdef HAVE_ZLIB
+	case COMPRESSED_FILE_GZIP: {
+		int ret;
+		writer->zs.next_in = (Bytef *) data;
+		writer->zs.avail_in = (uInt) len;
+		do {
+			writer->zs.next_out = writer->out;
+			writer->zs.avail_out = COMPRESSED_FILE_CHUNK;
+			ret = deflate(&writer->zs, data == NULL ? Z_FINISH : Z_NO_FLUSH);
+			if (ret == Z_STREAM_ERROR
+					|| compressed_file_write_fd(writer->fd, writer->out, COMPRESSED_FILE_CHUNK - writer->zs.avail_out) < 0) {
+				return -1;
+			}
+		} while (writer->zs.avail_out == 0 || (data == NULL && ret != Z_STREAM_END));
+		return 0;
+	}
+#endif
+#ifdef HAVE_ZSTD
+	case COMPRESSED_FILE_ZSTD: {
+		ZSTD_inBuffer input = { data, len, 0 };
+		size_t remaining;
+		do {
+			ZSTD_outBuffer output = { writer->out, COMPRESSED_FILE_CHUNK, 0 };
+			remaining = (data == NULL) ? ZSTD_endStream(writer->zcs, &output)
+					: ZSTD_compressStream(writer->zcs, &output, &input);
+			if (ZSTD_isError(remaining) || compressed_file_write_fd(writer->fd, writer->out, output.pos) < 0) {
+				return -1;
+			}
+		} while (data == NULL ? remaining != 0 : input.pos < input.size);
+		return 0;
+	}
+#endif
+	default:
+		return data == NULL ? 0 : compressed_file_write_fd(writer->fd, data, len);
+	}
+}
+
+static void *compressed_writer_run(void *arg) {
+	compressed_writer_t *writer = (compressed_writer_t *) arg;
+	pthread_mutex_lock(&writer->lock);
+	for (;;) {
+		while (writer->consumed == writer->produced && !writer->finishing) {
+			pthread_cond_wait(&writer->cond, &writer->lock);
+		}
+		if (writer->consumed == writer->produced) {
+			break;
+		}
+		uint64_t seq = writer->consumed;
+		size_t len = writer->lengths[seq % COMPRESSED_FILE_CHUNKS];
+		pthread_mutex_unlock(&writer->lock);
+		int r = (writer->error == 0) ? compressed_writer_compress(writer, compressed_writer_chunk(writer, seq), len) : 0;
+		pthread_mutex_lock(&writer->lock);
+		if (r < 0) {
+			writer->error = errno != 0 ? errno : EIO;
+		}
+		writer->consumed++;
+		pthread_cond_broadcast(&writer->cond);
+	}
+	pthread_mutex_unlock(&writer->lock);
+	if (writer->error == 0 && compressed_writer_compress(writer, NULL, 0) < 0) {
+		writer->error = errno != 0 ? errno : EIO;
+	}
+	return NULL;
+}
+
+/* hand the current chunk to the compression thread, waiting only if every chunk is queued */
+static int compressed_writer_submit(compressed_writer_t *writer) {
+	pthread_mutex_lock(&writer->lock);
+	writer->lengths[writer->produced % COMPRESSED_FILE_CHUNKS] = writer->fill;
+	writer->produced++;
+	pthread_cond_broadcast(&writer->cond);
+	while (writer->produced - writer->consumed >= COMPRESSED_FILE_CHUNKS) {
+		pthread_cond_wait(&writer->cond, &writer->lock);
+	}
+	int error = writer->error;
+	pthread_mutex_unlock(&writer->lock);
+	writer->fill = 0;
+	return error;
+}
+
+static ssize_t compressed_writer_write(compressed_file_t *file, const char *buf, size_t size) {
+	compressed_writer_t *writer = (compressed_writer_t *) file;
+	size_t done = 0;
+	while (done < size) {
+		size_t n = COMPRESSED_FILE_CHUNK - writer->fill;
+		if (n > size - done) {
+			n = size - done;
+		}
+		memcpy(compressed_writer_chunk(writer, writer->produced) + writer->fill, buf + done, n);
+		writer->fill += n;
+		done += n;
+		if (writer->fill == COMPRESSED_FILE_CHUNK) {
+			int error = compressed_writer_submit(writer);
+			if (error != 0) {
+				errno = error;
+				return -1;
+			}
+		}
+	}
+	return (ssize_t) done;
+}
+
+static void compressed_writer_free(compressed_writer_t *writer) {
+#ifdef HAVE_ZLIB
+	if (writer->codec == COMPRESSED_FILE_GZIP) {
+		deflateEnd(&writer->zs);
+	}
+#endif
+#ifdef HAVE_ZSTD
+	if (writer->zcs != NULL) {
+		ZSTD_freeCStream(writer->zcs);
+	}
+#endif
+	pthread_cond_destroy(&writer->cond);
+	pthread_mutex_destroy(&writer->lock);
+	free(writer->chunks);
+	free(writer->out);
+	free(writer);
+}
+
+static int compressed_writer_close(compressed_file_t *file) {
+	compressed_writer_t *writer = (compressed_writer_t *) file;
+	if (writer->fill > 0) {
+		compressed_writer_submit(writer);
+	}
+	pthread_mutex_lock(&writer->lock);
+	writer->finishing = 1;
+	pthread_cond_broadcast(&writer->cond);
+	pthread_mutex_unlock(&writer->lock);
+	pthread_join(writer->thread, NULL);
+	int error = writer->error;
+	if (close(writer->fd) < 0 && error == 0) {
+		error = errno;
+	}
+	compressed_writer_free(writer);
+	if (error != 0) {
+		errno = error;
+		return -1;
+	}
+	return 0;
+}
+
+#endif
+
+FILE *compressed_file_open_read(const char *path, char *errbuf) {
+#if defined(WIN32)
+	snprintf(errbuf, PCAP_ERRBUF_SIZE, "Compressed files are not supported on this platform.");
+	return NULL;
+#else
+	compressed_reader_t *reader = (compressed_reader_t *) calloc(1, sizeof(compressed_reader_t));
+	if (reader == NULL || (reader->in = (u_char *) malloc(COMPRESSED_FILE_CHUNK)) == NULL) {
+		free(reader);
+		snprintf(errbuf, PCAP_ERRBUF_SIZE, "out of memory");
+		return NULL;
+	}
+	if ((reader->fd = open(path, O_RDONLY)) < 0) {
+		snprintf(errbuf, PCAP_ERRBUF_SIZE, "%s: %s", path, strerror(errno));
+		free(reader->in);
+		free(reader);
+		return NULL;
+	}
+	/* read at least the 4 magic bytes, the rest of the chunk is kept as decoder input */
+	while (reader->in_len < 4) {
+		ssize_t n = compressed_file_read_fd(reader->fd, reader->in + reader->in_len,
+				COMPRESSED_FILE_CHUNK - reader->in_len);
+		if (n <= 0) {
+			break;
+		}
+		reader->in_len += (size_t) n;
+	}
+
+	const u_char *magic = reader->in;
+	int ok = 1;
+	if (reader->in_len >= 2 && magic[0] == 0x1f && magic[1] == 0x8b) {
+		reader->codec = COMPRESSED_FILE_GZIP;
+#ifdef HAVE_ZLIB
+		ok = inflateInit2(&reader->zs, 15 + 32) == Z_OK;
+#else
+		ok = 0;
+#endif
+	} else if (reader->in_len >= 4 && magic[0] == 0x28 && magic[1] == 0xb5 && magic[2] == 0x2f && magic[3] == 0xfd) {
+		reader->codec = COMPRESSED_FILE_ZSTD;
+#ifdef HAVE_ZSTD
+		ok = (reader->zds = ZSTD_createDStream()) != NULL && !ZSTD_isError(ZSTD_initDStream(reader->zds));
+#else
+		ok = 0;
+#endif
+	} else if (lseek(reader->fd, 0, SEEK_SET) == 0) {
+		/* not compressed: a plain stdio stream */
+		FILE *fp = fdopen(reader->fd, "rb");
+		if (fp == NULL) {
+			snprintf(errbuf, PCAP_ERRBUF_SIZE, "%s: %s", path, strerror(errno));
+			close(reader->fd);
+		}
+		free(reader->in);
+		free(reader);
+		return fp;
+	} else {
+		/* not compressed and not seekable (a pipe or FIFO): pass through the bytes already read */
+		reader->codec = COMPRESSED_FILE_NONE;
+	}
+
+	if (!ok) {
+		snprintf(errbuf, PCAP_ERRBUF_SIZE, "%s: %s compression is not supported by this build", path,
+				reader->codec == COMPRESSED_FILE_GZIP ? "gzip" : "zstd");
+		reader->base.close = compressed_reader_close;
+		reader->base.close(&reader->base);
+		return NULL;
+	}
+
+	reader->base.read = compressed_reader_read;
+	reader->base.close = compressed_reader_close;
+	FILE *fp = compressed_file_stream(&reader->base, 0);
+	if (fp == NULL) {
+		snprintf(errbuf, PCAP_ERRBUF_SIZE, "%s: %s", path, strerror(errno));
+		compressed_reader_close(&reader->base);
+	}
+	return fp;
+#endif
+}
+
+FILE *compressed_file_open_write(const char *path, int codec, int level, char *errbuf) {
+#if defined(WIN32)
+	snprintf(errbuf, PCAP_ERRBUF_SIZE, "Compressed files are not supported on this platform.");
+	return NULL;
+#else
+	compressed_writer_t *writer = (compressed_writer_t *) calloc(1, sizeof(compressed_writer_t));
+	if (writer == NULL) {
+		snprintf(errbuf, PCAP_ERRBUF_SIZE, "out of memory");
+		return NULL;
+	}
+	writer->codec = codec;
+	writer->fd = -1;
+	pthread_mutex_init(&writer->lock, NULL);
+	pthread_cond_init(&writer->cond, NULL);
+	writer->chunks = (u_char *) malloc((size_t) COMPRESSED_FILE_CHUNK * COMPRESSED_FILE_CHUNKS);
+	writer->out = (u_char *) malloc(COMPRESSED_FILE_CHUNK);
+	if (writer->chunks == NULL || writer->out == NULL) {
+		snprintf(errbuf, PCAP_ERRBUF_SIZE, "out of memory");
+		compressed_writer_free(writer);
+		return NULL;
+	}
+
+	int ok;
+	switch (codec) {
+	case COMPRESSED_FILE_NONE:
+		ok = 1;
+		break;
+#ifdef HAVE_ZLIB
+	case COMPRESSED_FILE_GZIP:
+		ok = deflateInit2(&writer->zs, level, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY) == Z_OK;
+		break;
+#endif
+#ifdef HAVE_ZSTD
+	case COMPRESSED_FILE_ZSTD:
+		ok = (writer->zcs = ZSTD_createCStream()) != NULL && !ZSTD_isError(ZSTD_initCStream(writer->zcs, level));
+		break;
+#endif
+	default:
+		ok = 0;
+		break;
+	}
+	if (!ok) {
+		snprintf(errbuf, PCAP_ERRBUF_SIZE, "Compression %d is not supported by this build", codec);
+		writer->codec = COMPRESSED_FILE_NONE;
+		compressed_writer_free(writer);
+		return NULL;
+	}
+
+	if ((writer->fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644)) < 0) {
+		snprintf(errbuf, PCAP_ERRBUF_SIZE, "%s: %s", path, strerror(errno));
+		compressed_writer_free(writer);
+		return NULL;
+	}
+	if (pthread_create(&writer->thread, NULL, compressed_writer_run, writer) != 0) {
+		snprintf(errbuf, PCAP_ERRBUF_SIZE, "Unable to start compression thread");
+		close(writer->fd);
+		compressed_writer_free(writer);
+		return NULL;
+	}
+
+	writer->base.write = compressed_writer_write;
+	writer->base.close = compressed_writer_close;
+	FILE *fp = compressed_file_stream(&writer->base, 1);
+	if (fp == NULL) {
+		snprintf(errbuf, PCAP_ERRBUF_SIZE, "%s: %s", path, strerror(errno));
+		compressed_writer_close(&writer->base);
+	}
+	return fp;
+#endif
+}
@@ -0,0 +1,43 @@
+/**
+ * Copyright (C) 2017  Ardika Rommy Sanjaya
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _Included_compressed_file
+#define _Included_compressed_file
+
+#include <stdio.h>
+
+/* values of PcapCompression */
+#define COMPRESSED_FILE_NONE 0
+#define COMPRESSED_FILE_GZIP 1
+#define COMPRESSED_FILE_ZSTD 2
+
+/*
+ * Open a file for reading through a stdio stream that decompresses it on the fly.
+ * The codec is detected from the file magic; uncompressed files are opened as they are.
+ * Returns NULL and fills errbuf (PCAP_ERRBUF_SIZE) on error.
+ */
+FILE *compressed_file_open_read(const char *path, char *errbuf);
+
+/*
+ * Open a file for writing through a stdio stream that hands the data to a compression thread.
+ * The stream only blocks when every buffer is waiting for the compression thread.
+ * fclose() finishes the compressed stream and waits for the thread.
+ * Returns NULL and fills errbuf (PCAP_ERRBUF_SIZE) on error.
+ */
+FILE *compressed_file_open_write(const char *path, int codec, int level, char *errbuf);
+
+#endif
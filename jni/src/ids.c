@@ -18,15 +18,26 @@
 #include <jni.h>
 
 #include <fcntl.h>
+#include "ids.h"
 #include "utils.h"
 
+static jclass NewGlobalClassRef(JNIEnv *env, const char *name) {
+	jclass local = (*env)->FindClass(env, name);
+	if (local == NULL) {
+		return NULL;
+	}
+	jclass global = (jclass) (*env)->NewGlobalRef(env, local);
+	(*env)->DeleteLocalRef(env, local);
+	return global;
+}
+
 jclass StringBuilderClass = NULL;
 jmethodID StringBuilderSetLengthMID = NULL;
 jmethodID StringBuilderAppendMID = NULL;
 
 void SetStringBuilderIDs(JNIEnv *env) {
 
-	StringBuilderClass = (*env)->FindClass(env, "java/lang/StringBuilder");
+	StringBuilderClass = NewGlobalClassRef(env, "java/lang/StringBuilder");
 
 	if(StringBuilderClass == NULL) {
 		ThrowNew(env, CLASS_NOT_FOUND_EXCEPTION, "Unable to initialize class java.lang.StringBuilder");
@@ -57,7 +68,7 @@ jmethodID AddrGetStringAddressMID = NULL;
 
 void SetAddrIDs(JNIEnv *env) {
 
-	AddrClass = (*env)->FindClass(env, "com/ardikars/jxnet/Addr");
+	AddrClass = NewGlobalClassRef(env, "com/ardikars/jxnet/Addr");
 
 	if(AddrClass == NULL) {
 		ThrowNew(env, CLASS_NOT_FOUND_EXCEPTION, "Unable to initialize class com.ardikars.jxnet.Addr");
@@ -105,7 +116,7 @@ jmethodID ListAddMID = NULL;
 
 void SetListIDs(JNIEnv *env) {
 
-	ListClass = (*env)->FindClass(env, "java/util/List");
+	ListClass = NewGlobalClassRef(env, "java/util/List");
 
 	if(ListClass == NULL) {
 		ThrowNew(env, CLASS_NOT_FOUND_EXCEPTION, "Unable to initialize class java.util.List");
@@ -121,6 +132,7 @@ void SetListIDs(JNIEnv *env) {
 }
 
 jclass PcapIfClass = NULL;
+jmethodID PcapIfInitMID = NULL;
 jfieldID PcapIfNextFID = NULL;
 jfieldID PcapIfNameFID = NULL;
 jfieldID PcapIfDescriptionFID = NULL;
@@ -129,7 +141,7 @@ jfieldID PcapIfFlagsFID = NULL;
 
 void SetPcapIfIDs(JNIEnv *env) {
 
-	PcapIfClass = (*env)->FindClass(env, "com/ardikars/jxnet/PcapIf");
+	PcapIfClass = NewGlobalClassRef(env, "com/ardikars/jxnet/PcapIf");
 
 	if(PcapIfClass == NULL) {
 		ThrowNew(env, CLASS_NOT_FOUND_EXCEPTION, "Unable to initialize class com.ardikars.jxnet.PcapIf");
@@ -170,9 +182,17 @@ void SetPcapIfIDs(JNIEnv *env) {
 		ThrowNew(env, NO_SUCH_FIELD_EXCEPTION, "Unable to initialize field PcapIf.flags:int");
 		return;
 	}
+
+	PcapIfInitMID = (*env)->GetMethodID(env, PcapIfClass, "<init>", "()V");
+
+	if (PcapIfInitMID == NULL) {
+		ThrowNew(env, NO_SUCH_METHOD_EXCEPTION, "Unable to initialize method PcapIf()");
+		return;
+	}
 }
 
 jclass PcapAddrClass = NULL;
+jmethodID PcapAddrInitMID = NULL;
 jfieldID PcapAddrNextFID = NULL;
 jfieldID PcapAddrAddrFID = NULL;
 jfieldID PcapAddrNetmaskFID = NULL;
@@ -181,7 +201,7 @@ jfieldID PcapAddrDstAddrFID = NULL;
 
 void SetPcapAddrIDs(JNIEnv *env) {
 
-	PcapAddrClass = (*env)->FindClass(env, "com/ardikars/jxnet/PcapAddr");
+	PcapAddrClass = NewGlobalClassRef(env, "com/ardikars/jxnet/PcapAddr");
 
 	if(PcapAddrClass == NULL) {
 		ThrowNew(env, CLASS_NOT_FOUND_EXCEPTION, "Unable to initialize class com.ardikars.jxnet.PcapAddr");
@@ -222,15 +242,23 @@ void SetPcapAddrIDs(JNIEnv *env) {
 		ThrowNew(env, NO_SUCH_FIELD_EXCEPTION, "Unable to initialize field PcapAddr.dstaddr:SockAddr");
 		return;
 	}
+
+	PcapAddrInitMID = (*env)->GetMethodID(env, PcapAddrClass, "<init>", "()V");
+
+	if (PcapAddrInitMID == NULL) {
+		ThrowNew(env, NO_SUCH_METHOD_EXCEPTION, "Unable to initialize method PcapAddr()");
+		return;
+	}
 }
 
 jclass SockAddrClass = NULL;
+jmethodID SockAddrInitMID = NULL;
 jfieldID SockAddrSaFamilyFID = NULL;
 jfieldID SockAddrDataFID = NULL;
 
 void SetSockAddrIDs(JNIEnv *env) {
 
-	SockAddrClass = (*env)->FindClass(env, "com/ardikars/jxnet/SockAddr");
+	SockAddrClass = NewGlobalClassRef(env, "com/ardikars/jxnet/SockAddr");
 
 	if(SockAddrClass == NULL) {
 		ThrowNew(env, CLASS_NOT_FOUND_EXCEPTION, "Unable to initialize class com.ardikars.jxnet.SockAddr");
@@ -250,15 +278,24 @@ void SetSockAddrIDs(JNIEnv *env) {
 		ThrowNew(env, NO_SUCH_FIELD_EXCEPTION, "Unable to initialize field SockAddr.data:byte[]");
 		return;
 	}
+
+	SockAddrInitMID = (*env)->GetMethodID(env, SockAddrClass, "<init>", "()V");
+
+	if (SockAddrInitMID == NULL) {
+		ThrowNew(env, NO_SUCH_METHOD_EXCEPTION, "Unable to initialize method SockAddr()");
+		return;
+	}
 }
 
 jclass PcapClass = NULL;
+jmethodID PcapInitMID = NULL;
 jfieldID PcapAddressFID = NULL;
+jfieldID PcapFilterAddressFID = NULL;
 jmethodID PcapGetAddressMID = NULL;
 
 void SetPcapIDs(JNIEnv *env) {
 
-  	PcapClass = (*env)->FindClass(env, "com/ardikars/jxnet/Pcap");
+  	PcapClass = NewGlobalClassRef(env, "com/ardikars/jxnet/Pcap");
 
   	if (PcapClass == NULL) {
 		ThrowNew(env, CLASS_NOT_FOUND_EXCEPTION, "Unable to initialize class com.ardikars.jxnet.Pcap");
@@ -272,12 +309,26 @@ void SetPcapIDs(JNIEnv *env) {
 		return;
 	}
 
+	PcapFilterAddressFID = (*env)->GetFieldID(env, PcapClass, "filterAddress", "J");
+
+	if (PcapFilterAddressFID == NULL) {
+		ThrowNew(env, NO_SUCH_FIELD_EXCEPTION, "Unable to initialize field Pcap.filterAddress:long");
+		return;
+	}
+
 	PcapGetAddressMID = (*env)->GetMethodID(env, PcapClass, "getAddress", "()J");
 
 	if (PcapGetAddressMID == NULL) {
 		ThrowNew(env, NO_SUCH_METHOD_EXCEPTION, "Unable to initialize method Pcap.getAddress(long)");
 		return;
 	}
+
+	PcapInitMID = (*env)->GetMethodID(env, PcapClass, "<init>", "()V");
+
+	if (PcapInitMID == NULL) {
+		ThrowNew(env, NO_SUCH_METHOD_EXCEPTION, "Unable to initialize method Pcap()");
+		return;
+	}
 }
 
 jclass FileClass = NULL;
@@ -286,7 +337,7 @@ jmethodID FileGetAddressMID = NULL;
 
 void SetFileIDs(JNIEnv *env) {
 
-	FileClass = (*env)->FindClass(env, "com/ardikars/jxnet/File");
+	FileClass = NewGlobalClassRef(env, "com/ardikars/jxnet/File");
 
 	if (FileClass == NULL) {
 		ThrowNew(env, CLASS_NOT_FOUND_EXCEPTION, "Unable to initialize class com.ardikars.jxnet.File");
@@ -310,6 +361,7 @@ void SetFileIDs(JNIEnv *env) {
 }
 
 jclass PcapPktHdrClass = NULL;
+jmethodID PcapPktHdrInitMID = NULL;
 jfieldID PcapPktHdrCaplenFID = NULL;
 jfieldID PcapPktHdrLenFID = NULL;
 jfieldID PcapPktHdrTvSecFID = NULL;
@@ -317,7 +369,7 @@ jfieldID PcapPktHdrTvUsecFID = NULL;
 
 void SetPcapPktHdrIDs(JNIEnv *env) {
 
-	PcapPktHdrClass = (*env)->FindClass(env, "com/ardikars/jxnet/PcapPktHdr");
+	PcapPktHdrClass = NewGlobalClassRef(env, "com/ardikars/jxnet/PcapPktHdr");
 
 	if(PcapPktHdrClass == NULL) {
 		ThrowNew(env, CLASS_NOT_FOUND_EXCEPTION, "Unable to initialize class com.ardikars.jxnet.PcapPktHdr");
@@ -351,6 +403,13 @@ void SetPcapPktHdrIDs(JNIEnv *env) {
 		ThrowNew(env, NO_SUCH_FIELD_EXCEPTION, "Unable to initialize field PcapPktHdr.tv_usec:long");
 		return;
 	}
+
+	PcapPktHdrInitMID = (*env)->GetMethodID(env, PcapPktHdrClass, "<init>", "()V");
+
+	if (PcapPktHdrInitMID == NULL) {
+		ThrowNew(env, NO_SUCH_METHOD_EXCEPTION, "Unable to initialize method PcapPktHdr()");
+		return;
+	}
 }
 
 jclass ByteBufferClass = NULL;
@@ -359,7 +418,7 @@ jmethodID ByteBufferPutMID = NULL;
 
 void SetByteBufferIDs(JNIEnv *env) {
 
-	ByteBufferClass = (*env)->FindClass(env, "java/nio/ByteBuffer");
+	ByteBufferClass = NewGlobalClassRef(env, "java/nio/ByteBuffer");
 
 	if(ByteBufferClass == NULL) {
 		ThrowNew(env, CLASS_NOT_FOUND_EXCEPTION, "Unable to initialize class java.nio.ByteBuffer");
@@ -381,13 +440,48 @@ void SetByteBufferIDs(JNIEnv *env) {
 	}
 }
 
+jclass BufferClass = NULL;
+jfieldID BufferAddressFID = NULL;
+jfieldID BufferCapacityFID = NULL;
+jfieldID BufferLimitFID = NULL;
+jfieldID BufferPositionFID = NULL;
+jfieldID BufferMarkFID = NULL;
+
+/*
+ * Private fields of java.nio.Buffer, used to re-point a direct buffer at another memory region.
+ * They are optional: if the runtime does not have them, the IDs stay NULL and
+ * callers fall back to creating a new direct buffer.
+ */
+void SetBufferIDs(JNIEnv *env) {
+
+	BufferClass = NewGlobalClassRef(env, "java/nio/Buffer");
+
+	if (BufferClass == NULL) {
+		ThrowNew(env, CLASS_NOT_FOUND_EXCEPTION, "Unable to initialize class java.nio.Buffer");
+		return;
+	}
+
+	BufferAddressFID = (*env)->GetFieldID(env, BufferClass, "address", "J");
+	BufferCapacityFID = (*env)->GetFieldID(env, BufferClass, "capacity", "I");
+	BufferLimitFID = (*env)->GetFieldID(env, BufferClass, "limit", "I");
+	BufferPositionFID = (*env)->GetFieldID(env, BufferClass, "position", "I");
+	BufferMarkFID = (*env)->GetFieldID(env, BufferClass, "mark", "I");
+
+	if (BufferAddressFID == NULL || BufferCapacityFID == NULL || BufferLimitFID == NULL
+			|| BufferPositionFID == NULL || BufferMarkFID == NULL) {
+		(*env)->ExceptionClear(env);
+		BufferAddressFID = NULL;
+	}
+}
+
 jclass PcapDumperClass = NULL;
+jmethodID PcapDumperInitMID = NULL;
 jfieldID PcapDumperAddressFID = NULL;
 jmethodID PcapDumperGetAddressMID = NULL;
 
 void SetPcapDumperIDs(JNIEnv *env) {
 
-	PcapDumperClass = (*env)->FindClass(env, "com/ardikars/jxnet/PcapDumper");
+	PcapDumperClass = NewGlobalClassRef(env, "com/ardikars/jxnet/PcapDumper");
 
 	if (PcapDumperClass == NULL) {
 		ThrowNew(env, CLASS_NOT_FOUND_EXCEPTION, "Unable to initialize class com.ardikars.jxnet.PcapDumper");
@@ -407,15 +501,23 @@ void SetPcapDumperIDs(JNIEnv *env) {
 		ThrowNew(env, NO_SUCH_METHOD_EXCEPTION, "Unable to initialize method PcapDumper.getAddress(long)");
 		return;
 	}
+
+	PcapDumperInitMID = (*env)->GetMethodID(env, PcapDumperClass, "<init>", "()V");
+
+	if (PcapDumperInitMID == NULL) {
+		ThrowNew(env, NO_SUCH_METHOD_EXCEPTION, "Unable to initialize method PcapDumper()");
+		return;
+	}
 }
 
 jclass BpfProgramClass = NULL;
 jfieldID BpfProgramAddressFID = NULL;
+jfieldID BpfProgramJitAddressFID = NULL;
 jmethodID BpfProgramGetAddressMID = NULL;
 
 void SetBpfProgramIDs(JNIEnv *env) {
 
-	BpfProgramClass = (*env)->FindClass(env, "com/ardikars/jxnet/BpfProgram");
+	BpfProgramClass = NewGlobalClassRef(env, "com/ardikars/jxnet/BpfProgram");
 
 	if (BpfProgramClass == NULL) {
 		ThrowNew(env, CLASS_NOT_FOUND_EXCEPTION, "Unable to initialize class com.ardikars.jxnet.BpfProgram");
@@ -429,6 +531,13 @@ void SetBpfProgramIDs(JNIEnv *env) {
 		return;
 	}
 
+	BpfProgramJitAddressFID = (*env)->GetFieldID(env, BpfProgramClass, "jitAddress", "J");
+
+	if (BpfProgramJitAddressFID == NULL) {
+		ThrowNew(env, NO_SUCH_FIELD_EXCEPTION, "Unable to initialize field BpfProgram.jitAddress:long");
+		return;
+	}
+
 	BpfProgramGetAddressMID = (*env)->GetMethodID(env, BpfProgramClass, "getAddress", "()J");
 
 	if (BpfProgramGetAddressMID == NULL) {
@@ -445,7 +554,7 @@ jfieldID PcapStatPsIfDropFID = NULL;
 
 void SetPcapStatIDs(JNIEnv *env) {
 
-	PcapStatClass = (*env)->FindClass(env, "com/ardikars/jxnet/PcapStat");
+	PcapStatClass = NewGlobalClassRef(env, "com/ardikars/jxnet/PcapStat");
 
 	if(PcapStatClass == NULL) {
 		ThrowNew(env, CLASS_NOT_FOUND_EXCEPTION, "Unable to initialize class com.ardikars.jxnet.PcapStat");
@@ -481,7 +590,7 @@ jfieldID Inet4AddressAddressFID = NULL;
 
 void SetInet4AddressIDs(JNIEnv *env) {
 
-	Inet4AddressClass = (*env)->FindClass(env, "com/ardikars/jxnet/Inet4Address");
+	Inet4AddressClass = NewGlobalClassRef(env, "com/ardikars/jxnet/Inet4Address");
 
 	if(Inet4AddressClass == NULL) {
 		ThrowNew(env, CLASS_NOT_FOUND_EXCEPTION, "Unable to initialize class com.ardikars.jxnet.Inet4Address");
@@ -515,7 +624,7 @@ jmethodID PcapDirectionNameMID = NULL;
 
 void SetPcapDirectionIDs(JNIEnv *env) {
 
-	PcapDirectionClass = (*env)->FindClass(env, "com/ardikars/jxnet/PcapDirection");
+	PcapDirectionClass = NewGlobalClassRef(env, "com/ardikars/jxnet/PcapDirection");
 
 	if(PcapDirectionClass == NULL) {
 		ThrowNew(env, CLASS_NOT_FOUND_EXCEPTION, "Unable to initialize class com.ardikars.jxnet.PcapDirection");
@@ -535,7 +644,7 @@ jmethodID MacAddressValueOfMID = NULL;
 
 void SetMacAddressIDs(JNIEnv *env) {
 
-	MacAddressClass = (*env)->FindClass(env, "com/ardikars/jxnet/MacAddress");
+	MacAddressClass = NewGlobalClassRef(env, "com/ardikars/jxnet/MacAddress");
 
 	if (MacAddressClass == NULL) {
 		ThrowNew(env, CLASS_NOT_FOUND_EXCEPTION, "Unable to initialize class com.ardikars.jxnet.MacAddress");
@@ -550,3 +659,97 @@ void SetMacAddressIDs(JNIEnv *env) {
 	}
 }
 
+
+jclass PcapHandlerClass = NULL;
+jmethodID PcapHandlerNextPacketMID = NULL;
+
+void SetPcapHandlerIDs(JNIEnv *env) {
+
+	PcapHandlerClass = NewGlobalClassRef(env, "com/ardikars/jxnet/PcapHandler");
+
+	if (PcapHandlerClass == NULL) {
+		ThrowNew(env, CLASS_NOT_FOUND_EXCEPTION, "Unable to initialize class com.ardikars.jxnet.PcapHandler");
+		return;
+	}
+
+	PcapHandlerNextPacketMID = (*env)->GetMethodID(env, PcapHandlerClass, "nextPacket",
+			"(Ljava/lang/Object;Lcom/ardikars/jxnet/PcapPktHdr;Ljava/nio/ByteBuffer;)V");
+
+	if (PcapHandlerNextPacketMID == NULL) {
+		ThrowNew(env, NO_SUCH_METHOD_EXCEPTION, "Unable to initialize method PcapHandler.nextPacket(Object,PcapPktHdr,ByteBuffer)");
+		return;
+	}
+}
+
+/*
+ * All class, method and field IDs are resolved once when the library is loaded.
+ * Classes are pinned with global references, so the IDs stay valid on every thread.
+ */
+static void (* const SetIDs[])(JNIEnv *env) = {
+	SetStringBuilderIDs,
+	SetListIDs,
+	SetPcapIfIDs,
+	SetPcapAddrIDs,
+	SetFileIDs,
+	SetSockAddrIDs,
+	SetPcapIDs,
+	SetPcapPktHdrIDs,
+	SetByteBufferIDs,
+	SetBufferIDs,
+	SetPcapDumperIDs,
+	SetBpfProgramIDs,
+	SetPcapStatIDs,
+	SetInet4AddressIDs,
+	SetPcapDirectionIDs,
+	SetMacAddressIDs,
+	SetPcapHandlerIDs
+};
+
+static jclass * const GlobalClasses[] = {
+	&StringBuilderClass,
+	&ListClass,
+	&PcapIfClass,
+	&PcapAddrClass,
+	&FileClass,
+	&SockAddrClass,
+	&PcapClass,
+	&PcapPktHdrClass,
+	&ByteBufferClass,
+	&BufferClass,
+	&PcapDumperClass,
+	&BpfProgramClass,
+	&PcapStatClass,
+	&Inet4AddressClass,
+	&PcapDirectionClass,
+	&MacAddressClass,
+	&PcapHandlerClass
+};
+
+JNIEXPORT jint JNICALL JNI_OnLoad(JavaVM *vm, void *reserved) {
+	JNIEnv *env = NULL;
+	if ((*vm)->GetEnv(vm, (void **) &env, JNI_VERSION_1_6) != JNI_OK) {
+		return JNI_ERR;
+	}
+	size_t i;
+	for (i = 0; i < sizeof(SetIDs) / sizeof(SetIDs[0]); i++) {
+		SetIDs[i](env);
+		if ((*env)->ExceptionCheck(env)) {
+			return JNI_ERR;
+		}
+	}
+	return JNI_VERSION_1_6;
+}
+
+JNIEXPORT void JNICALL JNI_OnUnload(JavaVM *vm, void *reserved) {
+	JNIEnv *env = NULL;
+	if ((*vm)->GetEnv(vm, (void **) &env, JNI_VERSION_1_6) != JNI_OK) {
+		return;
+	}
+	size_t i;
+	for (i = 0; i < sizeof(GlobalClasses) / sizeof(GlobalClasses[0]); i++) {
+		if (*GlobalClasses[i] != NULL) {
+			(*env)->DeleteGlobalRef(env, *GlobalClasses[i]);
+			*GlobalClasses[i] = NULL;
+		}
+	}
+}
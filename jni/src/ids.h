@@ -38,6 +38,7 @@ extern jmethodID ListAddMID;
 void SetListIDs(JNIEnv *env);
 
 extern jclass PcapIfClass;
+extern jmethodID PcapIfInitMID;
 extern jfieldID PcapIfNextFID;
 extern jfieldID PcapIfNameFID;
 extern jfieldID PcapIfDescriptionFID;
@@ -47,6 +48,7 @@ extern jfieldID PcapIfFlagsFID;
 void SetPcapIfIDs(JNIEnv *env);
 
 extern jclass PcapAddrClass;
+extern jmethodID PcapAddrInitMID;
 extern jfieldID PcapAddrNextFID;
 extern jfieldID PcapAddrAddrFID;
 extern jfieldID PcapAddrNetmaskFID;
@@ -62,18 +64,22 @@ extern jmethodID FileGetAddressMID;
 void SetFileIDs(JNIEnv *env);
 
 extern jclass SockAddrClass;
+extern jmethodID SockAddrInitMID;
 extern jfieldID SockAddrSaFamilyFID;
 extern jfieldID SockAddrDataFID;
 
 void SetSockAddrIDs(JNIEnv *env);
 
 extern jclass PcapClass;
+extern jmethodID PcapInitMID;
 extern jfieldID PcapAddressFID;
+extern jfieldID PcapFilterAddressFID;
 extern jmethodID PcapGetAddressMID;
 
 void SetPcapIDs(JNIEnv *env);
 
 extern jclass PcapPktHdrClass;
+extern jmethodID PcapPktHdrInitMID;
 extern jfieldID PcapPktHdrCaplenFID;
 extern jfieldID PcapPktHdrLenFID;
 extern jfieldID PcapPktHdrTvSecFID;
@@ -87,7 +93,17 @@ extern jmethodID ByteBufferPutMID;
 
 void SetByteBufferIDs(JNIEnv *env);
 
+extern jclass BufferClass;
+extern jfieldID BufferAddressFID;
+extern jfieldID BufferCapacityFID;
+extern jfieldID BufferLimitFID;
+extern jfieldID BufferPositionFID;
+extern jfieldID BufferMarkFID;
+
+void SetBufferIDs(JNIEnv *env);
+
 extern jclass PcapDumperClass;
+extern jmethodID PcapDumperInitMID;
 extern jfieldID PcapDumperAddressFID;
 extern jmethodID PcapDumperGetAddressMID;
 
@@ -95,6 +111,7 @@ void SetPcapDumperIDs(JNIEnv *env);
 
 extern jclass BpfProgramClass;
 extern jfieldID BpfProgramAddressFID;
+extern jfieldID BpfProgramJitAddressFID;
 extern jmethodID BpfProgramGetAddressMID;
 
 void SetBpfProgramIDs(JNIEnv *env);
@@ -123,3 +140,7 @@ extern jmethodID MacAddressValueOfMID;
 
 void SetMacAddressIDs(JNIEnv *env);
 
+extern jclass PcapHandlerClass;
+extern jmethodID PcapHandlerNextPacketMID;
+
+void SetPcapHandlerIDs(JNIEnv *env);
@@ -15,19 +15,35 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#if defined(__linux__) && defined(HAVE_SENDMMSG) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE
+#endif
+
 #include "../include/jxnet/com_ardikars_jxnet_Jxnet.h"
 
 #include <pcap.h>
 #include <string.h>
+#include <errno.h>
 
 #include "ids.h"
 #include "utils.h"
 #include "preconditions.h"
+#include "compressed_file.h"
+#include "packet_summary.h"
 
 #ifndef WIN32
 #include <sys/socket.h>
 #endif
 
+#if defined(__linux__)
+#include <linux/if_packet.h>
+#if defined(PACKET_FANOUT) && !defined(PACKET_FANOUT_QM)
+#define PACKET_FANOUT_QM 5
+#endif
+#endif
+
+#define PCAP_SEND_BATCH_SIZE 64
+
 /*
  * Class:     com_ardikars_jxnet_Jxnet
  * Method:    PcapFindAllDevs
@@ -39,11 +55,6 @@ JNIEXPORT jint JNICALL Java_com_ardikars_jxnet_Jxnet_PcapFindAllDevs
 	if (CheckNotNull(env, jlist_pcap_if, NULL) == NULL) return -1;
 	if (CheckNotNull(env, jerrbuf, NULL) == NULL) return -1;
 
-	SetListIDs(env);
-	SetPcapIfIDs(env);
-	SetPcapAddrIDs(env);
-	SetSockAddrIDs(env);
-
 	pcap_if_t *alldevsp = NULL;
 	char errbuf[PCAP_ERRBUF_SIZE];
 	int r = -1;
@@ -64,7 +75,7 @@ JNIEXPORT jint JNICALL Java_com_ardikars_jxnet_Jxnet_PcapFindAllDevs
 
 	while(dev != NULL) {
 
-		pcap_if = NewObject(env, PcapIfClass, "<init>", "()V");
+		pcap_if = (*env)->NewObject(env, PcapIfClass, PcapIfInitMID);
 
 		if (dev->name != NULL) {
 			(*env)->SetObjectField(env, pcap_if, PcapIfNameFID,
@@ -85,7 +96,7 @@ JNIEXPORT jint JNICALL Java_com_ardikars_jxnet_Jxnet_PcapFindAllDevs
 
 		while (addr != NULL) {
 
-			pcap_addr = NewObject(env, PcapAddrClass, "<init>", "()V");
+			pcap_addr = (*env)->NewObject(env, PcapAddrClass, PcapAddrInitMID);
 
 			if (addr->addr != NULL) {
 				(*env)->SetObjectField(env, pcap_addr, PcapAddrAddrFID,
@@ -184,7 +195,6 @@ JNIEXPORT jint JNICALL Java_com_ardikars_jxnet_Jxnet_PcapLoop
 	if (CheckNotNull(env, jpcap, NULL) == NULL) return -1;
 	if (CheckNotNull(env, jcallback, NULL) == NULL) return -1;
 
- 	SetPcapPktHdrIDs(env);
  	pcap_t *pcap = GetPcap(env, jpcap); // Exception already thrown
 
 	if (pcap == NULL) {
@@ -196,12 +206,11 @@ JNIEXPORT jint JNICALL Java_com_ardikars_jxnet_Jxnet_PcapLoop
  	user_data.env = env;
  	user_data.callback = jcallback;
  	user_data.user = juser;
- 	user_data.PcapHandlerClass = (*env)->GetObjectClass(env, jcallback);
- 	user_data.PcapHandlerNextPacketMID = (*env)->GetMethodID(env,
-			user_data.PcapHandlerClass, "nextPacket",
-			"(Ljava/lang/Object;Lcom/ardikars/jxnet/PcapPktHdr;Ljava/nio/ByteBuffer;)V");
+	user_data.filter = AcquirePcapFilter(env, jpcap);
 
-  	return pcap_loop(pcap, (int) jcnt, pcap_callback, (u_char *) &user_data);
+	int r = pcap_loop(pcap, (int) jcnt, pcap_callback, (u_char *) &user_data);
+	bpf_jit_filter_free(user_data.filter);
+	return r;
   }
 
 /*
@@ -216,7 +225,6 @@ JNIEXPORT jint JNICALL Java_com_ardikars_jxnet_Jxnet_PcapDispatch
 	if (CheckNotNull(env, jcallback, NULL) == NULL) return -1;
 	if (!CheckArgument(env, (jcnt > 0), NULL)) return -1;
 
- 	SetPcapPktHdrIDs(env);
  	pcap_t *pcap = GetPcap(env, jpcap); // Exception already thrown
 
 	if(pcap == NULL) {
@@ -228,11 +236,169 @@ JNIEXPORT jint JNICALL Java_com_ardikars_jxnet_Jxnet_PcapDispatch
  	user_data.env = env;
  	user_data.callback = jcallback;
  	user_data.user = juser;
- 	user_data.PcapHandlerClass = (*env)->GetObjectClass(env, jcallback);
- 	user_data.PcapHandlerNextPacketMID = (*env)->GetMethodID(env,
-			user_data.PcapHandlerClass, "nextPacket", "(Ljava/lang/Object;Lcom/ardikars/jxnet/PcapPktHdr;Ljava/nio/ByteBuffer;)V");
+	user_data.filter = AcquirePcapFilter(env, jpcap);
 
-	return pcap_dispatch(pcap, (int) jcnt, pcap_callback, (u_char *) &user_data);
+	int r = pcap_dispatch(pcap, (int) jcnt, pcap_callback, (u_char *) &user_data);
+	bpf_jit_filter_free(user_data.filter);
+	return r;
+  }
+
+/*
+ * Class:     com_ardikars_jxnet_Jxnet
+ * Method:    PcapLoopReuse
+ * Signature: (Lcom/ardikars/jxnet/Pcap;ILcom/ardikars/jxnet/PcapHandler;Ljava/lang/Object;)I
+ */
+JNIEXPORT jint JNICALL Java_com_ardikars_jxnet_Jxnet_PcapLoopReuse
+  (JNIEnv *env, jclass jcls, jobject jpcap, jint jcnt, jobject jcallback, jobject juser) {
+
+	if (CheckNotNull(env, jpcap, NULL) == NULL) return -1;
+	if (CheckNotNull(env, jcallback, NULL) == NULL) return -1;
+
+	pcap_t *pcap = GetPcap(env, jpcap); // Exception already thrown
+
+	if (pcap == NULL) {
+		return -1;
+	}
+
+	pcap_user_data_t user_data;
+	memset(&user_data, 0, sizeof(user_data));
+	user_data.env = env;
+	user_data.callback = jcallback;
+	user_data.user = juser;
+	user_data.filter = AcquirePcapFilter(env, jpcap);
+	user_data.pkt_hdr = (*env)->NewObject(env, PcapPktHdrClass, PcapPktHdrInitMID);
+
+	int r = pcap_loop(pcap, (int) jcnt, pcap_reuse_callback, (u_char *) &user_data);
+
+	bpf_jit_filter_free(user_data.filter);
+	if (user_data.pkt_data != NULL) {
+		(*env)->DeleteLocalRef(env, user_data.pkt_data);
+	}
+	(*env)->DeleteLocalRef(env, user_data.pkt_hdr);
+	return r;
+  }
+
+/*
+ * Class:     com_ardikars_jxnet_Jxnet
+ * Method:    PcapDispatchReuse
+ * Signature: (Lcom/ardikars/jxnet/Pcap;ILcom/ardikars/jxnet/PcapHandler;Ljava/lang/Object;)I
+ */
+JNIEXPORT jint JNICALL Java_com_ardikars_jxnet_Jxnet_PcapDispatchReuse
+  (JNIEnv *env, jclass jcls, jobject jpcap, jint jcnt, jobject jcallback, jobject juser) {
+
+	if (CheckNotNull(env, jpcap, NULL) == NULL) return -1;
+	if (CheckNotNull(env, jcallback, NULL) == NULL) return -1;
+	if (!CheckArgument(env, (jcnt > 0), NULL)) return -1;
+
+	pcap_t *pcap = GetPcap(env, jpcap); // Exception already thrown
+
+	if(pcap == NULL) {
+		return (jint) -1;
+	}
+
+	pcap_user_data_t user_data;
+	memset(&user_data, 0, sizeof(user_data));
+	user_data.env = env;
+	user_data.callback = jcallback;
+	user_data.user = juser;
+	user_data.filter = AcquirePcapFilter(env, jpcap);
+	user_data.pkt_hdr = (*env)->NewObject(env, PcapPktHdrClass, PcapPktHdrInitMID);
+
+	int r = pcap_dispatch(pcap, (int) jcnt, pcap_reuse_callback, (u_char *) &user_data);
+
+	bpf_jit_filter_free(user_data.filter);
+	if (user_data.pkt_data != NULL) {
+		(*env)->DeleteLocalRef(env, user_data.pkt_data);
+	}
+	(*env)->DeleteLocalRef(env, user_data.pkt_hdr);
+	return r;
+  }
+
+/*
+ * Class:     com_ardikars_jxnet_Jxnet
+ * Method:    PcapDispatchBatch
+ * Signature: (Lcom/ardikars/jxnet/Pcap;Ljava/nio/ByteBuffer;I)I
+ */
+JNIEXPORT jint JNICALL Java_com_ardikars_jxnet_Jxnet_PcapDispatchBatch
+  (JNIEnv *env, jclass jcls, jobject jpcap, jobject jbuf, jint jmax_packets) {
+
+	if (CheckNotNull(env, jpcap, NULL) == NULL) return -1;
+	if (CheckNotNull(env, jbuf, NULL) == NULL) return -1;
+	if (!CheckArgument(env, (jmax_packets > 0), NULL)) return -1;
+
+	pcap_t *pcap = GetPcap(env, jpcap); // Exception already thrown
+
+	if(pcap == NULL) {
+		return (jint) -1;
+	}
+
+	u_char *buf = (u_char *) (*env)->GetDirectBufferAddress(env, jbuf);
+
+	if(buf == NULL) {
+		ThrowNew(env, NULL_PTR_EXCEPTION, "Unable to retrive address from ByteBuffer");
+		return (jint) -1;
+	}
+
+	jlong capacity = (*env)->GetDirectBufferCapacity(env, jbuf);
+	jlong record_size = (jlong) sizeof(pcap_batch_pkthdr_t) + pcap_snapshot(pcap);
+
+	// Only ask libpcap for as many packets as are guaranteed to fit, so none is lost.
+	jlong cnt = capacity / record_size;
+	if (!CheckArgument(env, (cnt > 0), "ByteBuffer is too small to hold a packet of snapshot length.")) return -1;
+	if (cnt > jmax_packets) {
+		cnt = jmax_packets;
+	}
+
+	pcap_batch_t batch;
+	batch.buf = buf;
+	batch.capacity = (size_t) capacity;
+	batch.offset = 0;
+	batch.count = 0;
+	batch.filter = AcquirePcapFilter(env, jpcap);
+
+	int r = pcap_dispatch(pcap, (int) cnt, pcap_batch_callback, (u_char *) &batch);
+	bpf_jit_filter_free(batch.filter);
+	return r < 0 ? r : batch.count;
+  }
+
+/*
+ * Class:     com_ardikars_jxnet_Jxnet
+ * Method:    PcapDispatchSummary
+ * Signature: (Lcom/ardikars/jxnet/Pcap;Ljava/nio/ByteBuffer;II)I
+ */
+JNIEXPORT jint JNICALL Java_com_ardikars_jxnet_Jxnet_PcapDispatchSummary
+  (JNIEnv *env, jclass jcls, jobject jpcap, jobject jbuf, jint jcapacity, jint jmax_packets) {
+
+	if (CheckNotNull(env, jpcap, NULL) == NULL) return -1;
+	if (CheckNotNull(env, jbuf, NULL) == NULL) return -1;
+	if (!CheckArgument(env, (jcapacity > 0), NULL)) return -1;
+	if (!CheckArgument(env, (jmax_packets > 0), NULL)) return -1;
+
+	pcap_t *pcap = GetPcap(env, jpcap); // Exception already thrown
+
+	if(pcap == NULL) {
+		return (jint) -1;
+	}
+
+	u_char *buf = (u_char *) (*env)->GetDirectBufferAddress(env, jbuf);
+
+	if(buf == NULL) {
+		ThrowNew(env, NULL_PTR_EXCEPTION, "Unable to retrive address from ByteBuffer");
+		return (jint) -1;
+	}
+
+	jlong capacity = (*env)->GetDirectBufferCapacity(env, jbuf);
+	if (!CheckArgument(env, (capacity / PACKET_SUMMARY_RECORD_SIZE >= jcapacity),
+			"ByteBuffer is too small to hold the summary columns.")) return -1;
+
+	bpf_jit_filter_t *filter = AcquirePcapFilter(env, jpcap);
+	packet_summary_t summary;
+	packet_summary_init(&summary, buf, (int) jcapacity, pcap_datalink(pcap), filter);
+
+	int r = pcap_dispatch(pcap, (int) (jmax_packets < jcapacity ? jmax_packets : jcapacity),
+			packet_summary_callback, (u_char *) &summary);
+	bpf_jit_filter_free(filter);
+	return r < 0 ? r : summary.count;
   }
 
 /*
@@ -271,8 +437,6 @@ JNIEXPORT jobject JNICALL Java_com_ardikars_jxnet_Jxnet_PcapDumpOpen
 JNIEXPORT void JNICALL Java_com_ardikars_jxnet_Jxnet_PcapDump
   (JNIEnv *env, jclass jcls, jobject jpcap_dumper, jobject jh, jobject jsp) {
 
-  	SetPcapPktHdrIDs(env);
-
 	if (CheckNotNull(env, jpcap_dumper, "") == NULL) return;
 	if (CheckNotNull(env, jh, NULL) == NULL) return;
 	if (CheckNotNull(env, jsp, NULL) == NULL) return;
@@ -308,7 +472,20 @@ JNIEXPORT jobject JNICALL Java_com_ardikars_jxnet_Jxnet_PcapOpenOffline
   	errbuf[0] = '\0';
   	const char *fname = (*env)->GetStringUTFChars(env, jfname, 0);
 
+#if defined(WIN32)
   	pcap_t *pcap = pcap_open_offline(fname, errbuf);
+#else
+  	pcap_t *pcap = NULL;
+  	if (strcmp(fname, "-") == 0) {
+  		pcap = pcap_open_offline(fname, errbuf);
+  	} else {
+  		/* gzip and zstd savefiles are decompressed on the fly, detected by their magic */
+  		FILE *fp = compressed_file_open_read(fname, errbuf);
+  		if (fp != NULL && (pcap = pcap_fopen_offline(fp, errbuf)) == NULL) {
+  			fclose(fp);
+  		}
+  	}
+#endif
   	(*env)->ReleaseStringUTFChars(env, jfname, fname);
 
   	if(pcap == NULL) {
@@ -408,6 +585,90 @@ JNIEXPORT jint JNICALL Java_com_ardikars_jxnet_Jxnet_PcapSendPacket
   	return (jint) pcap_sendpacket(pcap, buf + (int) 0, (int) jsize);
   }
 
+/*
+ * Class:     com_ardikars_jxnet_Jxnet
+ * Method:    PcapSendBatch
+ * Signature: (Lcom/ardikars/jxnet/Pcap;Ljava/nio/ByteBuffer;[I[II)I
+ */
+JNIEXPORT jint JNICALL Java_com_ardikars_jxnet_Jxnet_PcapSendBatch
+  (JNIEnv *env, jclass jcls, jobject jpcap, jobject jbuf, jintArray joffsets, jintArray jlengths, jint jcount) {
+
+	if (CheckNotNull(env, jpcap, NULL) == NULL) return -1;
+	if (CheckNotNull(env, jbuf, NULL) == NULL) return -1;
+	if (CheckNotNull(env, joffsets, NULL) == NULL) return -1;
+	if (CheckNotNull(env, jlengths, NULL) == NULL) return -1;
+	if (!CheckArgument(env, (jcount > 0), NULL)) return -1;
+	if (!CheckArgument(env, ((*env)->GetArrayLength(env, joffsets) >= jcount
+			&& (*env)->GetArrayLength(env, jlengths) >= jcount), NULL)) return -1;
+
+	pcap_t *pcap = GetPcap(env, jpcap); // Exception already thrown
+
+	if(pcap == NULL) {
+		return (jint) -1;
+	}
+
+	u_char *buf = (u_char *) (*env)->GetDirectBufferAddress(env, jbuf);
+	jlong capacity = (*env)->GetDirectBufferCapacity(env, jbuf);
+
+	if(buf == NULL) {
+		ThrowNew(env, NULL_PTR_EXCEPTION, "Unable to retrive address from ByteBuffer");
+		return (jint) -1;
+	}
+
+	jint offsets[PCAP_SEND_BATCH_SIZE];
+	jint lengths[PCAP_SEND_BATCH_SIZE];
+#if defined(__linux__) && defined(HAVE_SENDMMSG)
+	struct mmsghdr msgs[PCAP_SEND_BATCH_SIZE];
+	struct iovec iovs[PCAP_SEND_BATCH_SIZE];
+	int fd = pcap_fileno(pcap);
+#endif
+	int sent = 0;
+
+	while (sent < jcount) {
+		int n = (jcount - sent) < PCAP_SEND_BATCH_SIZE ? (jcount - sent) : PCAP_SEND_BATCH_SIZE;
+		int i;
+		(*env)->GetIntArrayRegion(env, joffsets, sent, n, offsets);
+		(*env)->GetIntArrayRegion(env, jlengths, sent, n, lengths);
+		for (i = 0; i < n; i++) {
+			if (!CheckArgument(env, (offsets[i] >= 0 && lengths[i] > 0
+					&& (jlong) offsets[i] + lengths[i] <= capacity), "Frame is out of buffer bounds.")) {
+				return sent > 0 ? sent : -1;
+			}
+		}
+#if defined(__linux__) && defined(HAVE_SENDMMSG)
+		if (fd >= 0) {
+			memset(msgs, 0, sizeof(struct mmsghdr) * n);
+			for (i = 0; i < n; i++) {
+				iovs[i].iov_base = buf + offsets[i];
+				iovs[i].iov_len = (size_t) lengths[i];
+				msgs[i].msg_hdr.msg_iov = &iovs[i];
+				msgs[i].msg_hdr.msg_iovlen = 1;
+			}
+			int r = sendmmsg(fd, msgs, (unsigned int) n, 0);
+			if (r > 0) {
+				sent += r;
+				if (r < n) {
+					return sent;
+				}
+				continue;
+			}
+			if (errno != ENOTSOCK && errno != EBADF && errno != ENOSYS) {
+				return sent > 0 ? sent : -1;
+			}
+			/* not a socket (e.g. a non-Linux-socket capture): fall back to pcap_sendpacket */
+			fd = -1;
+		}
+#endif
+		for (i = 0; i < n; i++) {
+			if (pcap_sendpacket(pcap, buf + offsets[i], (int) lengths[i]) != 0) {
+				return sent > 0 ? sent : -1;
+			}
+			sent++;
+		}
+	}
+	return sent;
+  }
+
 /*
  * Class:     com_ardikars_jxnet_Jxnet
  * Method:    PcapNext
@@ -425,10 +686,6 @@ JNIEXPORT jobject JNICALL Java_com_ardikars_jxnet_Jxnet_PcapNext
   		return NULL;
   	}
 
-  	if(PcapPktHdrClass == NULL) {
-  		SetPcapPktHdrIDs(env);
-  	}
-
   	struct pcap_pkthdr pkt_header;
 
   	const u_char *data = pcap_next(pcap, &pkt_header);
@@ -462,14 +719,6 @@ JNIEXPORT jint JNICALL Java_com_ardikars_jxnet_Jxnet_PcapNextEx
   		return -1;
   	}
 
-  	if(PcapPktHdrClass == NULL) {
-  		SetPcapPktHdrIDs(env);
-  	}
-
-  	if(ByteBufferClass == NULL) {
-  		SetByteBufferIDs(env);
-  	}
-
   	struct pcap_pkthdr *pkt_header;
   	const u_char *data = NULL;
 
@@ -510,6 +759,7 @@ JNIEXPORT void JNICALL Java_com_ardikars_jxnet_Jxnet_PcapClose
 
   	pcap_close(pcap);
   	(*env)->SetLongField(env, jpcap, PcapAddressFID, (jlong) 0);
+  	SetPcapFilter(env, jpcap, NULL);
   }
 
 /*
@@ -608,8 +858,6 @@ JNIEXPORT jstring JNICALL Java_com_ardikars_jxnet_Jxnet_PcapLookupDev
 
 	if (CheckNotNull(env, jerrbuf, NULL) == NULL) return NULL;
 
-  	SetStringBuilderIDs(env);
-
   	char errbuf[PCAP_ERRBUF_SIZE];
   	errbuf[0] = '\0';
 
@@ -888,6 +1136,8 @@ JNIEXPORT void JNICALL Java_com_ardikars_jxnet_Jxnet_PcapFreeCode
 	}
 
 	pcap_freecode(fp);
+	bpf_jit_filter_free((bpf_jit_filter_t *) JlongToPointer((*env)->GetLongField(env, jfp, BpfProgramJitAddressFID)));
+	(*env)->SetLongField(env, jfp, BpfProgramJitAddressFID, (jlong) 0);
   }
 
 /*
@@ -934,8 +1184,6 @@ JNIEXPORT jint JNICALL Java_com_ardikars_jxnet_Jxnet_PcapStats
 	if (CheckNotNull(env, jpcap, NULL) == NULL) return -1;
 	if (CheckNotNull(env, jpcap_stat, NULL) == NULL) return -1;
 
-	SetPcapStatIDs(env);
-
 	struct pcap_stat stats;
 	memset(&stats, 0, sizeof(struct pcap_stat));
 
@@ -977,8 +1225,6 @@ JNIEXPORT jint JNICALL Java_com_ardikars_jxnet_Jxnet_PcapLookupNet
 
 	SetStringBuilder(env, jerrbuf, errbuf);
 
-	SetInet4AddressIDs(env);
-
 	jbyteArray netp_jarr = (jbyteArray) (*env)->GetObjectField(env, jnetp, Inet4AddressAddressFID);
 	(*env)->SetByteArrayRegion(env, netp_jarr, 0, 4, (void *) &netp);
 	//jbyte *netp_arr = (*env)->GetByteArrayElements(env, netp_jarr, 0);
@@ -1190,7 +1436,6 @@ JNIEXPORT jint JNICALL Java_com_ardikars_jxnet_Jxnet_PcapSetDirection
 	if (CheckNotNull(env, jpcap, NULL) == NULL) return -1;
 	if (CheckNotNull(env, jdirection, NULL) == NULL) return -1;
 
-	SetPcapDirectionIDs(env);
 	jstring direction = (jstring) (*env)->CallObjectMethod(env, jdirection, PcapDirectionNameMID);
 	const char *enumName = (*env)->GetStringUTFChars(env, direction, 0);
 
@@ -1212,4 +1457,226 @@ JNIEXPORT jint JNICALL Java_com_ardikars_jxnet_Jxnet_PcapSetDirection
 #endif
 	return -1;
   }
-  
+
+/*
+ * Class:     com_ardikars_jxnet_Jxnet
+ * Method:    PcapSetFanout
+ * Signature: (Lcom/ardikars/jxnet/Pcap;II)I
+ */
+JNIEXPORT jint JNICALL Java_com_ardikars_jxnet_Jxnet_PcapSetFanout
+  (JNIEnv *env, jclass jclazz, jobject jpcap, jint jgroup_id, jint jmode) {
+
+#if !defined(__linux__) || !defined(PACKET_FANOUT)
+	ThrowNew(env, NOT_SUPPORTED_PLATFORM_EXCEPTION, NULL);
+	return -1;
+#else
+
+	if (CheckNotNull(env, jpcap, NULL) == NULL) return -1;
+	if (!CheckArgument(env, (jgroup_id >= 0 && jgroup_id <= 0xffff), NULL)) return -1;
+	if (!CheckArgument(env, (jmode >= PACKET_FANOUT_HASH && jmode <= PACKET_FANOUT_QM), NULL)) return -1;
+
+	pcap_t *pcap = GetPcap(env, jpcap); // Exception already thrown
+
+	if (pcap == NULL) {
+		return -1;
+	}
+
+	int fd = pcap_fileno(pcap);
+
+	if (fd < 0) {
+		return -1;
+	}
+
+	int fanout = (int) (jgroup_id | (jmode << 16));
+	return setsockopt(fd, SOL_PACKET, PACKET_FANOUT, &fanout, sizeof(fanout));
+#endif
+	return -1;
+  }
+
+/*
+ * Class:     com_ardikars_jxnet_Jxnet
+ * Method:    PcapSetJitFilter
+ * Signature: (Lcom/ardikars/jxnet/Pcap;Lcom/ardikars/jxnet/BpfProgram;)I
+ */
+JNIEXPORT jint JNICALL Java_com_ardikars_jxnet_Jxnet_PcapSetJitFilter
+  (JNIEnv *env, jclass jcls, jobject jpcap, jobject jfp) {
+
+	if (CheckNotNull(env, jpcap, NULL) == NULL) return -1;
+
+	pcap_t *pcap = GetPcap(env, jpcap); // Exception already thrown
+
+	if (pcap == NULL) {
+		return -1;
+	}
+
+	bpf_jit_filter_t *filter = NULL;
+
+	if (jfp != NULL) {
+		struct bpf_program *fp = GetBpfProgram(env, jfp); // Exception already thrown
+		if (fp == NULL) {
+			return -1;
+		}
+		if ((filter = bpf_jit_filter_new(fp, 1)) == NULL) {
+			ThrowNew(env, ILLEGAL_STATE_EXCEPTION, "BpfProgram is not compiled.");
+			return -1;
+		}
+	}
+
+	SetPcapFilter(env, jpcap, filter);
+	return 0;
+  }
+
+/*
+ * Class:     com_ardikars_jxnet_Jxnet
+ * Method:    PcapGetTStampPrecision
+ * Signature: (Lcom/ardikars/jxnet/Pcap;)I
+ */
+JNIEXPORT jint JNICALL Java_com_ardikars_jxnet_Jxnet_PcapGetTStampPrecision
+  (JNIEnv *env, jclass jcls, jobject jpcap) {
+
+	if (CheckNotNull(env, jpcap, NULL) == NULL) return -1;
+
+	pcap_t *pcap = GetPcap(env, jpcap); // Exception already thrown
+
+	if (pcap == NULL) {
+		return (jint) -1;
+	}
+
+#ifdef PCAP_TSTAMP_PRECISION_NANO
+	return (jint) pcap_get_tstamp_precision(pcap);
+#else
+	return (jint) 0;
+#endif
+  }
+
+/*
+ * Class:     com_ardikars_jxnet_Jxnet
+ * Method:    PcapDumpOpenCompressed
+ * Signature: (Lcom/ardikars/jxnet/Pcap;Ljava/lang/String;II)Lcom/ardikars/jxnet/PcapDumper;
+ */
+JNIEXPORT jobject JNICALL Java_com_ardikars_jxnet_Jxnet_PcapDumpOpenCompressed
+  (JNIEnv *env, jclass jcls, jobject jpcap, jstring jfname, jint jcompression, jint jlevel) {
+
+	if (CheckNotNull(env, jpcap, NULL) == NULL) return NULL;
+	if (CheckNotNull(env, jfname, NULL) == NULL) return NULL;
+
+	pcap_t *pcap = GetPcap(env, jpcap); // Exception already thrown
+
+	if (pcap == NULL) {
+		return NULL;
+	}
+
+	char errbuf[PCAP_ERRBUF_SIZE];
+	errbuf[0] = '\0';
+	const char *fname = (*env)->GetStringUTFChars(env, jfname, 0);
+	FILE *fp = compressed_file_open_write(fname, (int) jcompression, (int) jlevel, errbuf);
+	(*env)->ReleaseStringUTFChars(env, jfname, fname);
+
+	if (fp == NULL) {
+		ThrowNew(env, PCAP_DUMPER_CLOSE_EXCEPTION, errbuf);
+		return NULL;
+	}
+
+	pcap_dumper_t *pcap_dumper = pcap_dump_fopen(pcap, fp);
+
+	if (pcap_dumper == NULL) {
+		fclose(fp);
+		ThrowNew(env, PCAP_DUMPER_CLOSE_EXCEPTION, pcap_geterr(pcap));
+		return NULL;
+	}
+	return SetPcapDumper(env, pcap_dumper);
+  }
+
+/*
+ * Check that count records of a packed batch fit in length bytes and write them with a single fwrite(),
+ * the batch record layout being the savefile record layout.
+ */
+static jint pcap_batch_dump(pcap_dumper_t *pcap_dumper, const u_char *buf, jlong length, jint count) {
+	jlong offset = 0;
+	jint i;
+	for (i = 0; i < count; i++) {
+		if (offset + (jlong) sizeof(pcap_batch_pkthdr_t) > length) {
+			break;
+		}
+		pcap_batch_pkthdr_t hdr;
+		memcpy(&hdr, buf + offset, sizeof(pcap_batch_pkthdr_t));
+		offset += sizeof(pcap_batch_pkthdr_t) + (jlong) hdr.caplen;
+		if (offset > length) {
+			break;
+		}
+	}
+	if (i < count) {
+		return -2;
+	}
+	if (offset > 0 && fwrite(buf, 1, (size_t) offset, pcap_dump_file(pcap_dumper)) != (size_t) offset) {
+		return -1;
+	}
+	return count;
+}
+
+/*
+ * Class:     com_ardikars_jxnet_Jxnet
+ * Method:    PcapDumpBatch
+ * Signature: (Lcom/ardikars/jxnet/PcapDumper;Ljava/nio/ByteBuffer;I)I
+ */
+JNIEXPORT jint JNICALL Java_com_ardikars_jxnet_Jxnet_PcapDumpBatch__Lcom_ardikars_jxnet_PcapDumper_2Ljava_nio_ByteBuffer_2I
+  (JNIEnv *env, jclass jcls, jobject jpcap_dumper, jobject jbuf, jint jcount) {
+
+	if (CheckNotNull(env, jpcap_dumper, NULL) == NULL) return -1;
+	if (CheckNotNull(env, jbuf, NULL) == NULL) return -1;
+	if (!CheckArgument(env, (jcount >= 0), NULL)) return -1;
+
+	pcap_dumper_t *pcap_dumper = GetPcapDumper(env, jpcap_dumper);
+	if (pcap_dumper == NULL) {
+		ThrowNew(env, PCAP_DUMPER_CLOSE_EXCEPTION, NULL);
+		return -1;
+	}
+
+	u_char *buf = (u_char *) (*env)->GetDirectBufferAddress(env, jbuf);
+
+	if (buf == NULL) {
+		ThrowNew(env, NULL_PTR_EXCEPTION, "Unable to retrive address from ByteBuffer");
+		return -1;
+	}
+
+	jint r = pcap_batch_dump(pcap_dumper, buf, (*env)->GetDirectBufferCapacity(env, jbuf), jcount);
+	if (r == -2) {
+		ThrowNew(env, ILLEGAL_ARGUMENT_EXCEPTION, "Packet batch is truncated.");
+		return -1;
+	}
+	return r;
+  }
+
+/*
+ * Class:     com_ardikars_jxnet_Jxnet
+ * Method:    PcapDumpBatch
+ * Signature: (Lcom/ardikars/jxnet/PcapDumper;[BI)I
+ */
+JNIEXPORT jint JNICALL Java_com_ardikars_jxnet_Jxnet_PcapDumpBatch__Lcom_ardikars_jxnet_PcapDumper_2_3BI
+  (JNIEnv *env, jclass jcls, jobject jpcap_dumper, jbyteArray jbuf, jint jcount) {
+
+	if (CheckNotNull(env, jpcap_dumper, NULL) == NULL) return -1;
+	if (CheckNotNull(env, jbuf, NULL) == NULL) return -1;
+	if (!CheckArgument(env, (jcount >= 0), NULL)) return -1;
+
+	pcap_dumper_t *pcap_dumper = GetPcapDumper(env, jpcap_dumper);
+	if (pcap_dumper == NULL) {
+		ThrowNew(env, PCAP_DUMPER_CLOSE_EXCEPTION, NULL);
+		return -1;
+	}
+
+	jlong length = (jlong) (*env)->GetArrayLength(env, jbuf);
+	u_char *buf = (u_char *) (*env)->GetPrimitiveArrayCritical(env, jbuf, NULL);
+
+	if (buf == NULL) {
+		return -1;
+	}
+
+	jint r = pcap_batch_dump(pcap_dumper, buf, length, jcount);
+	(*env)->ReleasePrimitiveArrayCritical(env, jbuf, buf, JNI_ABORT);
+	if (r == -2) {
+		ThrowNew(env, ILLEGAL_ARGUMENT_EXCEPTION, "Packet batch is truncated.");
+		return -1;
+	}
+	return r;
+  }
@@ -89,7 +89,6 @@ JNIEXPORT jobject JNICALL Java_com_ardikars_jxnet_MacAddress_fromNicName
 		free(pAdapterInfo);
 
 	(*env)->ReleaseStringUTFChars(env, jnic_name, buf);
-        SetMacAddressIDs(env);
         jobject obj = (*env)->CallStaticObjectMethod(env, MacAddressClass,
                         MacAddressValueOfMID, hw_addr);
         return obj;
@@ -117,7 +116,6 @@ JNIEXPORT jobject JNICALL Java_com_ardikars_jxnet_MacAddress_fromNicName
 	close(sd);
 
         (*env)->ReleaseStringUTFChars(env, jnic_name, buf);
-        SetMacAddressIDs(env);
         jobject obj = (*env)->CallStaticObjectMethod(env, MacAddressClass,
                         MacAddressValueOfMID, hw_addr);
         return obj;
@@ -155,7 +153,6 @@ JNIEXPORT jobject JNICALL Java_com_ardikars_jxnet_MacAddress_fromNicName
 	(*env)->SetByteArrayRegion(env, hw_addr, 0, 6, (jbyte *) ptr);
 
 	(*env)->ReleaseStringUTFChars(env, jnic_name, buf);
-        SetMacAddressIDs(env);
         jobject obj = (*env)->CallStaticObjectMethod(env, MacAddressClass,
                         MacAddressValueOfMID, hw_addr);
         return obj;
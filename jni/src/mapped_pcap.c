@@ -0,0 +1,195 @@
+/**
+ * Copyright (C) 2017  Ardika Rommy Sanjaya
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <jni.h>
+#include <pcap.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../include/jxnet/com_ardikars_jxnet_MappedPcap.h"
+#include "ids.h"
+#include "utils.h"
+#include "preconditions.h"
+
+#if !defined(WIN32)
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/*
+ * A whole savefile mapped read-only. The descriptor is closed once the mapping exists;
+ * Java walks the records through windows of the mapping.
+ */
+typedef struct mapped_pcap {
+	u_char *map;
+	size_t map_len;
+} mapped_pcap_t;
+
+static mapped_pcap_t *GetMappedPcap(JNIEnv *env, jlong address) {
+	mapped_pcap_t *file = (mapped_pcap_t *) JlongToPointer(address);
+	if (file == NULL) {
+		ThrowNew(env, ILLEGAL_STATE_EXCEPTION, "MappedPcap is closed.");
+	}
+	return file;
+}
+
+/* classic savefile magic, microsecond and nanosecond, both byte orders */
+static int mapped_pcap_magic(const u_char *p) {
+	return (p[0] == 0xd4 && p[1] == 0xc3 && p[2] == 0xb2 && p[3] == 0xa1)
+			|| (p[0] == 0xa1 && p[1] == 0xb2 && p[2] == 0xc3 && p[3] == 0xd4)
+			|| (p[0] == 0x4d && p[1] == 0x3c && p[2] == 0xb2 && p[3] == 0xa1)
+			|| (p[0] == 0xa1 && p[1] == 0xb2 && p[2] == 0x3c && p[3] == 0x4d);
+}
+
+#endif
+
+/*
+ * Class:     com_ardikars_jxnet_MappedPcap
+ * Method:    openFile
+ * Signature: (Ljava/lang/String;Ljava/lang/StringBuilder;)J
+ */
+JNIEXPORT jlong JNICALL Java_com_ardikars_jxnet_MappedPcap_openFile
+  (JNIEnv *env, jclass jcls, jstring jpath, jobject jerrbuf) {
+
+	if (CheckNotNull(env, jpath, NULL) == NULL) return 0;
+	if (CheckNotNull(env, jerrbuf, NULL) == NULL) return 0;
+
+#if !defined(WIN32)
+	const char *path = (*env)->GetStringUTFChars(env, jpath, 0);
+	int fd = open(path, O_RDONLY);
+	(*env)->ReleaseStringUTFChars(env, jpath, path);
+
+	if (fd < 0) {
+		SetStringBuilder(env, jerrbuf, strerror(errno));
+		return 0;
+	}
+
+	struct stat st;
+
+	if (fstat(fd, &st) < 0) {
+		SetStringBuilder(env, jerrbuf, strerror(errno));
+		close(fd);
+		return 0;
+	}
+
+	if (st.st_size < 24) {
+		SetStringBuilder(env, jerrbuf, "truncated dump file; tried to read 24 file header bytes");
+		close(fd);
+		return 0;
+	}
+
+	void *map = mmap(NULL, (size_t) st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+
+	if (map == MAP_FAILED) {
+		SetStringBuilder(env, jerrbuf, strerror(errno));
+		return 0;
+	}
+
+	if (!mapped_pcap_magic((const u_char *) map)) {
+		SetStringBuilder(env, jerrbuf, "unknown file format (only classic pcap savefiles can be mapped)");
+		munmap(map, (size_t) st.st_size);
+		return 0;
+	}
+
+#ifdef MADV_SEQUENTIAL
+	madvise(map, (size_t) st.st_size, MADV_SEQUENTIAL);
+#endif
+
+	mapped_pcap_t *file = (mapped_pcap_t *) malloc(sizeof(mapped_pcap_t));
+
+	if (file == NULL) {
+		SetStringBuilder(env, jerrbuf, "MappedPcap out of memory");
+		munmap(map, (size_t) st.st_size);
+		return 0;
+	}
+
+	file->map = (u_char *) map;
+	file->map_len = (size_t) st.st_size;
+	return PointerToJlong(file);
+#else
+	ThrowNew(env, NOT_SUPPORTED_PLATFORM_EXCEPTION, NULL);
+	return 0;
+#endif
+  }
+
+/*
+ * Class:     com_ardikars_jxnet_MappedPcap
+ * Method:    fileSize
+ * Signature: (J)J
+ */
+JNIEXPORT jlong JNICALL Java_com_ardikars_jxnet_MappedPcap_fileSize
+  (JNIEnv *env, jclass jcls, jlong jaddress) {
+
+#if !defined(WIN32)
+	mapped_pcap_t *file = GetMappedPcap(env, jaddress); // Exception already thrown
+
+	if (file == NULL) {
+		return -1;
+	}
+	return (jlong) file->map_len;
+#else
+	ThrowNew(env, NOT_SUPPORTED_PLATFORM_EXCEPTION, NULL);
+	return -1;
+#endif
+  }
+
+/*
+ * Class:     com_ardikars_jxnet_MappedPcap
+ * Method:    mapWindow
+ * Signature: (JJI)Ljava/nio/ByteBuffer;
+ */
+JNIEXPORT jobject JNICALL Java_com_ardikars_jxnet_MappedPcap_mapWindow
+  (JNIEnv *env, jclass jcls, jlong jaddress, jlong joffset, jint jlength) {
+
+#if !defined(WIN32)
+	mapped_pcap_t *file = GetMappedPcap(env, jaddress); // Exception already thrown
+
+	if (file == NULL) {
+		return NULL;
+	}
+
+	if (!CheckArgument(env, (joffset >= 0 && jlength >= 0
+			&& (size_t) joffset + (size_t) jlength <= file->map_len), "Window out of file bounds.")) return NULL;
+
+	return (*env)->NewDirectByteBuffer(env, file->map + joffset, (jlong) jlength);
+#else
+	ThrowNew(env, NOT_SUPPORTED_PLATFORM_EXCEPTION, NULL);
+	return NULL;
+#endif
+  }
+
+/*
+ * Class:     com_ardikars_jxnet_MappedPcap
+ * Method:    closeFile
+ * Signature: (J)V
+ */
+JNIEXPORT void JNICALL Java_com_ardikars_jxnet_MappedPcap_closeFile
+  (JNIEnv *env, jclass jcls, jlong jaddress) {
+
+#if !defined(WIN32)
+	mapped_pcap_t *file = (mapped_pcap_t *) JlongToPointer(jaddress);
+	if (file != NULL) {
+		munmap(file->map, file->map_len);
+		free(file);
+	}
+#else
+	ThrowNew(env, NOT_SUPPORTED_PLATFORM_EXCEPTION, NULL);
+#endif
+  }
@@ -0,0 +1,327 @@
+/**
+ * Copyright (C) 2017  Ardika Rommy Sanjaya
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <jni.h>
+#include <pcap.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../include/jxnet/com_ardikars_jxnet_PacketRing.h"
+#include "ids.h"
+#include "utils.h"
+#include "preconditions.h"
+
+#define PACKET_RING_FRAME_SIZE 2048
+
+#if defined(__linux__)
+#include <errno.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <arpa/inet.h>
+#include <net/if.h>
+#include <linux/if_ether.h>
+#include <linux/if_packet.h>
+#include <linux/filter.h>
+
+#ifdef TPACKET3_HDRLEN
+
+/*
+ * A TPACKET_V3 receive ring on its own AF_PACKET socket.
+ * Blocks are handed to Java in ring order; block status is the only state shared with the kernel.
+ */
+typedef struct packet_ring {
+	int fd;
+	u_char *map;
+	size_t map_len;
+	unsigned int block_size;
+	unsigned int block_count;
+	unsigned int current;
+} packet_ring_t;
+
+static struct tpacket_block_desc *packet_ring_block(packet_ring_t *ring, unsigned int index) {
+	return (struct tpacket_block_desc *) (ring->map + ((size_t) index * ring->block_size));
+}
+
+static packet_ring_t *GetPacketRing(JNIEnv *env, jlong address) {
+	packet_ring_t *ring = (packet_ring_t *) JlongToPointer(address);
+	if (ring == NULL) {
+		ThrowNew(env, ILLEGAL_STATE_EXCEPTION, "PacketRing is closed.");
+	}
+	return ring;
+}
+
+static void packet_ring_free(packet_ring_t *ring) {
+	if (ring->map != NULL) {
+		munmap(ring->map, ring->map_len);
+	}
+	if (ring->fd >= 0) {
+		close(ring->fd);
+	}
+	free(ring);
+}
+
+#endif
+#endif
+
+/*
+ * Class:     com_ardikars_jxnet_PacketRing
+ * Method:    openRing
+ * Signature: (Ljava/lang/String;IIIZLjava/lang/StringBuilder;)J
+ */
+JNIEXPORT jlong JNICALL Java_com_ardikars_jxnet_PacketRing_openRing
+  (JNIEnv *env, jclass jcls, jstring jsource, jint jblock_size, jint jblock_count, jint jtimeout, jboolean jpromisc, jobject jerrbuf) {
+
+	if (CheckNotNull(env, jsource, NULL) == NULL) return 0;
+	if (CheckNotNull(env, jerrbuf, NULL) == NULL) return 0;
+#if defined(__linux__)
+	long page_size = sysconf(_SC_PAGESIZE);
+	if (page_size < PACKET_RING_FRAME_SIZE) {
+		page_size = PACKET_RING_FRAME_SIZE;
+	}
+#else
+	long page_size = PACKET_RING_FRAME_SIZE;
+#endif
+	/* the kernel rejects a tp_block_size that is not a multiple of the page size */
+	if (!CheckArgument(env, (jblock_size >= page_size && (jblock_size % page_size) == 0),
+			"Block size must be a multiple of the page size.")) return 0;
+	if (!CheckArgument(env, (jblock_count > 0 && ((jlong) jblock_size * jblock_count) <= 0x7fffffff),
+			"Ring size must be between 1 block and 2GB.")) return 0;
+	if (!CheckArgument(env, (jtimeout >= 0), NULL)) return 0;
+
+#if defined(__linux__) && defined(TPACKET3_HDRLEN)
+	const char *source = (*env)->GetStringUTFChars(env, jsource, 0);
+	unsigned int ifindex = if_nametoindex(source);
+	(*env)->ReleaseStringUTFChars(env, jsource, source);
+
+	if (ifindex == 0) {
+		SetStringBuilder(env, jerrbuf, strerror(errno));
+		return 0;
+	}
+
+	packet_ring_t *ring = (packet_ring_t *) calloc(1, sizeof(packet_ring_t));
+
+	if (ring == NULL) {
+		SetStringBuilder(env, jerrbuf, "PacketRing out of memory");
+		return 0;
+	}
+
+	ring->block_size = (unsigned int) jblock_size;
+	ring->block_count = (unsigned int) jblock_count;
+	ring->map_len = (size_t) jblock_size * (size_t) jblock_count;
+	/* Protocol 0 receives nothing until bind() below sets ETH_P_ALL on the interface,
+	 * so the ring never holds packets from other interfaces. */
+	ring->fd = socket(AF_PACKET, SOCK_RAW, 0);
+
+	if (ring->fd < 0) {
+		SetStringBuilder(env, jerrbuf, strerror(errno));
+		free(ring);
+		return 0;
+	}
+
+	int version = TPACKET_V3;
+	struct tpacket_req3 req;
+	memset(&req, 0, sizeof(req));
+	req.tp_block_size = ring->block_size;
+	req.tp_block_nr = ring->block_count;
+	req.tp_frame_size = PACKET_RING_FRAME_SIZE;
+	req.tp_frame_nr = (ring->block_size / PACKET_RING_FRAME_SIZE) * ring->block_count;
+	req.tp_retire_blk_tov = (unsigned int) jtimeout;
+	req.tp_feature_req_word = TP_FT_REQ_FILL_RXHASH;
+
+	struct sockaddr_ll sll;
+	memset(&sll, 0, sizeof(sll));
+	sll.sll_family = AF_PACKET;
+	sll.sll_protocol = htons(ETH_P_ALL);
+	sll.sll_ifindex = (int) ifindex;
+
+	if (setsockopt(ring->fd, SOL_PACKET, PACKET_VERSION, &version, sizeof(version)) < 0
+			|| setsockopt(ring->fd, SOL_PACKET, PACKET_RX_RING, &req, sizeof(req)) < 0) {
+		SetStringBuilder(env, jerrbuf, strerror(errno));
+		packet_ring_free(ring);
+		return 0;
+	}
+
+	void *map = mmap(NULL, ring->map_len, PROT_READ | PROT_WRITE, MAP_SHARED, ring->fd, 0);
+
+	if (map == MAP_FAILED) {
+		SetStringBuilder(env, jerrbuf, strerror(errno));
+		packet_ring_free(ring);
+		return 0;
+	}
+	ring->map = (u_char *) map;
+
+	if (bind(ring->fd, (struct sockaddr *) &sll, sizeof(sll)) < 0) {
+		SetStringBuilder(env, jerrbuf, strerror(errno));
+		packet_ring_free(ring);
+		return 0;
+	}
+
+	if (jpromisc == JNI_TRUE) {
+		struct packet_mreq mreq;
+		memset(&mreq, 0, sizeof(mreq));
+		mreq.mr_ifindex = (int) ifindex;
+		mreq.mr_type = PACKET_MR_PROMISC;
+		if (setsockopt(ring->fd, SOL_PACKET, PACKET_ADD_MEMBERSHIP, &mreq, sizeof(mreq)) < 0) {
+			SetStringBuilder(env, jerrbuf, strerror(errno));
+			packet_ring_free(ring);
+			return 0;
+		}
+	}
+
+	return PointerToJlong(ring);
+#else
+	ThrowNew(env, NOT_SUPPORTED_PLATFORM_EXCEPTION, NULL);
+	return 0;
+#endif
+  }
+
+/*
+ * Class:     com_ardikars_jxnet_PacketRing
+ * Method:    mapRing
+ * Signature: (J)Ljava/nio/ByteBuffer;
+ */
+JNIEXPORT jobject JNICALL Java_com_ardikars_jxnet_PacketRing_mapRing
+  (JNIEnv *env, jclass jcls, jlong jaddress) {
+
+#if defined(__linux__) && defined(TPACKET3_HDRLEN)
+	packet_ring_t *ring = GetPacketRing(env, jaddress); // Exception already thrown
+
+	if (ring == NULL) {
+		return NULL;
+	}
+	return (*env)->NewDirectByteBuffer(env, ring->map, (jlong) ring->map_len);
+#else
+	ThrowNew(env, NOT_SUPPORTED_PLATFORM_EXCEPTION, NULL);
+	return NULL;
+#endif
+  }
+
+/*
+ * Class:     com_ardikars_jxnet_PacketRing
+ * Method:    nextBlock
+ * Signature: (JI)I
+ */
+JNIEXPORT jint JNICALL Java_com_ardikars_jxnet_PacketRing_nextBlock
+  (JNIEnv *env, jclass jcls, jlong jaddress, jint jtimeout) {
+
+#if defined(__linux__) && defined(TPACKET3_HDRLEN)
+	packet_ring_t *ring = GetPacketRing(env, jaddress); // Exception already thrown
+
+	if (ring == NULL) {
+		return -2;
+	}
+
+	struct tpacket_block_desc *block = packet_ring_block(ring, ring->current);
+
+	if ((__atomic_load_n(&block->hdr.bh1.block_status, __ATOMIC_ACQUIRE) & TP_STATUS_USER) != 0) {
+		return (jint) ring->current;
+	}
+
+	struct pollfd pfd;
+	pfd.fd = ring->fd;
+	pfd.events = POLLIN | POLLERR;
+	pfd.revents = 0;
+
+	if (poll(&pfd, 1, (int) jtimeout) < 0) {
+		return (errno == EINTR) ? -1 : -2;
+	}
+
+	if ((__atomic_load_n(&block->hdr.bh1.block_status, __ATOMIC_ACQUIRE) & TP_STATUS_USER) != 0) {
+		return (jint) ring->current;
+	}
+	return -1;
+#else
+	ThrowNew(env, NOT_SUPPORTED_PLATFORM_EXCEPTION, NULL);
+	return -2;
+#endif
+  }
+
+/*
+ * Class:     com_ardikars_jxnet_PacketRing
+ * Method:    releaseBlock
+ * Signature: (J)V
+ */
+JNIEXPORT void JNICALL Java_com_ardikars_jxnet_PacketRing_releaseBlock
+  (JNIEnv *env, jclass jcls, jlong jaddress) {
+
+#if defined(__linux__) && defined(TPACKET3_HDRLEN)
+	packet_ring_t *ring = GetPacketRing(env, jaddress); // Exception already thrown
+
+	if (ring == NULL) {
+		return;
+	}
+
+	struct tpacket_block_desc *block = packet_ring_block(ring, ring->current);
+	__atomic_store_n(&block->hdr.bh1.block_status, TP_STATUS_KERNEL, __ATOMIC_RELEASE);
+	ring->current = (ring->current + 1) % ring->block_count;
+#else
+	ThrowNew(env, NOT_SUPPORTED_PLATFORM_EXCEPTION, NULL);
+#endif
+  }
+
+/*
+ * Class:     com_ardikars_jxnet_PacketRing
+ * Method:    setFilter
+ * Signature: (JLcom/ardikars/jxnet/BpfProgram;)I
+ */
+JNIEXPORT jint JNICALL Java_com_ardikars_jxnet_PacketRing_setFilter
+  (JNIEnv *env, jclass jcls, jlong jaddress, jobject jfp) {
+
+	if (CheckNotNull(env, jfp, NULL) == NULL) return -1;
+
+#if defined(__linux__) && defined(TPACKET3_HDRLEN)
+	packet_ring_t *ring = GetPacketRing(env, jaddress); // Exception already thrown
+
+	if (ring == NULL) {
+		return -1;
+	}
+
+	struct bpf_program *fp = GetBpfProgram(env, jfp); // Exception already thrown
+
+	if (fp == NULL) {
+		return -1;
+	}
+
+	struct sock_fprog prog;
+	prog.len = (unsigned short) fp->bf_len;
+	prog.filter = (struct sock_filter *) fp->bf_insns;
+	return (jint) setsockopt(ring->fd, SOL_SOCKET, SO_ATTACH_FILTER, &prog, sizeof(prog));
+#else
+	ThrowNew(env, NOT_SUPPORTED_PLATFORM_EXCEPTION, NULL);
+	return -1;
+#endif
+  }
+
+/*
+ * Class:     com_ardikars_jxnet_PacketRing
+ * Method:    closeRing
+ * Signature: (J)V
+ */
+JNIEXPORT void JNICALL Java_com_ardikars_jxnet_PacketRing_closeRing
+  (JNIEnv *env, jclass jcls, jlong jaddress) {
+
+#if defined(__linux__) && defined(TPACKET3_HDRLEN)
+	packet_ring_t *ring = (packet_ring_t *) JlongToPointer(jaddress);
+	if (ring != NULL) {
+		packet_ring_free(ring);
+	}
+#else
+	ThrowNew(env, NOT_SUPPORTED_PLATFORM_EXCEPTION, NULL);
+#endif
+  }
@@ -0,0 +1,237 @@
+/**
+ * Copyright (C) 2017  Ardika Rommy Sanjaya
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <pcap.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "packet_summary.h"
+
+#define COLUMN(summary, column, type) ((type *) (summary)->columns[PACKET_SUMMARY_ ## column])
+
+#define ETHERTYPE_IPV4 0x0800
+#define ETHERTYPE_IPV6 0x86dd
+#define ETHERTYPE_VLAN 0x8100
+#define ETHERTYPE_QINQ 0x88a8
+#define ETHERTYPE_QINQ_OLD 0x9100
+
+#define IP_PROTO_ICMP 1
+#define IP_PROTO_TCP 6
+#define IP_PROTO_UDP 17
+#define IP_PROTO_ICMPV6 58
+
+/* extension headers walked before giving up on an IPv6 packet */
+#define IPV6_MAX_EXTENSION_HEADERS 8
+
+static const int packet_summary_widths[PACKET_SUMMARY_COLUMNS] = {
+	16, 16, 4, 4, 4, 4, 4, 4, 4, 2, 2, 2, 2, 2, 2, 1, 1
+};
+
+static uint16_t get16(const u_char *p) {
+	return (uint16_t) (p[0] << 8 | p[1]);
+}
+
+static uint32_t get32(const u_char *p) {
+	return (uint32_t) p[0] << 24 | (uint32_t) p[1] << 16 | (uint32_t) p[2] << 8 | (uint32_t) p[3];
+}
+
+void packet_summary_init(packet_summary_t *summary, u_char *buf, int capacity, int linktype,
+		const bpf_jit_filter_t *filter) {
+	size_t offset = 0;
+	int i;
+	for (i = 0; i < PACKET_SUMMARY_COLUMNS; i++) {
+		summary->columns[i] = buf + offset;
+		offset += (size_t) capacity * packet_summary_widths[i];
+	}
+	summary->linktype = linktype;
+	summary->capacity = capacity;
+	summary->count = 0;
+	summary->filter = filter;
+}
+
+void packet_summary_callback(u_char *user, const struct pcap_pkthdr *pkt_header, const u_char *pkt_data) {
+	packet_summary_t *summary = (packet_summary_t *) user;
+	if (summary->count >= summary->capacity) {
+		return;
+	}
+	if (summary->filter != NULL
+			&& bpf_jit_filter_run(summary->filter, pkt_data, pkt_header->len, pkt_header->caplen) == 0) {
+		return;
+	}
+	const int row = summary->count++;
+	const u_char *p = pkt_data;
+	const uint32_t caplen = pkt_header->caplen;
+	uint32_t off = 0;
+	uint16_t ether_type = 0;
+	uint16_t vlan = 0xffff;
+	uint8_t version = 0;
+	uint8_t protocol = 0;
+	uint32_t src_ip = 0;
+	uint32_t dst_ip = 0;
+	uint16_t src_port = 0;
+	uint16_t dst_port = 0;
+	uint16_t tcp_flags = 0;
+	int32_t ip_payload_len = 0; // bytes after the last parsed IP header, per the IP lengths
+	uint32_t payload_off = 0;
+	int32_t payload_len = 0;
+	u_char *src_ip6 = COLUMN(summary, SRC_IP6, u_char) + (size_t) row * 16;
+	u_char *dst_ip6 = COLUMN(summary, DST_IP6, u_char) + (size_t) row * 16;
+
+	memset(src_ip6, 0, 16);
+	memset(dst_ip6, 0, 16);
+
+	switch (summary->linktype) {
+		case DLT_EN10MB:
+			if (caplen < 14) goto done;
+			ether_type = get16(p + 12);
+			off = 14;
+			while ((ether_type == ETHERTYPE_VLAN || ether_type == ETHERTYPE_QINQ || ether_type == ETHERTYPE_QINQ_OLD)
+					&& off + 4 <= caplen) {
+				if (vlan == 0xffff) {
+					vlan = get16(p + off) & 0x0fff; // outer tag
+				}
+				ether_type = get16(p + off + 2);
+				off += 4;
+			}
+			break;
+		case DLT_LINUX_SLL:
+			if (caplen < 16) goto done;
+			ether_type = get16(p + 14);
+			off = 16;
+			break;
+		case DLT_RAW:
+			if (caplen < 1) goto done;
+			ether_type = (p[0] >> 4) == 6 ? ETHERTYPE_IPV6 : ETHERTYPE_IPV4;
+			break;
+#ifdef DLT_IPV4
+		case DLT_IPV4:
+			ether_type = ETHERTYPE_IPV4;
+			break;
+#endif
+#ifdef DLT_IPV6
+		case DLT_IPV6:
+			ether_type = ETHERTYPE_IPV6;
+			break;
+#endif
+		default:
+			goto done;
+	}
+
+	if (ether_type == ETHERTYPE_IPV4) {
+		if (off + 20 > caplen || (p[off] >> 4) != 4) goto done;
+		uint32_t ihl = (p[off] & 0x0f) * 4;
+		if (ihl < 20) goto done;
+		version = 4;
+		protocol = p[off + 9];
+		src_ip = get32(p + off + 12);
+		dst_ip = get32(p + off + 16);
+		ip_payload_len = (int32_t) get16(p + off + 2) - (int32_t) ihl;
+		if ((get16(p + off + 6) & 0x1fff) != 0) {
+			payload_off = off + ihl; // not the first fragment, no transport header
+			goto payload;
+		}
+		off += ihl;
+	} else if (ether_type == ETHERTYPE_IPV6) {
+		if (off + 40 > caplen || (p[off] >> 4) != 6) goto done;
+		version = 6;
+		memcpy(src_ip6, p + off + 8, 16);
+		memcpy(dst_ip6, p + off + 24, 16);
+		ip_payload_len = get16(p + off + 4);
+		protocol = p[off + 6];
+		off += 40;
+		int i;
+		for (i = 0; i < IPV6_MAX_EXTENSION_HEADERS; i++) {
+			uint32_t length;
+			if (protocol == 0 || protocol == 43 || protocol == 60) { // hop-by-hop, routing, destination options
+				if (off + 8 > caplen) break;
+				length = (p[off + 1] + 1) * 8;
+			} else if (protocol == 44) { // fragment
+				if (off + 8 > caplen) break;
+				length = 8;
+				if ((get16(p + off + 2) & 0xfff8) != 0) {
+					protocol = p[off];
+					payload_off = off + length; // not the first fragment, no transport header
+					ip_payload_len -= length;
+					goto payload;
+				}
+			} else {
+				break;
+			}
+			protocol = p[off];
+			off += length;
+			ip_payload_len -= length;
+		}
+	} else {
+		goto done;
+	}
+
+	switch (protocol) {
+		case IP_PROTO_TCP: {
+			if (off + 20 > caplen) goto done;
+			uint32_t doff = (p[off + 12] >> 4) * 4;
+			src_port = get16(p + off);
+			dst_port = get16(p + off + 2);
+			tcp_flags = get16(p + off + 12) & 0x01ff;
+			if (doff < 20) goto done; // malformed data offset, no payload columns
+			payload_off = off + doff;
+			ip_payload_len -= (int32_t) doff;
+			break;
+		}
+		case IP_PROTO_UDP:
+			if (off + 8 > caplen) goto done;
+			src_port = get16(p + off);
+			dst_port = get16(p + off + 2);
+			payload_off = off + 8;
+			ip_payload_len -= 8;
+			break;
+		case IP_PROTO_ICMP:
+		case IP_PROTO_ICMPV6:
+			if (off + 8 > caplen) goto done;
+			src_port = p[off]; // type
+			dst_port = p[off + 1]; // code
+			payload_off = off + 8;
+			ip_payload_len -= 8;
+			break;
+		default:
+			payload_off = off;
+			break;
+	}
+
+payload:
+	if (ip_payload_len >= 0) {
+		payload_len = ip_payload_len;
+	} else {
+		payload_off = 0;
+	}
+
+done:
+	COLUMN(summary, TV_SEC, int32_t)[row] = (int32_t) pkt_header->ts.tv_sec;
+	COLUMN(summary, TV_USEC, int32_t)[row] = (int32_t) pkt_header->ts.tv_usec;
+	COLUMN(summary, CAPLEN, int32_t)[row] = (int32_t) caplen;
+	COLUMN(summary, LEN, int32_t)[row] = (int32_t) pkt_header->len;
+	COLUMN(summary, SRC_IP, uint32_t)[row] = src_ip;
+	COLUMN(summary, DST_IP, uint32_t)[row] = dst_ip;
+	COLUMN(summary, PAYLOAD_LEN, int32_t)[row] = payload_len;
+	COLUMN(summary, ETHER_TYPE, uint16_t)[row] = ether_type;
+	COLUMN(summary, VLAN, uint16_t)[row] = vlan;
+	COLUMN(summary, SRC_PORT, uint16_t)[row] = src_port;
+	COLUMN(summary, DST_PORT, uint16_t)[row] = dst_port;
+	COLUMN(summary, TCP_FLAGS, uint16_t)[row] = tcp_flags;
+	COLUMN(summary, PAYLOAD_OFF, uint16_t)[row] = (uint16_t) payload_off;
+	COLUMN(summary, IP_VERSION, uint8_t)[row] = version;
+	COLUMN(summary, PROTOCOL, uint8_t)[row] = protocol;
+}
@@ -0,0 +1,75 @@
+/**
+ * Copyright (C) 2017  Ardika Rommy Sanjaya
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _Included_packet_summary
+#define _Included_packet_summary
+
+#include <pcap.h>
+#include <stdint.h>
+
+#include "bpf_jit.h"
+
+/*
+ * Column layout of a PcapPktSummary buffer holding up to capacity packets.
+ * Columns are stored one after another, widest first, so every column is
+ * naturally aligned. Keep in sync with PcapPktSummary.java.
+ */
+#define PACKET_SUMMARY_SRC_IP6     0  /* 16 bytes */
+#define PACKET_SUMMARY_DST_IP6     1  /* 16 bytes */
+#define PACKET_SUMMARY_TV_SEC      2  /* int */
+#define PACKET_SUMMARY_TV_USEC     3  /* int */
+#define PACKET_SUMMARY_CAPLEN      4  /* int */
+#define PACKET_SUMMARY_LEN         5  /* int */
+#define PACKET_SUMMARY_SRC_IP      6  /* int */
+#define PACKET_SUMMARY_DST_IP      7  /* int */
+#define PACKET_SUMMARY_PAYLOAD_LEN 8  /* int */
+#define PACKET_SUMMARY_ETHER_TYPE  9  /* short */
+#define PACKET_SUMMARY_VLAN        10 /* short */
+#define PACKET_SUMMARY_SRC_PORT    11 /* short */
+#define PACKET_SUMMARY_DST_PORT    12 /* short */
+#define PACKET_SUMMARY_TCP_FLAGS   13 /* short */
+#define PACKET_SUMMARY_PAYLOAD_OFF 14 /* short */
+#define PACKET_SUMMARY_IP_VERSION  15 /* byte */
+#define PACKET_SUMMARY_PROTOCOL    16 /* byte */
+#define PACKET_SUMMARY_COLUMNS     17
+
+/* bytes per packet, over all columns */
+#define PACKET_SUMMARY_RECORD_SIZE (2 * 16 + 7 * 4 + 6 * 2 + 2 * 1)
+
+typedef struct packet_summary_t {
+	u_char *columns[PACKET_SUMMARY_COLUMNS];
+	int linktype;
+	int capacity;
+	int count;
+	const bpf_jit_filter_t *filter;
+} packet_summary_t;
+
+/*
+ * Point the columns of summary into buf, which holds at least
+ * capacity * PACKET_SUMMARY_RECORD_SIZE bytes.
+ */
+void packet_summary_init(packet_summary_t *summary, u_char *buf, int capacity, int linktype,
+		const bpf_jit_filter_t *filter);
+
+/*
+ * Parse the link, network and transport headers of a packet into row
+ * summary->count of the columns, pcap_handler compatible. Packets rejected
+ * by the Jxnet-side filter are skipped.
+ */
+void packet_summary_callback(u_char *user, const struct pcap_pkthdr *pkt_header, const u_char *pkt_data);
+
+#endif
@@ -22,6 +22,7 @@
 #include "utils.h"
 
 #include <sys/time.h>
+#include <string.h>
 
 #if defined(WIN32) || defined(__CYGWIN__)
 #include <winsock2.h>
@@ -66,7 +67,6 @@ void SetStringBuilder(JNIEnv *env, jobject obj, const char *str) {
 	if(obj == NULL) {
 		ThrowNew(env, NULL_PTR_EXCEPTION, NULL);
 	}
-	SetStringBuilderIDs(env);
 	(*env)->CallVoidMethod(env, obj, StringBuilderSetLengthMID, (jint) 0);
 	(*env)->CallObjectMethod(env, obj, StringBuilderAppendMID, (*env)->NewStringUTF(env, str));
 }
@@ -97,7 +97,7 @@ jbyteArray NewByteAddr(JNIEnv *env, struct sockaddr *addr) {
 }
 
 jobject NewSockAddr(JNIEnv *env, struct sockaddr *addr) {
-	jobject sockaddr = NewObject(env, SockAddrClass, "<init>", "()V");
+	jobject sockaddr = (*env)->NewObject(env, SockAddrClass, SockAddrInitMID);
 	if(addr == NULL) {
 		return sockaddr;
 	}
@@ -107,8 +107,7 @@ jobject NewSockAddr(JNIEnv *env, struct sockaddr *addr) {
 }
 
 jobject SetPcap(JNIEnv *env, pcap_t *pcap) {
-	SetPcapIDs(env);
-	jobject obj = NewObject(env, PcapClass, "<init>", "()V");
+	jobject obj = (*env)->NewObject(env, PcapClass, PcapInitMID);
   	(*env)->SetLongField(env, obj, PcapAddressFID, PointerToJlong(pcap));
   	return obj;
 }
@@ -118,7 +117,6 @@ pcap_t *GetPcap(JNIEnv *env, jobject jpcap) {
 		ThrowNew(env, NULL_PTR_EXCEPTION, NULL);
 		return NULL;
 	}
-	SetPcapIDs(env);
 	jlong pcap = 0;
 	/*if ((pcap = (*env)->GetLongField(env, jpcap, PcapAddressFID)) == 0) {
 		ThrowNew(env, PCAP_CLOSE_EXCEPTION, NULL);
@@ -130,7 +128,6 @@ pcap_t *GetPcap(JNIEnv *env, jobject jpcap) {
 }
 
 jobject SetFile(JNIEnv *env, FILE *file) {
-	SetFileIDs(env);
 	jobject obj = NewObject(env, FileClass, "<init>", "()V");
   	(*env)->SetLongField(env, obj, FileAddressFID, PointerToJlong(file));
   	return obj;
@@ -141,7 +138,6 @@ FILE *GetFile(JNIEnv *env, jobject jf) {
 		ThrowNew(env, NULL_PTR_EXCEPTION, NULL);
 		return NULL;
 	}
-	SetFileIDs(env);
 	jlong file = 0;
 	/*if ((file = (*env)->GetLongField(env, jf, FileAddressFID)) == 0) {
 		ThrowNew(env, FILE_CLOSE_EXCEPTION, NULL);
@@ -153,8 +149,7 @@ FILE *GetFile(JNIEnv *env, jobject jf) {
 }
 
 jobject SetPcapDumper(JNIEnv *env, pcap_dumper_t *pcap_dumper) {
-	SetPcapDumperIDs(env);
-	jobject obj = NewObject(env, PcapDumperClass, "<init>", "()V");
+	jobject obj = (*env)->NewObject(env, PcapDumperClass, PcapDumperInitMID);
   	(*env)->SetLongField(env, obj, PcapDumperAddressFID, PointerToJlong(pcap_dumper));
   	return obj;
 }
@@ -164,7 +159,6 @@ pcap_dumper_t *GetPcapDumper(JNIEnv *env, jobject jpcap_dumper) {
 		ThrowNew(env, NULL_PTR_EXCEPTION, NULL);
 		return NULL;
 	}
-	SetPcapDumperIDs(env);
 	jlong pcap_dumper = 0;
 	/*if ((pcap_dumper = (*env)->GetLongField(env, jpcap_dumper, PcapDumperAddressFID)) == 0) {
 		ThrowNew(env, PCAP_DUMPER_CLOSE_EXCEPTION, NULL);
@@ -176,7 +170,6 @@ pcap_dumper_t *GetPcapDumper(JNIEnv *env, jobject jpcap_dumper) {
 }
 
 jobject SetBpfProgram(JNIEnv *env, jobject obj, struct bpf_program *fp) {
-	SetBpfProgramIDs(env);
   	(*env)->SetLongField(env, obj, BpfProgramAddressFID, PointerToJlong(fp));
   	return obj;
 }
@@ -186,7 +179,6 @@ struct bpf_program *GetBpfProgram(JNIEnv *env, jobject jbpf_program) {
 		ThrowNew(env, NULL_PTR_EXCEPTION, NULL);
 		return NULL;
 	}
-	SetBpfProgramIDs(env);
 	jlong bpf_program = 0;
 	/*if ((bpf_program = (*env)->GetLongField(env, jbpf_program, BpfProgramAddressFID)) == 0) {
 		ThrowNew(env, BPF_PROGRAM_CLOSE_EXCEPTION, NULL);
@@ -197,20 +189,118 @@ struct bpf_program *GetBpfProgram(JNIEnv *env, jobject jbpf_program) {
 	return JlongToPointer(bpf_program);
 }
 
+bpf_jit_filter_t *GetPcapFilter(JNIEnv *env, jobject jpcap) {
+	return (bpf_jit_filter_t *) JlongToPointer((*env)->GetLongField(env, jpcap, PcapFilterAddressFID));
+}
+
+/*
+ * Take a reference to the filter of a Pcap for the length of a loop, released with
+ * bpf_jit_filter_free(). The Pcap monitor orders it with SetPcapFilter().
+ */
+bpf_jit_filter_t *AcquirePcapFilter(JNIEnv *env, jobject jpcap) {
+	if ((*env)->MonitorEnter(env, jpcap) != JNI_OK) {
+		return NULL;
+	}
+	bpf_jit_filter_t *filter = bpf_jit_filter_ref(GetPcapFilter(env, jpcap));
+	(*env)->MonitorExit(env, jpcap);
+	return filter;
+}
+
+/*
+ * Replace the filter of a Pcap and drop the Pcap's reference to the previous one,
+ * which lives on until the loops that acquired it return.
+ */
+void SetPcapFilter(JNIEnv *env, jobject jpcap, bpf_jit_filter_t *filter) {
+	if ((*env)->MonitorEnter(env, jpcap) != JNI_OK) {
+		bpf_jit_filter_free(filter);
+		return;
+	}
+	bpf_jit_filter_t *previous = GetPcapFilter(env, jpcap);
+	(*env)->SetLongField(env, jpcap, PcapFilterAddressFID, PointerToJlong(filter));
+	(*env)->MonitorExit(env, jpcap);
+	bpf_jit_filter_free(previous);
+}
+
 void pcap_callback(u_char *user, const struct pcap_pkthdr *pkt_header, const u_char *pkt_data) {
 	pcap_user_data_t *user_data = (pcap_user_data_t *) user;
+	if (user_data->filter != NULL
+			&& bpf_jit_filter_run(user_data->filter, pkt_data, pkt_header->len, pkt_header->caplen) == 0) {
+		return;
+	}
 	JNIEnv *env = user_data->env;
-	jobject pkt_hdr = NewObject(env, PcapPktHdrClass, "<init>", "()V");
+	jobject pkt_hdr = (*env)->NewObject(env, PcapPktHdrClass, PcapPktHdrInitMID);
 	(*env)->SetIntField(env, pkt_hdr, PcapPktHdrCaplenFID, (jint) pkt_header->caplen);
 	(*env)->SetIntField(env, pkt_hdr, PcapPktHdrLenFID, (jint) pkt_header->len);
 	(*env)->SetIntField(env, pkt_hdr, PcapPktHdrTvSecFID, (jint) pkt_header->ts.tv_sec);
 	(*env)->SetLongField(env, pkt_hdr, PcapPktHdrTvUsecFID, (jlong) pkt_header->ts.tv_usec);
-	(*env)->CallNonvirtualVoidMethod(env,
-    			user_data->callback,
-			user_data->PcapHandlerClass,
-			user_data->PcapHandlerNextPacketMID,
+	jobject pkt_data_buf = (*env)->NewDirectByteBuffer(env, (void *) pkt_data, (jint) pkt_header->caplen);
+	(*env)->CallVoidMethod(env,
+			user_data->callback,
+			PcapHandlerNextPacketMID,
 			user_data->user,
 			pkt_hdr,
-			(*env)->NewDirectByteBuffer(env, (void *) pkt_data, (jint) pkt_header->caplen));
+			pkt_data_buf);
+	(*env)->DeleteLocalRef(env, pkt_data_buf);
 	(*env)->DeleteLocalRef(env, pkt_hdr);
 }
+
+/*
+ * Same as pcap_callback, but hands the same PcapPktHdr and direct ByteBuffer to every packet.
+ * The buffer is re-pointed at the packet inside the libpcap buffer, so it is only valid
+ * during the callback.
+ */
+void pcap_reuse_callback(u_char *user, const struct pcap_pkthdr *pkt_header, const u_char *pkt_data) {
+	pcap_user_data_t *user_data = (pcap_user_data_t *) user;
+	if (user_data->filter != NULL
+			&& bpf_jit_filter_run(user_data->filter, pkt_data, pkt_header->len, pkt_header->caplen) == 0) {
+		return;
+	}
+	JNIEnv *env = user_data->env;
+	(*env)->SetIntField(env, user_data->pkt_hdr, PcapPktHdrCaplenFID, (jint) pkt_header->caplen);
+	(*env)->SetIntField(env, user_data->pkt_hdr, PcapPktHdrLenFID, (jint) pkt_header->len);
+	(*env)->SetIntField(env, user_data->pkt_hdr, PcapPktHdrTvSecFID, (jint) pkt_header->ts.tv_sec);
+	(*env)->SetLongField(env, user_data->pkt_hdr, PcapPktHdrTvUsecFID, (jlong) pkt_header->ts.tv_usec);
+	if (BufferAddressFID == NULL) {
+		jobject pkt_data_buf = (*env)->NewDirectByteBuffer(env, (void *) pkt_data, (jint) pkt_header->caplen);
+		(*env)->CallVoidMethod(env, user_data->callback, PcapHandlerNextPacketMID,
+				user_data->user, user_data->pkt_hdr, pkt_data_buf);
+		(*env)->DeleteLocalRef(env, pkt_data_buf);
+		return;
+	}
+	if (user_data->pkt_data == NULL) {
+		user_data->pkt_data = (*env)->NewDirectByteBuffer(env, (void *) pkt_data, (jint) pkt_header->caplen);
+	} else {
+		(*env)->SetLongField(env, user_data->pkt_data, BufferAddressFID, PointerToJlong((void *) pkt_data));
+		(*env)->SetIntField(env, user_data->pkt_data, BufferCapacityFID, (jint) pkt_header->caplen);
+		(*env)->SetIntField(env, user_data->pkt_data, BufferLimitFID, (jint) pkt_header->caplen);
+		(*env)->SetIntField(env, user_data->pkt_data, BufferPositionFID, (jint) 0);
+		(*env)->SetIntField(env, user_data->pkt_data, BufferMarkFID, (jint) -1);
+	}
+	(*env)->CallVoidMethod(env, user_data->callback, PcapHandlerNextPacketMID,
+			user_data->user, user_data->pkt_hdr, user_data->pkt_data);
+}
+
+void pcap_batch_callback(u_char *user, const struct pcap_pkthdr *pkt_header, const u_char *pkt_data) {
+	pcap_batch_t *batch = (pcap_batch_t *) user;
+	if (batch->filter != NULL
+			&& bpf_jit_filter_run(batch->filter, pkt_data, pkt_header->len, pkt_header->caplen) == 0) {
+		return;
+	}
+	if (batch->offset + sizeof(pcap_batch_pkthdr_t) > batch->capacity) {
+		return;
+	}
+	pcap_batch_pkthdr_t hdr;
+	size_t caplen = pkt_header->caplen;
+	if (caplen > batch->capacity - batch->offset - sizeof(pcap_batch_pkthdr_t)) {
+		caplen = batch->capacity - batch->offset - sizeof(pcap_batch_pkthdr_t);
+	}
+	hdr.tv_sec = (bpf_u_int32) pkt_header->ts.tv_sec;
+	hdr.tv_usec = (bpf_u_int32) pkt_header->ts.tv_usec;
+	hdr.caplen = (bpf_u_int32) caplen;
+	hdr.len = (bpf_u_int32) pkt_header->len;
+	memcpy(batch->buf + batch->offset, &hdr, sizeof(pcap_batch_pkthdr_t));
+	batch->offset += sizeof(pcap_batch_pkthdr_t);
+	memcpy(batch->buf + batch->offset, pkt_data, caplen);
+	batch->offset += caplen;
+	batch->count++;
+}
@@ -19,6 +19,8 @@
 #include <pcap.h>
 #include <stdint.h>
 
+#include "bpf_jit.h"
+
 #define CLASS_NOT_FOUND_EXCEPTION "java/lang/ClassNotFoundException"
 #define NO_SUCH_METHOD_EXCEPTION "java/lang/NoSuchMethodException"
 #define NO_SUCH_FIELD_EXCEPTION "java/lang/NoSuchFieldException"
@@ -37,10 +39,31 @@ typedef struct pcap_user_data_t {
         JNIEnv *env;
         jobject callback;
         jobject user;
-        jclass PcapHandlerClass;
-        jmethodID PcapHandlerNextPacketMID;
+        jobject pkt_hdr;
+        jobject pkt_data;
+        bpf_jit_filter_t *filter;
 } pcap_user_data_t;
 
+/*
+ * Record header of a packed packet batch. It has the same layout as
+ * a savefile record header (in host byte order), so a filled batch
+ * can be written to a savefile as is.
+ */
+typedef struct pcap_batch_pkthdr_t {
+	bpf_u_int32 tv_sec;
+	bpf_u_int32 tv_usec;
+	bpf_u_int32 caplen;
+	bpf_u_int32 len;
+} pcap_batch_pkthdr_t;
+
+typedef struct pcap_batch_t {
+	u_char *buf;
+	size_t capacity;
+	size_t offset;
+	int count;
+	bpf_jit_filter_t *filter;
+} pcap_batch_t;
+
 typedef struct arp_user_data_t {
         JNIEnv *env;
         jobject callback;
@@ -81,4 +104,14 @@ jobject SetBpfProgram(JNIEnv *env, jobject obj, struct bpf_program *fp);
 
 struct bpf_program *GetBpfProgram(JNIEnv *env, jobject jbpf_program);
 
+bpf_jit_filter_t *GetPcapFilter(JNIEnv *env, jobject jpcap);
+
+bpf_jit_filter_t *AcquirePcapFilter(JNIEnv *env, jobject jpcap);
+
+void SetPcapFilter(JNIEnv *env, jobject jpcap, bpf_jit_filter_t *filter);
+
 void pcap_callback(u_char *user, const struct pcap_pkthdr *pkt_header, const u_char *pkt_data);
+
+void pcap_reuse_callback(u_char *user, const struct pcap_pkthdr *pkt_header, const u_char *pkt_data);
+
+void pcap_batch_callback(u_char *user, const struct pcap_pkthdr *pkt_header, const u_char *pkt_data);
@@ -0,0 +1,188 @@
+/**
+ * Copyright (C) 2017  Ardika Rommy Sanjaya
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+package com.ardikars.jxnet.util;
+
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+
+import static com.ardikars.jxnet.Validate.CheckNotNull;
+
+/**
+ * Internet checksum (RFC 1071) with pseudo headers and incremental update (RFC 1624).
+ * Data is summed eight bytes at a time into an unfolded long accumulator, so a
+ * checksum over several pieces (pseudo header, header, payload) is the sum of the
+ * pieces passed to finish(). Every piece but the last must have an even length.
+ * @author Ardika Rommy Sanjaya
+ * @since 1.1.5
+ */
+public final class Checksum {
+
+    private Checksum() {
+    }
+
+    /**
+     * Add data to a sum.
+     * @param sum sum so far, 0 to start.
+     * @param data data.
+     * @param offset offset.
+     * @param length length.
+     * @return unfolded sum.
+     */
+    public static long sum(final long sum, final byte[] data, final int offset, final int length) {
+        CheckNotNull(data);
+        if (offset < 0 || length < 0 || offset + length > data.length) {
+            throw new ArrayIndexOutOfBoundsException();
+        }
+        return sum(sum, ByteBuffer.wrap(data), offset, length);
+    }
+
+    /**
+     * Add data to a sum. The data is read in network byte order, whatever the order of the buffer.
+     * @param sum sum so far, 0 to start.
+     * @param buffer buffer, not modified.
+     * @param offset absolute offset.
+     * @param length length.
+     * @return unfolded sum.
+     */
+    public static long sum(long sum, final ByteBuffer buffer, final int offset, final int length) {
+        final boolean swap = buffer.order() != ByteOrder.BIG_ENDIAN;
+        final int end = offset + length;
+        int i = offset;
+        for (; i + 8 <= end; i += 8) {
+            long value = buffer.getLong(i);
+            if (swap) {
+                value = Long.reverseBytes(value);
+            }
+            sum += (value >>> 32) + (value & 0xffffffffL);
+        }
+        if (i + 4 <= end) {
+            int value = buffer.getInt(i);
+            sum += (swap ? Integer.reverseBytes(value) : value) & 0xffffffffL;
+            i += 4;
+        }
+        if (i + 2 <= end) {
+            short value = buffer.getShort(i);
+            sum += (swap ? Short.reverseBytes(value) : value) & 0xffff;
+            i += 2;
+        }
+        if (i < end) {
+            sum += (buffer.get(i) & 0xff) << 8;
+        }
+        return sum;
+    }
+
+    /**
+     * Sum of an IPv4 pseudo header.
+     * @param source source address.
+     * @param destination destination address.
+     * @param protocol protocol.
+     * @param length upper layer length.
+     * @return unfolded sum.
+     */
+    public static long pseudoHeader(final int source, final int destination, final int protocol, final int length) {
+        return (source & 0xffffffffL) + (destination & 0xffffffffL) + (protocol & 0xff) + (length & 0xffff);
+    }
+
+    /**
+     * Sum of an IPv6 pseudo header.
+     * @param source source address (16 bytes).
+     * @param destination destination address (16 bytes).
+     * @param nextHeader upper layer protocol.
+     * @param length upper layer length.
+     * @return unfolded sum.
+     */
+    public static long pseudoHeader(final byte[] source, final byte[] destination, final int nextHeader, final long length) {
+        long sum = sum(0, source, 0, source.length);
+        sum = sum(sum, destination, 0, destination.length);
+        return sum + (nextHeader & 0xff) + (length >>> 32) + (length & 0xffffffffL);
+    }
+
+    /**
+     * Fold a sum to 16 bits.
+     * @param sum unfolded sum.
+     * @return one's complement sum.
+     */
+    public static int fold(long sum) {
+        while ((sum >>> 16) != 0) {
+            sum = (sum & 0xffff) + (sum >>> 16);
+        }
+        return (int) sum;
+    }
+
+    /**
+     * Checksum of a sum.
+     * @param sum unfolded sum.
+     * @return checksum.
+     */
+    public static int finish(final long sum) {
+        return ~fold(sum) & 0xffff;
+    }
+
+    /**
+     * Checksum of data.
+     * @param data data.
+     * @param offset offset.
+     * @param length length.
+     * @return checksum.
+     */
+    public static int compute(final byte[] data, final int offset, final int length) {
+        return finish(sum(0, data, offset, length));
+    }
+
+    /**
+     * Update a checksum after a 16 bit word of the data changed (RFC 1624, eqn. 3).
+     * @param checksum old checksum.
+     * @param oldValue old word.
+     * @param newValue new word.
+     * @return new checksum.
+     */
+    public static int updateShort(final int checksum, final int oldValue, final int newValue) {
+        return finish((~checksum & 0xffff) + (~oldValue & 0xffff) + (newValue & 0xffff));
+    }
+
+    /**
+     * Update a checksum after an aligned 32 bit value of the data, such as an IPv4 address, changed.
+     * @param checksum old checksum.
+     * @param oldValue old value.
+     * @param newValue new value.
+     * @return new checksum.
+     */
+    public static int updateInt(final int checksum, final int oldValue, final int newValue) {
+        return finish((~checksum & 0xffff) + (~oldValue >>> 16 & 0xffff) + (~oldValue & 0xffff)
+                + (newValue >>> 16) + (newValue & 0xffff));
+    }
+
+    /**
+     * Update a checksum after aligned bytes of the data, such as an IPv6 address, changed.
+     * @param checksum old checksum.
+     * @param oldValue old bytes.
+     * @param newValue new bytes, of the same even length.
+     * @return new checksum.
+     */
+    public static int update(final int checksum, final byte[] oldValue, final byte[] newValue) {
+        if (oldValue.length != newValue.length || (oldValue.length & 1) != 0) {
+            throw new IllegalArgumentException("Values must have the same even length.");
+        }
+        long sum = ~checksum & 0xffff;
+        for (int i = 0; i < oldValue.length; i += 2) {
+            sum += ~((oldValue[i] & 0xff) << 8 | oldValue[i + 1] & 0xff) & 0xffff;
+        }
+        return finish(sum(sum, newValue, 0, newValue.length));
+    }
+
+}
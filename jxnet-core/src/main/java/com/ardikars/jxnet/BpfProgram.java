@@ -17,6 +17,8 @@
 
 package com.ardikars.jxnet;
 
+import java.nio.ByteBuffer;
+
 /**
  * @author Ardika Rommy Sanjaya
  * @since 1.0.0
@@ -41,8 +43,18 @@ public final class BpfProgram {
 	
 	private native void initBpfProgram();
 
+	private native int matchesBuffer(ByteBuffer buffer, int offset, int caplen, int wirelen);
+
+	private native int matchesArray(byte[] data, int offset, int caplen, int wirelen);
+
+	private native int matchesBatch(ByteBuffer buffer, int count, long[] bitmap);
+
+	private native boolean compileJit();
+
 	private long address;
 
+	private long jitAddress;
+
 	/**
 	 * Create instance ob BpfProgram and initialize it.
 	 */
@@ -61,6 +73,65 @@ public final class BpfProgram {
 		return false;
 	}
 
+	/**
+	 * Run this compiled filter against a packet in memory.
+	 * The packet is the remaining bytes of the direct buffer (position to limit).
+	 * @param buffer direct buffer holding the packet.
+	 * @param wirelen original length of the packet.
+	 * @return true if the packet matches the filter.
+	 * @since 1.1.5
+	 */
+	public boolean matches(ByteBuffer buffer, int wirelen) {
+		return this.matchesBuffer(buffer, buffer.position(), buffer.remaining(), wirelen) > 0;
+	}
+
+	/**
+	 * Run this compiled filter against a packet in memory.
+	 * @param data packet bytes, captured length is data.length.
+	 * @param wirelen original length of the packet.
+	 * @return true if the packet matches the filter.
+	 * @since 1.1.5
+	 */
+	public boolean matches(byte[] data, int wirelen) {
+		return this.matchesArray(data, 0, data.length, wirelen) > 0;
+	}
+
+	/**
+	 * Run this compiled filter against count packets packed as in PcapPktBatch,
+	 * starting at the beginning of buffer, in a single native call.
+	 * Bit i of bitmap (bitmap[i / 64] &amp; (1L &lt;&lt; (i % 64))) is set if packet i matches.
+	 * @param buffer direct buffer holding the packed packets.
+	 * @param count number of packets.
+	 * @param bitmap match bitmap, at least (count + 63) / 64 long.
+	 * @return number of matching packets.
+	 * @since 1.1.5
+	 */
+	public int matches(ByteBuffer buffer, int count, long[] bitmap) {
+		return this.matchesBatch(buffer, count, bitmap);
+	}
+
+	/**
+	 * Run this compiled filter against every packet of a batch.
+	 * @param batch packet batch.
+	 * @param bitmap match bitmap, at least (batch.getCount() + 63) / 64 long.
+	 * @return number of matching packets.
+	 * @since 1.1.5
+	 */
+	public int matches(PcapPktBatch batch, long[] bitmap) {
+		return this.matchesBatch(batch.getBuffer(), batch.getCount(), bitmap);
+	}
+
+	/**
+	 * Translate this compiled filter to native machine code, used by the matches methods from now on.
+	 * Only x86-64 is supported; on other platforms the program keeps running in the interpreter.
+	 * The generated code is released by Jxnet.PcapFreeCode.
+	 * @return true if native code was generated.
+	 * @since 1.1.5
+	 */
+	public boolean jit() {
+		return this.compileJit();
+	}
+
 	@Override
 	public boolean equals(Object obj) {
 		if (obj == this)
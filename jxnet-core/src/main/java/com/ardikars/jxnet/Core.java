@@ -43,6 +43,42 @@ class Core {
         return Jxnet.PcapOpenLive(source.getName(), snaplen, promisc.getValue(), timeout, errbuf);
     }
 
+    /**
+     * Collect a group of packets into a packet batch with a single native call.
+     * @param pcap pcap object.
+     * @param batch packet batch.
+     * @param maxPackets maximum number of packets to collect.
+     * @return number of collected packets, -1 on error, -2 if loop terminated by PcapBreakLoop().
+     */
+    public static int PcapDispatchBatch(Pcap pcap, PcapPktBatch batch, int maxPackets) {
+        int r = Jxnet.PcapDispatchBatch(pcap, batch.getBuffer(), maxPackets);
+        batch.reset(r > 0 ? r : 0);
+        return r;
+    }
+
+    /**
+     * Collect the header summary of a group of packets into summary columns with a single native call.
+     * @param pcap pcap object.
+     * @param summary summary columns.
+     * @param maxPackets maximum number of packets to collect.
+     * @return number of collected packets, -1 on error, -2 if loop terminated by PcapBreakLoop().
+     */
+    public static int PcapDispatchSummary(Pcap pcap, PcapPktSummary summary, int maxPackets) {
+        int r = Jxnet.PcapDispatchSummary(pcap, summary.getBuffer(), summary.getCapacity(), maxPackets);
+        summary.reset(r > 0 ? r : 0);
+        return r;
+    }
+
+    /**
+     * Write every packet of a packet batch with a single native call.
+     * @param pcapDumper pcap dumper object.
+     * @param batch packet batch.
+     * @return number of written packets, -1 on error.
+     */
+    public static int PcapDumpBatch(PcapDumper pcapDumper, PcapPktBatch batch) {
+        return Jxnet.PcapDumpBatch(pcapDumper, batch.getBuffer(), batch.getCount());
+    }
+
     /**
      * Is used to create a packet capture handle to look at packets on the network.
      * Source is a string that specifies the network device to open;
@@ -82,6 +118,29 @@ class Core {
         return Jxnet.PcapSetImmediateMode(pcap, immediateMode.getValue());
     }
 
+    /**
+     * Join an activated live capture handle to a PACKET_FANOUT group (Linux only).
+     * @param pcap activated pcap object.
+     * @param groupId fanout group id, 0 to 65535.
+     * @param mode fanout mode.
+     * @return 0 on success, -1 on failure.
+     */
+    public static int PcapSetFanout(Pcap pcap, int groupId, PcapFanoutMode mode) {
+        return Jxnet.PcapSetFanout(pcap, groupId, mode.getValue());
+    }
+
+    /**
+     * Open a compressed file to write packets.
+     * @param pcap pcap object.
+     * @param fname file name.
+     * @param compression compression codec.
+     * @param level compression level, -1 for the codec default with gzip, 0 with zstd.
+     * @return null on error.
+     */
+    public static PcapDumper PcapDumpOpenCompressed(Pcap pcap, String fname, PcapCompression compression, int level) {
+        return Jxnet.PcapDumpOpenCompressed(pcap, fname, compression.getValue(), level);
+    }
+
     /**
      * Compile a packet filter, converting an high level filtering expression
      * (see Filtering expression syntax) in a program that can be interpreted
@@ -80,6 +80,56 @@ public final class Jxnet extends Core {
 	 */
 	public static native <T> int PcapDispatch(Pcap pcap, int cnt, PcapHandler<T> callback, T user);
 
+	/**
+	 * Same as PcapLoop(), but every callback receives the same PcapPktHdr and ByteBuffer objects,
+	 * updated in place for each packet, so no objects are allocated per packet.
+	 * The buffer points into the libpcap buffer; neither object may be used after the callback returns.
+	 * @param pcap pcap object.
+	 * @param cnt maximum iteration, -1 to infinite.
+	 * @param callback callback function.
+	 * @param user arg.
+	 * @param <T> arg type.
+	 * @return -1 on error, 0 otherwise.
+	 */
+	public static native <T> int PcapLoopReuse(Pcap pcap, int cnt, PcapHandler<T> callback, T user);
+
+	/**
+	 * Same as PcapDispatch(), but every callback receives the same PcapPktHdr and ByteBuffer objects,
+	 * updated in place for each packet, so no objects are allocated per packet.
+	 * The buffer points into the libpcap buffer; neither object may be used after the callback returns.
+	 * @param pcap pcap object.
+	 * @param cnt maximum number of packets to process.
+	 * @param callback callback function.
+	 * @param user arg.
+	 * @param <T> arg type.
+	 * @return number of processed packets, -1 on error.
+	 */
+	public static native <T> int PcapDispatchReuse(Pcap pcap, int cnt, PcapHandler<T> callback, T user);
+
+	/**
+	 * Collect a group of packets into a direct buffer with a single native call.
+	 * Every packet is stored as a 16 byte header (tv_sec, tv_usec, caplen and len,
+	 * each a 32 bit integer in native byte order) followed by caplen bytes of data.
+	 * No more packets are collected than fit in the buffer at snapshot length.
+	 * @param pcap pcap object.
+	 * @param buffer direct buffer to fill.
+	 * @param maxPackets maximum number of packets to collect.
+	 * @return number of collected packets, -1 on error, -2 if loop terminated by PcapBreakLoop().
+	 */
+	public static native int PcapDispatchBatch(Pcap pcap, ByteBuffer buffer, int maxPackets);
+
+	/**
+	 * Collect the L2-L4 header summary of a group of packets with a single native call,
+	 * written column by column into a direct buffer laid out as PcapPktSummary.
+	 * @param pcap pcap object.
+	 * @param buffer direct buffer of at least capacity * PcapPktSummary.RECORD_SIZE bytes.
+	 * @param capacity number of packets the columns of buffer hold.
+	 * @param maxPackets maximum number of packets to collect.
+	 * @return number of collected packets, -1 on error, -2 if loop terminated by PcapBreakLoop().
+	 * @since 1.1.5
+	 */
+	public static native int PcapDispatchSummary(Pcap pcap, ByteBuffer buffer, int capacity, int maxPackets);
+
 	/**
 	 * Open a file to write packets.
 	 * @param pcap pcap object.
@@ -98,6 +148,7 @@ public final class Jxnet extends Core {
 
 	/**
 	 * Open a savefile in the tcpdump/libpcap format to read packets.
+	 * gzip and zstd compressed savefiles are decompressed on the fly (not on Windows).
 	 * @param fname file name.
 	 * @param errbuf error buffer.
 	 * @return null on error.
@@ -134,6 +185,20 @@ public final class Jxnet extends Core {
 	 */
 	public static native int PcapSendPacket(Pcap pcap, ByteBuffer buf, int size);
 
+	/**
+	 * Send many raw packets stored in one direct buffer.
+	 * Frame i starts at offsets[i] and is lengths[i] bytes long.
+	 * On Linux frames are pushed with sendmmsg(), many per system call;
+	 * elsewhere they are sent one by one with PcapSendPacket().
+	 * @param pcap pcap object.
+	 * @param buf direct buffer holding the frames.
+	 * @param offsets offset of each frame in buf.
+	 * @param lengths length of each frame.
+	 * @param count number of frames to send.
+	 * @return number of frames queued, -1 if the first frame could not be sent.
+	 */
+	public static native int PcapSendBatch(Pcap pcap, ByteBuffer buf, int[] offsets, int[] lengths, int count);
+
 	/**
 	 * Return the next available packet.
 	 * @param pcap pcap object.
@@ -474,6 +539,67 @@ public final class Jxnet extends Core {
 	 */
 	public static native int PcapSetDirection(Pcap pcap, PcapDirection direction);
 
+	/**
+	 * Join an activated live capture handle to a PACKET_FANOUT group (Linux only).
+	 * Every handle on the same device that joins the same group with the same mode
+	 * receives a share of the traffic instead of a full copy.
+	 * @param pcap activated pcap object.
+	 * @param group_id fanout group id, 0 to 65535.
+	 * @param mode fanout mode (see PcapFanoutMode).
+	 * @return 0 on success, -1 on failure.
+	 */
+	public static native int PcapSetFanout(Pcap pcap, int group_id, int mode);
+
+	/**
+	 * Attach a JIT-compiled copy of a compiled filter to the handle (x86-64 only, other
+	 * platforms fall back to the BPF interpreter). Packets that do not match are dropped
+	 * before reaching the handler of PcapLoop, PcapDispatch, their reuse variants,
+	 * PcapDispatchBatch, PcapDispatchSummary and PcapCaptureRing; they still count toward cnt.
+	 * Live captures should prefer PcapSetFilter, which filters in the kernel.
+	 * The program can be freed after this call. The filter may be replaced from a handler or
+	 * another thread: a loop or PcapCaptureRing already running keeps the filter it started with.
+	 * @param pcap pcap object.
+	 * @param fp compiled filter, or null to remove the current filter.
+	 * @return 0 on success, -1 on failure.
+	 * @since 1.1.5
+	 */
+	public static native int PcapSetJitFilter(Pcap pcap, BpfProgram fp);
+
+	/**
+	 * Open a file to write packets through a compression thread (not supported on Windows).
+	 * PcapDump() only blocks when every compression buffer is queued; PcapDumpFTell() returns
+	 * uncompressed offsets. PcapOpenOffline() detects and reads the compressed file.
+	 * @param pcap pcap object.
+	 * @param fname file name.
+	 * @param compression compression codec (see PcapCompression).
+	 * @param level compression level, -1 for the codec default with gzip, 0 with zstd.
+	 * @return null on error.
+	 * @since 1.1.5
+	 */
+	public static native PcapDumper PcapDumpOpenCompressed(Pcap pcap, String fname, int compression, int level);
+
+	/**
+	 * Write a group of packets packed as by PcapDispatchBatch() with a single native call
+	 * and a single buffered write, the packed records being savefile records.
+	 * @param pcap_dumper pcap dumper object.
+	 * @param buffer direct buffer holding count packed packets from its start.
+	 * @param count number of packets.
+	 * @return number of written packets, -1 on error.
+	 * @since 1.1.5
+	 */
+	public static native int PcapDumpBatch(PcapDumper pcap_dumper, ByteBuffer buffer, int count);
+
+	/**
+	 * Write a group of packets packed as by PcapDispatchBatch() with a single native call
+	 * and a single buffered write. The array is pinned while it is written.
+	 * @param pcap_dumper pcap dumper object.
+	 * @param buffer array holding count packed packets from its start, headers in native byte order.
+	 * @param count number of packets.
+	 * @return number of written packets, -1 on error.
+	 * @since 1.1.5
+	 */
+	public static native int PcapDumpBatch(PcapDumper pcap_dumper, byte[] buffer, int count);
+
 	/**
 	 * Set the time stamp precision returned in captures.
 	 * @param pcap pcap.
@@ -486,9 +612,11 @@ public final class Jxnet extends Core {
 	/**
 	 * Get the time stamp precision returned in captures.
 	 * @param pcap pcap object.
-	 * @return the precision of the time stamp returned in packet captures on the pcap descriptor.
+	 * @return the precision of the time stamp returned in packet captures on the pcap descriptor
+	 * (see TimestampPrecision), always micro if libpcap does not support nanosecond time stamps, -1 on error.
+	 * @since 1.1.5
 	 */
-	// public static native int PcapGetTStampPrecision(Pcap pcap);
+	public static native int PcapGetTStampPrecision(Pcap pcap);
 
 	static {
 		if (!isLoaded) {
@@ -0,0 +1,427 @@
+/**
+ * Copyright (C) 2017  Ardika Rommy Sanjaya
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+package com.ardikars.jxnet;
+
+import java.io.File;
+import java.io.IOException;
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+
+/**
+ * Classic pcap savefile mapped read-only into memory (not supported on Windows).
+ * Records are read in place from direct buffer windows over the mapping, so packet
+ * data is never copied through stdio or libpcap's buffer. Windows are views of a
+ * single mapping; opening a new one does not unmap the previous one, so buffers
+ * handed out stay valid until close().
+ * Independent cursors over record-aligned byte ranges of the same mapping are
+ * created with partition() and range(), one per reading thread.
+ * pcapng files are not supported, use PcapOpenOffline for them.
+ * @author Ardika Rommy Sanjaya
+ * @since 1.1.5
+ */
+public final class MappedPcap {
+
+	public static final int FILE_HEADER_LENGTH = 24;
+	public static final int RECORD_HEADER_LENGTH = 16;
+	public static final int DEFAULT_WINDOW_SIZE = 64 * 1024 * 1024;
+
+	private static final int MAGIC = 0xa1b2c3d4;
+	private static final int MAGIC_NSEC = 0xa1b23c4d;
+
+	private static native long openFile(String path, StringBuilder errbuf);
+
+	private static native long fileSize(long address);
+
+	private static native ByteBuffer mapWindow(long address, long offset, int length);
+
+	private static native void closeFile(long address);
+
+	private long address;
+
+	private final long size;
+
+	private final long end;
+
+	private final boolean owner;
+
+	private final int windowSize;
+
+	private final ByteOrder order;
+
+	private final boolean nanosecond;
+
+	private final int snapshotLength;
+
+	private final DataLinkType dataLinkType;
+
+	private ByteBuffer window;
+
+	private long windowStart;
+
+	private long position;
+
+	private int offset;
+
+	private long fromTs = Long.MIN_VALUE;
+
+	private long toTs = Long.MAX_VALUE;
+
+	private MappedPcap(long address, int windowSize) {
+		this.address = address;
+		this.size = fileSize(address);
+		this.windowSize = windowSize;
+		ByteBuffer header = mapWindow(address, 0, FILE_HEADER_LENGTH).order(ByteOrder.LITTLE_ENDIAN);
+		int magic = header.getInt(0);
+		if (magic == MAGIC || magic == MAGIC_NSEC) {
+			this.order = ByteOrder.LITTLE_ENDIAN;
+		} else {
+			this.order = ByteOrder.BIG_ENDIAN;
+			header.order(ByteOrder.BIG_ENDIAN);
+			magic = header.getInt(0);
+		}
+		this.nanosecond = magic == MAGIC_NSEC;
+		this.snapshotLength = header.getInt(16);
+		this.dataLinkType = DataLinkType.valueOf((short) header.getInt(20));
+		this.position = FILE_HEADER_LENGTH;
+		this.end = this.size;
+		this.owner = true;
+		this.offset = -1;
+	}
+
+	private MappedPcap(MappedPcap parent, long start, long end) {
+		this.address = parent.getAddress();
+		this.size = parent.size;
+		this.windowSize = parent.windowSize;
+		this.order = parent.order;
+		this.nanosecond = parent.nanosecond;
+		this.snapshotLength = parent.snapshotLength;
+		this.dataLinkType = parent.dataLinkType;
+		this.position = start;
+		this.end = end;
+		this.owner = false;
+		this.offset = -1;
+	}
+
+	/**
+	 * Map a classic pcap savefile with 64MB windows.
+	 * @param path savefile path.
+	 * @param errbuf error buffer.
+	 * @return MappedPcap or null on error.
+	 */
+	public static MappedPcap open(String path, StringBuilder errbuf) {
+		return open(path, DEFAULT_WINDOW_SIZE, errbuf);
+	}
+
+	/**
+	 * Map a classic pcap savefile.
+	 * @param path savefile path.
+	 * @param windowSize size of the buffer windows over the file, grown for larger records.
+	 * @param errbuf error buffer.
+	 * @return MappedPcap or null on error.
+	 */
+	public static MappedPcap open(String path, int windowSize, StringBuilder errbuf) {
+		if (windowSize < FILE_HEADER_LENGTH) {
+			throw new IllegalArgumentException("Window size is too small.");
+		}
+		long address = openFile(path, errbuf);
+		if (address == 0) {
+			return null;
+		}
+		return new MappedPcap(address, windowSize);
+	}
+
+	private void ensureWindow(long position, int length) {
+		if (this.window == null || position < this.windowStart
+				|| position + length > this.windowStart + this.window.capacity()) {
+			long remaining = this.size - position;
+			int windowLength = (int) Math.min(Math.max(this.windowSize, length), remaining);
+			this.window = mapWindow(this.getAddress(), position, windowLength).order(this.order);
+			this.windowStart = position;
+		}
+	}
+
+	/**
+	 * Map a classic pcap savefile and position it on the packets between fromTs and toTs.
+	 * The sidecar index (see PcapIndex) is used to seek if it exists and matches the savefile,
+	 * otherwise the file is indexed first. Reading ends at the first packet later than toTs.
+	 * @param path savefile path.
+	 * @param fromTs first timestamp in microseconds, inclusive.
+	 * @param toTs last timestamp in microseconds, inclusive.
+	 * @param errbuf error buffer.
+	 * @return MappedPcap or null on error.
+	 */
+	public static MappedPcap openRange(String path, long fromTs, long toTs, StringBuilder errbuf) {
+		MappedPcap file = open(path, errbuf);
+		if (file == null) {
+			return null;
+		}
+		PcapIndex index;
+		try {
+			index = PcapIndex.load(PcapIndex.sidecar(path));
+		} catch (IOException e) {
+			index = null;
+		}
+		if (index == null || !index.isCurrent(new File(path))) {
+			index = PcapIndex.build(file, PcapIndex.DEFAULT_INTERVAL);
+		}
+		long start = index.seek(fromTs);
+		if (start < FILE_HEADER_LENGTH || start > file.size) {
+			start = FILE_HEADER_LENGTH;
+		}
+		file.position = start;
+		file.offset = -1;
+		file.fromTs = fromTs;
+		file.toTs = toTs;
+		return file;
+	}
+
+	/**
+	 * Move to the next record.
+	 * A truncated record at the end of the file ends the iteration.
+	 * @return false if there are no more records, true otherwise.
+	 */
+	public boolean next() {
+		if (this.isClosed()) {
+			throw new IllegalStateException("MappedPcap is closed.");
+		}
+		while (this.position + RECORD_HEADER_LENGTH <= this.end) {
+			this.ensureWindow(this.position, RECORD_HEADER_LENGTH);
+			int caplen = this.window.getInt((int) (this.position - this.windowStart) + 8);
+			if (caplen < 0 || this.position + RECORD_HEADER_LENGTH + caplen > this.end) {
+				return false;
+			}
+			this.ensureWindow(this.position, RECORD_HEADER_LENGTH + caplen);
+			this.offset = (int) (this.position - this.windowStart);
+			if (this.toTs != Long.MAX_VALUE || this.fromTs != Long.MIN_VALUE) {
+				long timestamp = this.getTimestamp();
+				if (timestamp > this.toTs) {
+					return false;
+				}
+				if (timestamp < this.fromTs) {
+					this.position += RECORD_HEADER_LENGTH + caplen;
+					continue;
+				}
+			}
+			this.position += RECORD_HEADER_LENGTH + caplen;
+			return true;
+		}
+		return false;
+	}
+
+	/**
+	 * Split the records of the file into parts byte ranges of about the same size.
+	 * Boundaries are found by walking the record headers once from the beginning
+	 * of the file, so every range starts and ends on a record.
+	 * @param parts number of ranges.
+	 * @return parts + 1 file offsets, range i is [offsets[i], offsets[i + 1]).
+	 */
+	public long[] partition(int parts) {
+		if (parts < 1) {
+			throw new IllegalArgumentException("Number of parts must be positive.");
+		}
+		long[] offsets = new long[parts + 1];
+		MappedPcap cursor = this.range(FILE_HEADER_LENGTH, this.size);
+		long records = this.size - FILE_HEADER_LENGTH;
+		int part = 1;
+		offsets[0] = FILE_HEADER_LENGTH;
+		while (part < parts) {
+			long start = cursor.getPosition();
+			if (start - FILE_HEADER_LENGTH >= records * part / parts) {
+				offsets[part++] = start;
+			} else if (!cursor.next()) {
+				break;
+			}
+		}
+		while (part < parts) {
+			offsets[part++] = cursor.getPosition();
+		}
+		offsets[parts] = this.size;
+		cursor.close();
+		return offsets;
+	}
+
+	/**
+	 * Create an independent cursor over [start, end) of this file, sharing the mapping.
+	 * start must be a record boundary (see partition()). The cursor must not be used
+	 * after this MappedPcap is closed; closing the cursor does not unmap the file.
+	 * @param start file offset of the first record.
+	 * @param end file offset the cursor stops at.
+	 * @return cursor.
+	 */
+	public MappedPcap range(long start, long end) {
+		if (this.isClosed()) {
+			throw new IllegalStateException("MappedPcap is closed.");
+		}
+		if (start < FILE_HEADER_LENGTH || end < start || end > this.size) {
+			throw new IllegalArgumentException("Range out of file bounds.");
+		}
+		return new MappedPcap(this, start, end);
+	}
+
+	/**
+	 * Read records the way PcapLoop does, handing each one to the callback.
+	 * The packet buffer is a slice of the mapping, valid until close().
+	 * @param cnt maximum number of packets, -1 or 0 for all of them.
+	 * @param callback callback function.
+	 * @param user arg.
+	 * @param <T> type.
+	 * @return number of packets read.
+	 */
+	public <T> int loop(int cnt, PcapHandler<T> callback, T user) {
+		int count = 0;
+		while ((cnt <= 0 || count < cnt) && this.next()) {
+			PcapPktHdr pktHdr = new PcapPktHdr(this.getCapLen(), this.getLen(), (int) this.getTvSec(), this.getTvUsec());
+			callback.nextPacket(user, pktHdr, this.getPacket());
+			count++;
+		}
+		return count;
+	}
+
+	/**
+	 * Returning current window, in the byte order of the file.
+	 * @return window buffer.
+	 */
+	public ByteBuffer getBuffer() {
+		return this.window;
+	}
+
+	/**
+	 * Returning offset of current packet data in current window.
+	 * @return data offset.
+	 */
+	public int getDataOffset() {
+		return this.offset + RECORD_HEADER_LENGTH;
+	}
+
+	/**
+	 * Returning current packet as a slice of the mapping.
+	 * @return packet buffer.
+	 */
+	public ByteBuffer getPacket() {
+		ByteBuffer packet = this.window.duplicate();
+		packet.limit(this.getDataOffset() + this.getCapLen()).position(this.getDataOffset());
+		return packet.slice();
+	}
+
+	/**
+	 * Returning ts_sec of current packet.
+	 * @return ts_sec.
+	 */
+	public long getTvSec() {
+		return this.window.getInt(this.offset) & 0xFFFFFFFFL;
+	}
+
+	/**
+	 * Returning ts_usec of current packet (nanoseconds if isNanosecond()).
+	 * @return ts_usec.
+	 */
+	public long getTvUsec() {
+		return this.window.getInt(this.offset + 4) & 0xFFFFFFFFL;
+	}
+
+	/**
+	 * Returning timestamp of current packet in microseconds since the epoch.
+	 * @return timestamp.
+	 */
+	public long getTimestamp() {
+		long fraction = this.getTvUsec();
+		return this.getTvSec() * 1000000L + (this.nanosecond ? fraction / 1000 : fraction);
+	}
+
+	/**
+	 * Returning capture length of current packet.
+	 * @return capture length.
+	 */
+	public int getCapLen() {
+		return this.window.getInt(this.offset + 8);
+	}
+
+	/**
+	 * Returning packet length of current packet.
+	 * @return packet length.
+	 */
+	public int getLen() {
+		return this.window.getInt(this.offset + 12);
+	}
+
+	/**
+	 * Returning file offset of the next record.
+	 * @return file offset.
+	 */
+	public long getPosition() {
+		return this.position;
+	}
+
+	public boolean isNanosecond() {
+		return this.nanosecond;
+	}
+
+	public int getSnapshotLength() {
+		return this.snapshotLength;
+	}
+
+	public DataLinkType getDataLinkType() {
+		return this.dataLinkType;
+	}
+
+	public long getSize() {
+		return this.size;
+	}
+
+	public synchronized long getAddress() {
+		return this.address;
+	}
+
+	public boolean isClosed() {
+		if (this.address == 0) {
+			return true;
+		}
+		return false;
+	}
+
+	/**
+	 * Unmap the file. Buffers handed out must not be used afterwards.
+	 */
+	public synchronized void close() {
+		if (this.address != 0) {
+			if (this.owner) {
+				closeFile(this.address);
+			}
+			this.address = 0;
+			this.window = null;
+		}
+	}
+
+	@Override
+	public String toString() {
+		return new StringBuilder().append("[Pointer Address: ")
+				.append(this.address)
+				.append(", Size: ").append(this.size)
+				.append(", Position: ").append(this.position)
+				.append("]").toString();
+	}
+
+	static {
+		try {
+			Class.forName("com.ardikars.jxnet.Jxnet");
+		} catch (ClassNotFoundException e) {
+			e.printStackTrace();
+		}
+	}
+
+}
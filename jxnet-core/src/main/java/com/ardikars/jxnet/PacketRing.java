@@ -0,0 +1,250 @@
+/**
+ * Copyright (C) 2017  Ardika Rommy Sanjaya
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+package com.ardikars.jxnet;
+
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+
+/**
+ * Linux TPACKET_V3 receive ring mapped into a direct buffer (Linux only).
+ * Each call to nextBlock() hands a whole block of packets to Java without copying;
+ * packets in the block are walked in Java and the block is returned to the kernel
+ * with releaseBlock().
+ * @author Ardika Rommy Sanjaya
+ * @since 1.1.5
+ */
+public final class PacketRing {
+
+	/* struct tpacket_block_desc */
+	public static final int BLOCK_STATUS_OFFSET = 8;
+	public static final int BLOCK_NUM_PKTS_OFFSET = 12;
+	public static final int BLOCK_FIRST_PKT_OFFSET = 16;
+	public static final int BLOCK_SEQ_NUM_OFFSET = 24;
+
+	/* struct tpacket3_hdr */
+	public static final int PKT_NEXT_OFFSET = 0;
+	public static final int PKT_SEC_OFFSET = 4;
+	public static final int PKT_NSEC_OFFSET = 8;
+	public static final int PKT_SNAPLEN_OFFSET = 12;
+	public static final int PKT_LEN_OFFSET = 16;
+	public static final int PKT_STATUS_OFFSET = 20;
+	public static final int PKT_MAC_OFFSET = 24;
+	public static final int PKT_RXHASH_OFFSET = 28;
+
+	private static native long openRing(String source, int blockSize, int blockCount, int timeout, boolean promisc, StringBuilder errbuf);
+
+	private static native ByteBuffer mapRing(long address);
+
+	private static native int nextBlock(long address, int timeout);
+
+	private static native void releaseBlock(long address);
+
+	private static native int setFilter(long address, BpfProgram fp);
+
+	private static native void closeRing(long address);
+
+	private long address;
+
+	private final ByteBuffer[] blocks;
+
+	private ByteBuffer block;
+
+	private int count;
+
+	private int index;
+
+	private int offset;
+
+	private PacketRing(long address, int blockSize, int blockCount) {
+		this.address = address;
+		this.blocks = new ByteBuffer[blockCount];
+		ByteBuffer ring = mapRing(address);
+		for (int i = 0; i < blockCount; i++) {
+			ring.limit((i + 1) * blockSize).position(i * blockSize);
+			this.blocks[i] = ring.slice().order(ByteOrder.nativeOrder());
+		}
+	}
+
+	/**
+	 * Open a TPACKET_V3 ring on a network interface.
+	 * @param source interface name.
+	 * @param blockSize block size in bytes, a multiple of the page size.
+	 * @param blockCount number of blocks.
+	 * @param timeout block retire timeout in milliseconds, 0 to let the kernel choose.
+	 * @param promisc true to put the interface in promiscuous mode.
+	 * @param errbuf error buffer.
+	 * @return PacketRing or null on error.
+	 */
+	public static PacketRing open(String source, int blockSize, int blockCount, int timeout, boolean promisc, StringBuilder errbuf) {
+		long address = openRing(source, blockSize, blockCount, timeout, promisc, errbuf);
+		if (address == 0) {
+			return null;
+		}
+		return new PacketRing(address, blockSize, blockCount);
+	}
+
+	/**
+	 * Attach a compiled filter to the ring socket.
+	 * @param fp compiled filter.
+	 * @return 0 on success, -1 on error.
+	 */
+	public int setFilter(BpfProgram fp) {
+		return setFilter(this.getAddress(), fp);
+	}
+
+	/**
+	 * Wait for the next block owned by user space.
+	 * The returned block stays valid until releaseBlock() or close() is called,
+	 * it must not be read after that.
+	 * @param timeout poll timeout in milliseconds, -1 to wait forever.
+	 * @return block buffer in native byte order, or null on timeout.
+	 */
+	public ByteBuffer nextBlock(int timeout) {
+		int ret = nextBlock(this.getAddress(), timeout);
+		if (ret == -2) {
+			throw new IllegalStateException("Poll on packet ring failed.");
+		}
+		if (ret < 0) {
+			return null;
+		}
+		this.block = this.blocks[ret];
+		this.count = this.block.getInt(BLOCK_NUM_PKTS_OFFSET);
+		this.index = -1;
+		this.offset = this.block.getInt(BLOCK_FIRST_PKT_OFFSET);
+		return this.block;
+	}
+
+	/**
+	 * Hand the current block back to the kernel.
+	 */
+	public void releaseBlock() {
+		if (this.block == null) {
+			throw new IllegalStateException("No block to release.");
+		}
+		releaseBlock(this.getAddress());
+		this.block = null;
+		this.count = 0;
+	}
+
+	/**
+	 * Returning number of packets in current block.
+	 * @return number of packets.
+	 */
+	public int getCount() {
+		return this.count;
+	}
+
+	/**
+	 * Move to the next packet in current block.
+	 * @return false if there are no more packets, true otherwise.
+	 */
+	public boolean next() {
+		if (this.index + 1 >= this.count) {
+			return false;
+		}
+		if (this.index >= 0) {
+			this.offset += this.block.getInt(this.offset + PKT_NEXT_OFFSET);
+		}
+		this.index++;
+		return true;
+	}
+
+	/**
+	 * Returning tv_sec of current packet.
+	 * @return tv_sec.
+	 */
+	public long getTvSec() {
+		return this.block.getInt(this.offset + PKT_SEC_OFFSET) & 0xFFFFFFFFL;
+	}
+
+	/**
+	 * Returning tv_nsec of current packet.
+	 * @return tv_nsec.
+	 */
+	public long getTvNsec() {
+		return this.block.getInt(this.offset + PKT_NSEC_OFFSET) & 0xFFFFFFFFL;
+	}
+
+	/**
+	 * Returning capture length of current packet.
+	 * @return capture length.
+	 */
+	public int getCapLen() {
+		return this.block.getInt(this.offset + PKT_SNAPLEN_OFFSET);
+	}
+
+	/**
+	 * Returning packet length of current packet.
+	 * @return packet length.
+	 */
+	public int getLen() {
+		return this.block.getInt(this.offset + PKT_LEN_OFFSET);
+	}
+
+	/**
+	 * Returning offset of current packet data in current block.
+	 * @return data offset.
+	 */
+	public int getDataOffset() {
+		return this.offset + (this.block.getShort(this.offset + PKT_MAC_OFFSET) & 0xFFFF);
+	}
+
+	public synchronized long getAddress() {
+		return this.address;
+	}
+
+	public boolean isClosed() {
+		if (this.address == 0) {
+			return true;
+		}
+		return false;
+	}
+
+	/**
+	 * Unmap the ring and close the socket.
+	 * Blocks returned by nextBlock() point into the unmapped ring and must not be used after close.
+	 */
+	public synchronized void close() {
+		if (this.address != 0) {
+			closeRing(this.address);
+			this.address = 0;
+			this.block = null;
+			this.count = 0;
+			for (int i = 0; i < this.blocks.length; i++) {
+				this.blocks[i] = null;
+			}
+		}
+	}
+
+	@Override
+	public String toString() {
+		return new StringBuilder().append("[Pointer Address: ")
+				.append(this.address)
+				.append(", Blocks: ").append(this.blocks.length)
+				.append("]").toString();
+	}
+
+	static {
+		try {
+			Class.forName("com.ardikars.jxnet.Jxnet");
+		} catch (ClassNotFoundException e) {
+			e.printStackTrace();
+		}
+	}
+
+}
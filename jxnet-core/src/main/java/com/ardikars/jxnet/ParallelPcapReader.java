@@ -0,0 +1,296 @@
+/**
+ * Copyright (C) 2017  Ardika Rommy Sanjaya
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+package com.ardikars.jxnet;
+
+import com.ardikars.jxnet.exception.JxnetException;
+
+import java.nio.ByteBuffer;
+import java.util.ArrayList;
+import java.util.List;
+import java.util.concurrent.Callable;
+import java.util.concurrent.ExecutionException;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+import java.util.concurrent.Future;
+import java.util.function.Consumer;
+
+/**
+ * Read one classic pcap savefile with several threads.
+ * The file is mapped once (see MappedPcap) and split into record-aligned ranges;
+ * each range is filtered and handed to the callback by a worker thread. The filter
+ * is compiled once on the calling thread, since pcap_compile() is not reentrant,
+ * and the compiled program is shared by the workers.
+ * @author Ardika Rommy Sanjaya
+ * @since 1.1.5
+ */
+public final class ParallelPcapReader {
+
+	public static final int DEFAULT_RANGE_SIZE = 64 * 1024 * 1024;
+
+	/**
+	 * Turns a packet into a value, called from worker threads.
+	 * @param <R> result type.
+	 */
+	@FunctionalInterface
+	public interface Decoder<R> {
+
+		/**
+		 * Decode a packet.
+		 * @param h packet header.
+		 * @param bytes packet buffer, a slice of the mapped file.
+		 * @return decoded value, or null to drop the packet.
+		 */
+		R decode(PcapPktHdr h, ByteBuffer bytes);
+
+	}
+
+	private final MappedPcap file;
+
+	private final int threads;
+
+	private final long[] ranges;
+
+	private BpfProgram program;
+
+	private ParallelPcapReader(MappedPcap file, int threads, int rangeSize) {
+		this.file = file;
+		this.threads = threads;
+		this.ranges = file.partition((int) Math.max(threads, Math.min(Integer.MAX_VALUE - 1, file.getSize() / rangeSize)));
+	}
+
+	/**
+	 * Open a classic pcap savefile for parallel reading, split into ranges of about 64MB.
+	 * @param path savefile path.
+	 * @param threads number of worker threads.
+	 * @param errbuf error buffer.
+	 * @return ParallelPcapReader or null on error.
+	 */
+	public static ParallelPcapReader open(String path, int threads, StringBuilder errbuf) {
+		return open(path, threads, DEFAULT_RANGE_SIZE, errbuf);
+	}
+
+	/**
+	 * Open a classic pcap savefile for parallel reading.
+	 * @param path savefile path.
+	 * @param threads number of worker threads.
+	 * @param rangeSize approximate size of the ranges handed to the workers.
+	 * @param errbuf error buffer.
+	 * @return ParallelPcapReader or null on error.
+	 */
+	public static ParallelPcapReader open(String path, int threads, int rangeSize, StringBuilder errbuf) {
+		if (threads < 1 || rangeSize < 1) {
+			throw new IllegalArgumentException("Number of threads and range size must be positive.");
+		}
+		MappedPcap file = MappedPcap.open(path, errbuf);
+		if (file == null) {
+			return null;
+		}
+		return new ParallelPcapReader(file, threads, rangeSize);
+	}
+
+	/**
+	 * Set a filter expression, compiled with PcapCompileNoPcap. Must not be called while a loop is running.
+	 * @param filter filter expression, or null to read every packet.
+	 * @param optimize optimize.
+	 * @param netmask netmask.
+	 * @return 0 on success, -1 if the expression does not compile.
+	 */
+	public int setFilter(String filter, int optimize, int netmask) {
+		BpfProgram fp = null;
+		if (filter != null) {
+			fp = new BpfProgram();
+			if (Jxnet.PcapCompileNoPcap(this.file.getSnapshotLength(), this.file.getDataLinkType().getValue(),
+					fp, filter, optimize, netmask) != 0) {
+				return -1;
+			}
+			fp.jit();
+		}
+		this.freeProgram();
+		this.program = fp;
+		return 0;
+	}
+
+	private void freeProgram() {
+		if (this.program != null) {
+			Jxnet.PcapFreeCode(this.program);
+			this.program = null;
+		}
+	}
+
+	/**
+	 * Returning number of ranges the file is split into.
+	 * @return number of ranges.
+	 */
+	public int getRangeCount() {
+		return this.ranges.length - 1;
+	}
+
+	private interface RangeTask<V> {
+
+		V run(MappedPcap cursor, BpfProgram fp);
+
+	}
+
+	private <V> Callable<V> newTask(final int range, final RangeTask<V> task) {
+		final BpfProgram fp = this.program;
+		return new Callable<V>() {
+			@Override
+			public V call() {
+				MappedPcap cursor = file.range(ranges[range], ranges[range + 1]);
+				try {
+					return task.run(cursor, fp);
+				} finally {
+					cursor.close();
+				}
+			}
+		};
+	}
+
+	private static boolean accept(MappedPcap cursor, BpfProgram fp, ByteBuffer packet) {
+		return fp == null || fp.matches(packet, cursor.getLen());
+	}
+
+	private static PcapPktHdr header(MappedPcap cursor) {
+		return new PcapPktHdr(cursor.getCapLen(), cursor.getLen(), (int) cursor.getTvSec(), cursor.getTvUsec());
+	}
+
+	private static <V> V get(Future<V> future) {
+		try {
+			return future.get();
+		} catch (InterruptedException e) {
+			Thread.currentThread().interrupt();
+			throw new JxnetException(e);
+		} catch (ExecutionException e) {
+			if (e.getCause() instanceof RuntimeException) {
+				throw (RuntimeException) e.getCause();
+			}
+			throw new JxnetException(e.getCause());
+		}
+	}
+
+	/**
+	 * Read every range in parallel. The callback is called concurrently from
+	 * the worker threads, in no particular order, and must be thread safe.
+	 * @param callback callback function.
+	 * @param user arg.
+	 * @param <T> type.
+	 * @return number of packets handed to the callback.
+	 */
+	public <T> long loop(final PcapHandler<T> callback, final T user) {
+		ExecutorService executor = Executors.newFixedThreadPool(this.threads);
+		try {
+			List<Future<Long>> futures = new ArrayList<Future<Long>>(this.getRangeCount());
+			for (int i = 0; i < this.getRangeCount(); i++) {
+				futures.add(executor.submit(this.newTask(i, new RangeTask<Long>() {
+					@Override
+					public Long run(MappedPcap cursor, BpfProgram fp) {
+						long count = 0;
+						while (cursor.next()) {
+							ByteBuffer packet = cursor.getPacket();
+							if (accept(cursor, fp, packet)) {
+								callback.nextPacket(user, header(cursor), packet);
+								count++;
+							}
+						}
+						return count;
+					}
+				})));
+			}
+			long count = 0;
+			for (Future<Long> future : futures) {
+				count += get(future);
+			}
+			return count;
+		} finally {
+			executor.shutdownNow();
+		}
+	}
+
+	/**
+	 * Filter and decode every range in parallel, then merge the results in file order.
+	 * Only a few ranges per thread are decoded ahead of the consumer, which runs on the
+	 * calling thread.
+	 * @param decoder decoder, called concurrently from the worker threads.
+	 * @param consumer receives decoded values in file order.
+	 * @param <R> result type.
+	 * @return number of values handed to the consumer.
+	 */
+	public <R> long loopOrdered(final Decoder<R> decoder, Consumer<R> consumer) {
+		ExecutorService executor = Executors.newFixedThreadPool(this.threads);
+		try {
+			RangeTask<List<R>> task = new RangeTask<List<R>>() {
+				@Override
+				public List<R> run(MappedPcap cursor, BpfProgram fp) {
+					List<R> values = new ArrayList<R>();
+					while (cursor.next()) {
+						ByteBuffer packet = cursor.getPacket();
+						if (accept(cursor, fp, packet)) {
+							R value = decoder.decode(header(cursor), packet);
+							if (value != null) {
+								values.add(value);
+							}
+						}
+					}
+					return values;
+				}
+			};
+			int ahead = this.threads * 2;
+			List<Future<List<R>>> futures = new ArrayList<Future<List<R>>>(this.getRangeCount());
+			for (int i = 0; i < this.getRangeCount() && i < ahead; i++) {
+				futures.add(executor.submit(this.newTask(i, task)));
+			}
+			long count = 0;
+			for (int i = 0; i < this.getRangeCount(); i++) {
+				List<R> values = get(futures.get(i));
+				futures.set(i, null);
+				if (i + ahead < this.getRangeCount()) {
+					futures.add(executor.submit(this.newTask(i + ahead, task)));
+				}
+				for (R value : values) {
+					consumer.accept(value);
+				}
+				count += values.size();
+			}
+			return count;
+		} finally {
+			executor.shutdownNow();
+		}
+	}
+
+	public boolean isClosed() {
+		return this.file.isClosed();
+	}
+
+	/**
+	 * Unmap the file and free the filter. Must not be called while a loop is running.
+	 */
+	public void close() {
+		this.freeProgram();
+		this.file.close();
+	}
+
+	@Override
+	public String toString() {
+		return new StringBuilder().append("[File: ")
+				.append(this.file)
+				.append(", Threads: ").append(this.threads)
+				.append(", Ranges: ").append(this.getRangeCount())
+				.append("]").toString();
+	}
+
+}
@@ -29,6 +29,8 @@ public final class Pcap {
 
 	private long address;
 
+	private long filterAddress;
+
 	private Pcap() {
 
 	}
@@ -0,0 +1,217 @@
+/**
+ * Copyright (C) 2017  Ardika Rommy Sanjaya
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+package com.ardikars.jxnet;
+
+import com.ardikars.jxnet.exception.PcapDumperCloseException;
+
+import java.nio.ByteBuffer;
+
+/**
+ * Savefile writer that never blocks the capture thread (not supported on Windows).
+ * Packets are copied into preallocated, page aligned buffers; a native writer thread
+ * flushes every full buffer with a single write(), optionally through O_DIRECT.
+ * When every buffer is waiting for the disk, packets are dropped and counted
+ * (see getDropped()) instead of stalling the capture.
+ * dump(), dispatch() and loop() must be called from a single thread.
+ * @author Ardika Rommy Sanjaya
+ * @since 1.1.5
+ */
+public final class PcapAsyncDumper {
+
+	public static final int DEFAULT_BUFFER_SIZE = 4 * 1024 * 1024;
+
+	public static final int DEFAULT_BUFFER_COUNT = 16;
+
+	private static native long openDumper(Pcap pcap, String fname, int bufferSize, int bufferCount,
+										  boolean direct, long preallocate, StringBuilder errbuf);
+
+	private static native int dump(long address, int tvSec, int tvUsec, int caplen, int len, ByteBuffer buf, int offset);
+
+	private static native int dispatch(long address, Pcap pcap, int cnt, boolean loop);
+
+	private static native void stats(long address, long[] stats);
+
+	private static native int closeDumper(long address, StringBuilder errbuf);
+
+	private long address;
+
+	private final long[] stats = new long[4];
+
+	private PcapAsyncDumper(long address) {
+		this.address = address;
+	}
+
+	/**
+	 * Open a savefile with 16 buffers of 4MB, without O_DIRECT.
+	 * @param pcap pcap object, for the link type and snapshot length.
+	 * @param fname savefile path.
+	 * @param errbuf error buffer.
+	 * @return PcapAsyncDumper or null on error.
+	 */
+	public static PcapAsyncDumper open(Pcap pcap, String fname, StringBuilder errbuf) {
+		return open(pcap, fname, DEFAULT_BUFFER_SIZE, DEFAULT_BUFFER_COUNT, false, 0, errbuf);
+	}
+
+	/**
+	 * Open a savefile.
+	 * @param pcap pcap object, for the link type and snapshot length.
+	 * @param fname savefile path.
+	 * @param bufferSize size of each buffer, a multiple of 4096.
+	 * @param bufferCount number of buffers, at least 2.
+	 * @param direct true to write with O_DIRECT (Linux), bypassing the page cache.
+	 * @param preallocate number of bytes to reserve on disk with fallocate(), 0 for none.
+	 * @param errbuf error buffer.
+	 * @return PcapAsyncDumper or null on error.
+	 */
+	public static PcapAsyncDumper open(Pcap pcap, String fname, int bufferSize, int bufferCount,
+									   boolean direct, long preallocate, StringBuilder errbuf) {
+		long address = openDumper(pcap, fname, bufferSize, bufferCount, direct, preallocate, errbuf);
+		if (address == 0) {
+			return null;
+		}
+		return new PcapAsyncDumper(address);
+	}
+
+	/**
+	 * Queue a packet from a direct buffer, reading the remaining bytes (position to limit).
+	 * @param h packet header.
+	 * @param buf direct buffer.
+	 * @return true if queued, false if dropped.
+	 */
+	public boolean dump(PcapPktHdr h, ByteBuffer buf) {
+		return dump(this.getAddress(), h.getTvSec(), (int) h.getTvUsec(), buf.remaining(), h.getLen(),
+				buf, buf.position()) == 0;
+	}
+
+	/**
+	 * Queue a packet without reading a PcapPktHdr.
+	 * @param tvSec tv_sec.
+	 * @param tvUsec tv_usec.
+	 * @param caplen capture length.
+	 * @param len packet length.
+	 * @param buf direct buffer.
+	 * @param offset offset of the packet in buf.
+	 * @return true if queued, false if dropped.
+	 */
+	public boolean dump(int tvSec, int tvUsec, int caplen, int len, ByteBuffer buf, int offset) {
+		return dump(this.getAddress(), tvSec, tvUsec, caplen, len, buf, offset) == 0;
+	}
+
+	/**
+	 * Run PcapDispatch() writing every packet straight from the native callback,
+	 * without a call into Java per packet. A filter set with PcapSetJitFilter applies.
+	 * @param pcap pcap object.
+	 * @param cnt maximum number of packets.
+	 * @return PcapDispatch() return value.
+	 */
+	public int dispatch(Pcap pcap, int cnt) {
+		return dispatch(this.getAddress(), pcap, cnt, false);
+	}
+
+	/**
+	 * Run PcapLoop() writing every packet straight from the native callback,
+	 * without a call into Java per packet. A filter set with PcapSetJitFilter applies.
+	 * @param pcap pcap object.
+	 * @param cnt number of packets, -1 or 0 for infinity.
+	 * @return PcapLoop() return value.
+	 */
+	public int loop(Pcap pcap, int cnt) {
+		return dispatch(this.getAddress(), pcap, cnt, true);
+	}
+
+	private long stat(int index) {
+		synchronized (this.stats) {
+			stats(this.getAddress(), this.stats);
+			return this.stats[index];
+		}
+	}
+
+	/**
+	 * Returning number of full buffers waiting for the writer thread.
+	 * @return queue depth.
+	 */
+	public long getQueueDepth() {
+		return this.stat(0);
+	}
+
+	/**
+	 * Returning number of bytes written to the file so far.
+	 * @return bytes written.
+	 */
+	public long getBytesWritten() {
+		return this.stat(1);
+	}
+
+	/**
+	 * Returning number of packets dropped because every buffer was full.
+	 * @return dropped packets.
+	 */
+	public long getDropped() {
+		return this.stat(2);
+	}
+
+	/**
+	 * Returning number of packets queued.
+	 * @return queued packets.
+	 */
+	public long getPackets() {
+		return this.stat(3);
+	}
+
+	public synchronized long getAddress() {
+		return this.address;
+	}
+
+	public boolean isClosed() {
+		if (this.address == 0) {
+			return true;
+		}
+		return false;
+	}
+
+	/**
+	 * Write the queued packets and close the file.
+	 * @throws PcapDumperCloseException a write failed.
+	 */
+	public synchronized void close() {
+		if (this.address != 0) {
+			StringBuilder errbuf = new StringBuilder();
+			int r = closeDumper(this.address, errbuf);
+			this.address = 0;
+			if (r != 0) {
+				throw new PcapDumperCloseException(errbuf.toString());
+			}
+		}
+	}
+
+	@Override
+	public String toString() {
+		return new StringBuilder().append("[Pointer Address: ")
+				.append(this.address)
+				.append("]").toString();
+	}
+
+	static {
+		try {
+			Class.forName("com.ardikars.jxnet.Jxnet");
+		} catch (ClassNotFoundException e) {
+			e.printStackTrace();
+		}
+	}
+
+}
@@ -0,0 +1,290 @@
+/**
+ * Copyright (C) 2017  Ardika Rommy Sanjaya
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+package com.ardikars.jxnet;
+
+import java.lang.invoke.MethodHandle;
+import java.lang.invoke.MethodHandles;
+import java.lang.invoke.MethodType;
+import java.lang.reflect.Field;
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+
+/**
+ * Capture on a native thread into a single-producer/single-consumer off-heap ring.
+ * The native thread runs PcapDispatch() and copies every packet into the ring; a single Java
+ * thread consumes the ring through a direct buffer, without JNI calls on the fast path.
+ * Records use the PcapPktBatch layout, 16 byte aligned. When the ring is full, packets are
+ * dropped and counted (see getDropped()).
+ * The pcap handle belongs to the capture thread until stop() returns.
+ * @author Ardika Rommy Sanjaya
+ * @since 1.1.5
+ */
+public final class PcapCaptureRing {
+
+	public static final int HEADER_LENGTH = 16;
+
+	/* Shared memory layout, see capture_ring.c */
+	public static final int HEAD_OFFSET = 0;
+	public static final int TAIL_OFFSET = 64;
+	public static final int STATUS_OFFSET = 128;
+	public static final int DROPPED_OFFSET = 136;
+	public static final int DATA_OFFSET = 192;
+
+	private static final int WRAP = 0xFFFFFFFF;
+
+	private static final MethodHandle GET_LONG_VOLATILE;
+
+	private static final MethodHandle PUT_ORDERED_LONG;
+
+	private static native long startRing(Pcap pcap, int capacity);
+
+	private static native ByteBuffer mapRing(long address);
+
+	private static native long sharedAddress(long address);
+
+	private static native long loadVolatile(long address);
+
+	private static native void storeOrdered(long address, long value);
+
+	private static native void stopRing(long address);
+
+	private static native void closeRing(long address);
+
+	private long address;
+
+	private final long shared;
+
+	private final ByteBuffer buffer;
+
+	private final int mask;
+
+	private long tail;
+
+	private int offset;
+
+	private int length;
+
+	private PcapCaptureRing(long address, int capacity) {
+		this.address = address;
+		this.shared = sharedAddress(address);
+		this.buffer = mapRing(address).order(ByteOrder.nativeOrder());
+		this.mask = capacity - 1;
+	}
+
+	/**
+	 * Start a capture thread on an activated handle.
+	 * @param pcap pcap object.
+	 * @param capacity ring capacity in bytes, a power of two.
+	 * @return capture ring.
+	 */
+	public static PcapCaptureRing start(Pcap pcap, int capacity) {
+		return new PcapCaptureRing(startRing(pcap, capacity), capacity);
+	}
+
+	/**
+	 * Release the current packet and move to the next one.
+	 * @return false if the ring is empty, true otherwise.
+	 */
+	public boolean next() {
+		if (this.length > 0) {
+			this.tail += this.length;
+			this.length = 0;
+			this.storeTail();
+		}
+		if (this.tail == this.loadHead()) {
+			return false;
+		}
+		int pos = (int) (this.tail & this.mask);
+		if (this.buffer.getInt(DATA_OFFSET + pos + 8) == WRAP) {
+			this.tail += this.mask + 1 - pos;
+			pos = 0;
+		}
+		this.offset = DATA_OFFSET + pos;
+		this.length = (HEADER_LENGTH + this.getCapLen() + 15) & ~15;
+		return true;
+	}
+
+	/**
+	 * Returning true if the capture thread is stopped and every packet has been consumed.
+	 * @return true if finished.
+	 */
+	public boolean isFinished() {
+		if (!this.isStopped()) {
+			return false;
+		}
+		return this.tail + this.length == this.loadHead();
+	}
+
+	/**
+	 * Returning true if the capture thread stopped because of an error.
+	 * @return true on error.
+	 */
+	public boolean isError() {
+		return this.loadLong(STATUS_OFFSET) < 0;
+	}
+
+	/**
+	 * Returning number of packets dropped because the ring was full.
+	 * @return dropped packets.
+	 */
+	public long getDropped() {
+		return this.buffer.getLong(DROPPED_OFFSET);
+	}
+
+	/**
+	 * Returning backing buffer, in native byte order.
+	 * @return direct buffer.
+	 */
+	public ByteBuffer getBuffer() {
+		return this.buffer;
+	}
+
+	/**
+	 * Returning tv_sec of current packet.
+	 * @return tv_sec.
+	 */
+	public int getTvSec() {
+		return this.buffer.getInt(this.offset);
+	}
+
+	/**
+	 * Returning tv_usec of current packet.
+	 * @return tv_usec.
+	 */
+	public long getTvUsec() {
+		return this.buffer.getInt(this.offset + 4) & 0xFFFFFFFFL;
+	}
+
+	/**
+	 * Returning capture length of current packet.
+	 * @return capture length.
+	 */
+	public int getCapLen() {
+		return this.buffer.getInt(this.offset + 8);
+	}
+
+	/**
+	 * Returning packet length of current packet.
+	 * @return packet length.
+	 */
+	public int getLen() {
+		return this.buffer.getInt(this.offset + 12);
+	}
+
+	/**
+	 * Returning offset of current packet data in backing buffer.
+	 * @return data offset.
+	 */
+	public int getDataOffset() {
+		return this.offset + HEADER_LENGTH;
+	}
+
+	/**
+	 * Stop the capture thread and wait for it; packets already in the ring can still be consumed.
+	 */
+	public synchronized void stop() {
+		stopRing(this.getAddress());
+	}
+
+	/**
+	 * Stop the capture thread and free the ring.
+	 */
+	public synchronized void close() {
+		if (this.address != 0) {
+			closeRing(this.address);
+			this.address = 0;
+		}
+	}
+
+	public synchronized long getAddress() {
+		return this.address;
+	}
+
+	public boolean isClosed() {
+		if (this.address == 0) {
+			return true;
+		}
+		return false;
+	}
+
+	private boolean isStopped() {
+		return this.loadLong(STATUS_OFFSET) != 0;
+	}
+
+	private long loadHead() {
+		return this.loadLong(HEAD_OFFSET);
+	}
+
+	private long loadLong(int offset) {
+		if (GET_LONG_VOLATILE == null) {
+			return loadVolatile(this.shared + offset);
+		}
+		try {
+			return (long) GET_LONG_VOLATILE.invokeExact((Object) null, this.shared + offset);
+		} catch (Throwable e) {
+			throw new IllegalStateException(e);
+		}
+	}
+
+	private void storeTail() {
+		if (PUT_ORDERED_LONG == null) {
+			storeOrdered(this.shared + TAIL_OFFSET, this.tail);
+			return;
+		}
+		try {
+			PUT_ORDERED_LONG.invokeExact((Object) null, this.shared + TAIL_OFFSET, this.tail);
+		} catch (Throwable e) {
+			throw new IllegalStateException(e);
+		}
+	}
+
+	@Override
+	public String toString() {
+		return new StringBuilder().append("[Pointer Address: ")
+				.append(this.address)
+				.append(", Capacity: ").append(this.mask + 1)
+				.append("]").toString();
+	}
+
+	static {
+		try {
+			Class.forName("com.ardikars.jxnet.Jxnet");
+		} catch (ClassNotFoundException e) {
+			e.printStackTrace();
+		}
+		MethodHandle getLongVolatile = null;
+		MethodHandle putOrderedLong = null;
+		try {
+			Class<?> unsafeClass = Class.forName("sun.misc.Unsafe");
+			Field field = unsafeClass.getDeclaredField("theUnsafe");
+			field.setAccessible(true);
+			Object unsafe = field.get(null);
+			MethodHandles.Lookup lookup = MethodHandles.lookup();
+			getLongVolatile = lookup.findVirtual(unsafeClass, "getLongVolatile",
+					MethodType.methodType(long.class, Object.class, long.class)).bindTo(unsafe);
+			putOrderedLong = lookup.findVirtual(unsafeClass, "putOrderedLong",
+					MethodType.methodType(void.class, Object.class, long.class, long.class)).bindTo(unsafe);
+		} catch (Exception e) {
+			getLongVolatile = null;
+			putOrderedLong = null;
+		}
+		GET_LONG_VOLATILE = getLongVolatile;
+		PUT_ORDERED_LONG = putOrderedLong;
+	}
+
+}
@@ -0,0 +1,197 @@
+/**
+ * Copyright (C) 2017  Ardika Rommy Sanjaya
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+package com.ardikars.jxnet;
+
+/**
+ * A group of live capture handles on one device joined to the same PACKET_FANOUT group (Linux only).
+ * The kernel spreads the traffic of the device over the members according to the fanout mode,
+ * and each member is read by its own worker thread.
+ * @author Ardika Rommy Sanjaya
+ * @since 1.1.5
+ */
+public final class PcapFanoutGroup {
+
+	private final int groupId;
+
+	private final PcapFanoutMode mode;
+
+	private final Pcap[] members;
+
+	private Thread[] workers;
+
+	private PcapFanoutGroup(int groupId, PcapFanoutMode mode, Pcap[] members) {
+		this.groupId = groupId;
+		this.mode = mode;
+		this.members = members;
+	}
+
+	/**
+	 * Open size handles on source and join them to one fanout group.
+	 * @param source device name.
+	 * @param size number of members.
+	 * @param groupId fanout group id, 0 to 65535.
+	 * @param mode fanout mode.
+	 * @param snaplen snapshot length.
+	 * @param promisc promiscuous mode.
+	 * @param timeout read timeout in milliseconds.
+	 * @param errbuf error buffer.
+	 * @return fanout group or null on error.
+	 */
+	public static PcapFanoutGroup open(String source, int size, int groupId, PcapFanoutMode mode,
+									   int snaplen, PromiscuousMode promisc, int timeout, StringBuilder errbuf) {
+		if (size <= 0) {
+			throw new IllegalArgumentException("Group size must be greater than zero.");
+		}
+		Pcap[] members = new Pcap[size];
+		for (int i = 0; i < size; i++) {
+			Pcap pcap = Jxnet.PcapCreate(source, errbuf);
+			if (pcap == null) {
+				close(members);
+				return null;
+			}
+			members[i] = pcap;
+			if (Jxnet.PcapSetSnaplen(pcap, snaplen) != 0
+					|| Jxnet.PcapSetPromisc(pcap, promisc.getValue()) != 0
+					|| Jxnet.PcapSetTimeout(pcap, timeout) != 0
+					|| Jxnet.PcapActivate(pcap) < 0) {
+				errbuf.setLength(0);
+				errbuf.append(Jxnet.PcapGetErr(pcap));
+				close(members);
+				return null;
+			}
+			if (Jxnet.PcapSetFanout(pcap, groupId, mode.getValue()) != 0) {
+				errbuf.setLength(0);
+				errbuf.append("Unable to join fanout group ").append(groupId)
+						.append(" in ").append(mode).append(" mode.");
+				close(members);
+				return null;
+			}
+		}
+		return new PcapFanoutGroup(groupId, mode, members);
+	}
+
+	/**
+	 * Start one worker thread per member, each running PcapLoop() on its own handle.
+	 * The callback is invoked concurrently from all workers.
+	 * @param cnt maximum iteration per member, -1 to infinite.
+	 * @param callback callback function.
+	 * @param user arg.
+	 * @param <T> arg type.
+	 */
+	public synchronized <T> void start(final int cnt, final PcapHandler<T> callback, final T user) {
+		if (this.workers != null) {
+			throw new IllegalStateException("Fanout group already started.");
+		}
+		this.workers = new Thread[this.members.length];
+		for (int i = 0; i < this.members.length; i++) {
+			final Pcap pcap = this.members[i];
+			this.workers[i] = new Thread(new Runnable() {
+				@Override
+				public void run() {
+					Jxnet.PcapLoop(pcap, cnt, callback, user);
+				}
+			}, "jxnet-fanout-" + this.groupId + "-" + i);
+			this.workers[i].start();
+		}
+	}
+
+	/**
+	 * Break the loop of every member and wait for the workers to finish.
+	 * @throws InterruptedException interrupted while waiting.
+	 */
+	public synchronized void stop() throws InterruptedException {
+		if (this.workers == null) {
+			return;
+		}
+		for (Pcap pcap : this.members) {
+			Jxnet.PcapBreakLoop(pcap);
+		}
+		for (Thread worker : this.workers) {
+			worker.join();
+		}
+		this.workers = null;
+	}
+
+	/**
+	 * Returning statistics of a member.
+	 * @param index member index.
+	 * @return statistics, or null if they could not be read.
+	 */
+	public PcapStat getStats(int index) {
+		PcapStat stat = new PcapStat();
+		if (Jxnet.PcapStats(this.members[index], stat) != 0) {
+			return null;
+		}
+		return stat;
+	}
+
+	/**
+	 * Returning statistics of every member.
+	 * @return statistics, indexed by member.
+	 */
+	public PcapStat[] getStats() {
+		PcapStat[] stats = new PcapStat[this.members.length];
+		for (int i = 0; i < stats.length; i++) {
+			stats[i] = this.getStats(i);
+		}
+		return stats;
+	}
+
+	public Pcap getMember(int index) {
+		return this.members[index];
+	}
+
+	public int size() {
+		return this.members.length;
+	}
+
+	public int getGroupId() {
+		return this.groupId;
+	}
+
+	public PcapFanoutMode getMode() {
+		return this.mode;
+	}
+
+	/**
+	 * Stop the workers and close every member.
+	 * @throws InterruptedException interrupted while waiting for the workers.
+	 */
+	public void close() throws InterruptedException {
+		this.stop();
+		close(this.members);
+	}
+
+	private static void close(Pcap[] members) {
+		for (Pcap pcap : members) {
+			if (pcap != null && !pcap.isClosed()) {
+				Jxnet.PcapClose(pcap);
+			}
+		}
+	}
+
+	@Override
+	public String toString() {
+		return new StringBuilder()
+				.append("[Group: ").append(this.groupId)
+				.append(", Mode: ").append(this.mode)
+				.append(", Members: ").append(this.members.length)
+				.append("]").toString();
+	}
+
+}
@@ -0,0 +1,512 @@
+/**
+ * Copyright (C) 2017  Ardika Rommy Sanjaya
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+package com.ardikars.jxnet;
+
+import java.io.IOException;
+import java.io.RandomAccessFile;
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+import java.nio.channels.FileChannel;
+import java.util.ArrayList;
+import java.util.List;
+
+/**
+ * Classic pcap and pcapng savefile reader written in Java, for offline processing
+ * on hosts without the native library. The file is mapped with FileChannel.map()
+ * in chunks of at most 2GB, remapped at the current record when a record crosses
+ * the end of a chunk, and packets are handed out as slices of the mapping.
+ * Byte-swapped files and sections are read in their own byte order. Of the pcapng
+ * blocks, section headers, interface descriptions (link type, snapshot length,
+ * if_tsresol and if_tsoffset), enhanced, simple and obsolete packet blocks are read,
+ * the others are skipped.
+ * Slices stay valid after close(), until they are garbage collected.
+ * @author Ardika Rommy Sanjaya
+ * @since 1.1.5
+ */
+public final class PcapFileReader {
+
+	public static final int DEFAULT_CHUNK_SIZE = Integer.MAX_VALUE;
+
+	private static final int FILE_HEADER_LENGTH = 24;
+	private static final int RECORD_HEADER_LENGTH = 16;
+
+	private static final int MAGIC = 0xa1b2c3d4;
+	private static final int MAGIC_NSEC = 0xa1b23c4d;
+
+	private static final int SECTION_HEADER_BLOCK = 0x0a0d0d0a;
+	private static final int INTERFACE_DESCRIPTION_BLOCK = 0x00000001;
+	private static final int PACKET_BLOCK = 0x00000002;
+	private static final int SIMPLE_PACKET_BLOCK = 0x00000003;
+	private static final int ENHANCED_PACKET_BLOCK = 0x00000006;
+	private static final int BYTE_ORDER_MAGIC = 0x1a2b3c4d;
+
+	private static final int OPT_ENDOFOPT = 0;
+	private static final int OPT_IF_TSRESOL = 9;
+	private static final int OPT_IF_TSOFFSET = 14;
+
+	private static final class Interface {
+
+		private final DataLinkType dataLinkType;
+
+		private final int snapshotLength;
+
+		private int resolution = 6;
+
+		private boolean binary;
+
+		private long offset;
+
+		private Interface(DataLinkType dataLinkType, int snapshotLength) {
+			this.dataLinkType = dataLinkType;
+			this.snapshotLength = snapshotLength;
+		}
+
+	}
+
+	private final RandomAccessFile file;
+
+	private final FileChannel channel;
+
+	private final long size;
+
+	private final int chunkSize;
+
+	private final boolean ng;
+
+	private final List<Interface> interfaces = new ArrayList<Interface>();
+
+	private ByteOrder order;
+
+	private ByteBuffer chunk;
+
+	private long chunkStart;
+
+	private long position;
+
+	private Interface current;
+
+	private int dataOffset = -1;
+
+	private int caplen;
+
+	private int len;
+
+	private long tvSec;
+
+	private int tvNsec;
+
+	private PcapFileReader(RandomAccessFile file, int chunkSize) throws IOException {
+		this.file = file;
+		this.channel = file.getChannel();
+		this.size = this.channel.size();
+		this.chunkSize = chunkSize;
+		if (this.size < 12) {
+			throw new IOException("File is too short.");
+		}
+		this.ensureChunk(0, 12);
+		this.chunk.order(ByteOrder.LITTLE_ENDIAN);
+		int magic = this.chunk.getInt(0);
+		if (magic == SECTION_HEADER_BLOCK) {
+			this.ng = true;
+			this.position = 0;
+			return;
+		}
+		this.ng = false;
+		if (magic == MAGIC || magic == MAGIC_NSEC) {
+			this.order = ByteOrder.LITTLE_ENDIAN;
+		} else {
+			this.order = ByteOrder.BIG_ENDIAN;
+			this.chunk.order(ByteOrder.BIG_ENDIAN);
+			magic = this.chunk.getInt(0);
+			if (magic != MAGIC && magic != MAGIC_NSEC) {
+				throw new IOException("Not a pcap or pcapng file.");
+			}
+		}
+		if (this.size < FILE_HEADER_LENGTH) {
+			throw new IOException("File is too short.");
+		}
+		this.ensureChunk(0, FILE_HEADER_LENGTH);
+		Interface iface = new Interface(DataLinkType.valueOf((short) this.chunk.getInt(20)), this.chunk.getInt(16));
+		iface.resolution = magic == MAGIC_NSEC ? 9 : 6;
+		this.interfaces.add(iface);
+		this.current = iface;
+		this.position = FILE_HEADER_LENGTH;
+	}
+
+	/**
+	 * Open a classic pcap or pcapng savefile.
+	 * @param path savefile path.
+	 * @return PcapFileReader.
+	 * @throws IOException the file could not be opened or is not a savefile.
+	 */
+	public static PcapFileReader open(String path) throws IOException {
+		return open(path, DEFAULT_CHUNK_SIZE);
+	}
+
+	/**
+	 * Open a classic pcap or pcapng savefile.
+	 * @param path savefile path.
+	 * @param chunkSize size of the mappings over the file, grown for larger records.
+	 * @return PcapFileReader.
+	 * @throws IOException the file could not be opened or is not a savefile.
+	 */
+	public static PcapFileReader open(String path, int chunkSize) throws IOException {
+		if (chunkSize < FILE_HEADER_LENGTH) {
+			throw new IllegalArgumentException("Chunk size is too small.");
+		}
+		RandomAccessFile file = new RandomAccessFile(path, "r");
+		try {
+			return new PcapFileReader(file, chunkSize);
+		} catch (IOException e) {
+			file.close();
+			throw e;
+		}
+	}
+
+	private void ensureChunk(long position, int length) throws IOException {
+		if (this.chunk == null || position < this.chunkStart
+				|| position + length > this.chunkStart + this.chunk.capacity()) {
+			long remaining = this.size - position;
+			int chunkLength = (int) Math.min(Math.max(this.chunkSize, length), remaining);
+			this.chunk = this.channel.map(FileChannel.MapMode.READ_ONLY, position, chunkLength);
+			this.chunkStart = position;
+		}
+		this.chunk.order(this.order == null ? ByteOrder.LITTLE_ENDIAN : this.order);
+	}
+
+	/**
+	 * Move to the next packet.
+	 * A truncated record or block at the end of the file ends the iteration.
+	 * @return false if there are no more packets, true otherwise.
+	 * @throws IOException the file could not be mapped.
+	 */
+	public boolean next() throws IOException {
+		if (!this.channel.isOpen()) {
+			throw new IllegalStateException("PcapFileReader is closed.");
+		}
+		this.dataOffset = -1;
+		return this.ng ? this.nextBlock() : this.nextRecord();
+	}
+
+	private boolean nextRecord() throws IOException {
+		if (this.position + RECORD_HEADER_LENGTH > this.size) {
+			return false;
+		}
+		this.ensureChunk(this.position, RECORD_HEADER_LENGTH);
+		int offset = (int) (this.position - this.chunkStart);
+		int caplen = this.chunk.getInt(offset + 8);
+		if (caplen < 0 || this.position + RECORD_HEADER_LENGTH + caplen > this.size) {
+			return false;
+		}
+		this.ensureChunk(this.position, RECORD_HEADER_LENGTH + caplen);
+		offset = (int) (this.position - this.chunkStart);
+		this.tvSec = this.chunk.getInt(offset) & 0xFFFFFFFFL;
+		long fraction = this.chunk.getInt(offset + 4) & 0xFFFFFFFFL;
+		this.tvNsec = (int) (this.current.resolution == 9 ? fraction : fraction * 1000);
+		this.caplen = caplen;
+		this.len = this.chunk.getInt(offset + 12);
+		this.dataOffset = offset + RECORD_HEADER_LENGTH;
+		this.position += RECORD_HEADER_LENGTH + caplen;
+		return true;
+	}
+
+	private boolean nextBlock() throws IOException {
+		while (this.position + 12 <= this.size) {
+			this.ensureChunk(this.position, 12);
+			int offset = (int) (this.position - this.chunkStart);
+			int type = this.chunk.getInt(offset);
+			if (type == SECTION_HEADER_BLOCK) {
+				this.chunk.order(ByteOrder.BIG_ENDIAN);
+				this.order = this.chunk.getInt(offset + 8) == BYTE_ORDER_MAGIC
+						? ByteOrder.BIG_ENDIAN : ByteOrder.LITTLE_ENDIAN;
+				this.chunk.order(this.order);
+				this.interfaces.clear();
+			}
+			int length = this.chunk.getInt(offset + 4);
+			if (length < 12 || (length & 3) != 0 || this.position + length > this.size) {
+				return false;
+			}
+			this.ensureChunk(this.position, length);
+			offset = (int) (this.position - this.chunkStart);
+			this.position += length;
+			switch (type) {
+				case INTERFACE_DESCRIPTION_BLOCK:
+					if (length >= 20) {
+						this.interfaces.add(this.readInterface(offset, length));
+					}
+					break;
+				case ENHANCED_PACKET_BLOCK:
+				case PACKET_BLOCK:
+					if (length >= 32 && this.readPacket(offset, length, type == PACKET_BLOCK)) {
+						return true;
+					}
+					break;
+				case SIMPLE_PACKET_BLOCK:
+					if (length >= 16 && !this.interfaces.isEmpty()) {
+						this.current = this.interfaces.get(0);
+						this.len = this.chunk.getInt(offset + 8);
+						this.caplen = Math.min(this.len, length - 16);
+						this.tvSec = 0;
+						this.tvNsec = 0;
+						this.dataOffset = offset + 12;
+						return true;
+					}
+					break;
+				default:
+					break;
+			}
+		}
+		return false;
+	}
+
+	private Interface readInterface(int offset, int length) {
+		Interface iface = new Interface(DataLinkType.valueOf(this.chunk.getShort(offset + 8)),
+				this.chunk.getInt(offset + 12));
+		int option = offset + 16;
+		int end = offset + length - 4;
+		while (option + 4 <= end) {
+			int code = this.chunk.getShort(option) & 0xFFFF;
+			int optionLength = this.chunk.getShort(option + 2) & 0xFFFF;
+			if (code == OPT_ENDOFOPT || option + 4 + optionLength > end) {
+				break;
+			}
+			if (code == OPT_IF_TSRESOL && optionLength >= 1) {
+				int resolution = this.chunk.get(option + 4) & 0xFF;
+				iface.binary = (resolution & 0x80) != 0;
+				iface.resolution = resolution & 0x7F;
+			} else if (code == OPT_IF_TSOFFSET && optionLength >= 8) {
+				iface.offset = this.chunk.getLong(option + 4);
+			}
+			option += 4 + ((optionLength + 3) & ~3);
+		}
+		return iface;
+	}
+
+	private boolean readPacket(int offset, int length, boolean obsolete) {
+		int id = obsolete ? this.chunk.getShort(offset + 8) & 0xFFFF : this.chunk.getInt(offset + 8);
+		int caplen = this.chunk.getInt(offset + 20);
+		if (id < 0 || id >= this.interfaces.size() || caplen < 0 || caplen > length - 32) {
+			return false;
+		}
+		this.current = this.interfaces.get(id);
+		long ts = ((this.chunk.getInt(offset + 12) & 0xFFFFFFFFL) << 32) | (this.chunk.getInt(offset + 16) & 0xFFFFFFFFL);
+		this.setTimestamp(ts);
+		this.caplen = caplen;
+		this.len = this.chunk.getInt(offset + 24);
+		this.dataOffset = offset + 28;
+		return true;
+	}
+
+	private void setTimestamp(long ts) {
+		int resolution = this.current.resolution;
+		long seconds;
+		long nanos;
+		if (this.current.binary) {
+			if (resolution >= 64) {
+				seconds = 0;
+				nanos = 0;
+			} else {
+				seconds = ts >>> resolution;
+				long fraction = ts & ((1L << resolution) - 1);
+				nanos = resolution <= 33 ? (fraction * 1000000000L) >>> resolution
+						: ((fraction >>> (resolution - 33)) * 1000000000L) >>> 33;
+			}
+		} else if (resolution <= 18) {
+			long units = 1;
+			for (int i = 0; i < resolution; i++) {
+				units *= 10;
+			}
+			// ts is unsigned
+			seconds = Long.divideUnsigned(ts, units);
+			long fraction = Long.remainderUnsigned(ts, units);
+			if (resolution <= 9) {
+				for (int i = resolution; i < 9; i++) {
+					fraction *= 10;
+				}
+			} else {
+				for (int i = 9; i < resolution; i++) {
+					fraction /= 10;
+				}
+			}
+			nanos = fraction;
+		} else {
+			seconds = 0;
+			nanos = 0;
+		}
+		this.tvSec = seconds + this.current.offset;
+		this.tvNsec = (int) nanos;
+	}
+
+	/**
+	 * Read packets the way PcapLoop does, handing each one to the callback.
+	 * The packet buffer is a slice of the mapping.
+	 * @param cnt maximum number of packets, -1 or 0 for all of them.
+	 * @param callback callback function.
+	 * @param user arg.
+	 * @param <T> type.
+	 * @return number of packets read.
+	 * @throws IOException the file could not be mapped.
+	 */
+	public <T> int loop(int cnt, PcapHandler<T> callback, T user) throws IOException {
+		int count = 0;
+		while ((cnt <= 0 || count < cnt) && this.next()) {
+			PcapPktHdr pktHdr = new PcapPktHdr(this.caplen, this.len, (int) this.tvSec, this.getTvUsec());
+			callback.nextPacket(user, pktHdr, this.getPacket());
+			count++;
+		}
+		return count;
+	}
+
+	/**
+	 * Returning current chunk, in the byte order of the file or section.
+	 * @return chunk buffer.
+	 */
+	public ByteBuffer getBuffer() {
+		return this.chunk;
+	}
+
+	/**
+	 * Returning offset of current packet data in current chunk.
+	 * @return data offset.
+	 */
+	public int getDataOffset() {
+		return this.dataOffset;
+	}
+
+	/**
+	 * Returning current packet as a slice of the mapping.
+	 * @return packet buffer.
+	 */
+	public ByteBuffer getPacket() {
+		if (this.dataOffset < 0) {
+			throw new IllegalStateException("No current packet.");
+		}
+		ByteBuffer packet = this.chunk.duplicate();
+		packet.limit(this.dataOffset + this.caplen).position(this.dataOffset);
+		return packet.slice();
+	}
+
+	/**
+	 * Returning seconds of current packet timestamp (0 for pcapng simple packet blocks).
+	 * @return tv_sec.
+	 */
+	public long getTvSec() {
+		return this.tvSec;
+	}
+
+	/**
+	 * Returning microseconds of current packet timestamp.
+	 * @return tv_usec.
+	 */
+	public long getTvUsec() {
+		return this.tvNsec / 1000;
+	}
+
+	/**
+	 * Returning nanoseconds of current packet timestamp, as precise as the file.
+	 * @return tv_nsec.
+	 */
+	public long getTvNsec() {
+		return this.tvNsec;
+	}
+
+	/**
+	 * Returning timestamp of current packet in microseconds since the epoch.
+	 * @return timestamp.
+	 */
+	public long getTimestamp() {
+		return this.tvSec * 1000000L + this.tvNsec / 1000;
+	}
+
+	/**
+	 * Returning capture length of current packet.
+	 * @return capture length.
+	 */
+	public int getCapLen() {
+		return this.caplen;
+	}
+
+	/**
+	 * Returning packet length of current packet.
+	 * @return packet length.
+	 */
+	public int getLen() {
+		return this.len;
+	}
+
+	/**
+	 * Returning link type of the interface of current packet (of the file before the first packet).
+	 * @return link type, null if unknown.
+	 */
+	public DataLinkType getDataLinkType() {
+		if (this.current == null) {
+			return null;
+		}
+		return this.current.dataLinkType;
+	}
+
+	/**
+	 * Returning snapshot length of the interface of current packet (of the file before the first packet).
+	 * @return snapshot length.
+	 */
+	public int getSnapshotLength() {
+		if (this.current == null) {
+			return 0;
+		}
+		return this.current.snapshotLength;
+	}
+
+	public boolean isPcapng() {
+		return this.ng;
+	}
+
+	/**
+	 * Returning file offset of the next record or block.
+	 * @return file offset.
+	 */
+	public long getPosition() {
+		return this.position;
+	}
+
+	public long getSize() {
+		return this.size;
+	}
+
+	public boolean isClosed() {
+		return !this.channel.isOpen();
+	}
+
+	/**
+	 * Close the file. The mapping is released when its slices are garbage collected.
+	 * @throws IOException error closing the file.
+	 */
+	public void close() throws IOException {
+		this.chunk = null;
+		this.file.close();
+	}
+
+	@Override
+	public String toString() {
+		return new StringBuilder().append("[Size: ")
+				.append(this.size)
+				.append(", Position: ").append(this.position)
+				.append(", Pcapng: ").append(this.ng)
+				.append("]").toString();
+	}
+
+}
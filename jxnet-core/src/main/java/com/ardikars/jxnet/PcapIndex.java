@@ -0,0 +1,276 @@
+/**
+ * Copyright (C) 2017  Ardika Rommy Sanjaya
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+package com.ardikars.jxnet;
+
+import java.io.BufferedInputStream;
+import java.io.BufferedOutputStream;
+import java.io.DataInputStream;
+import java.io.DataOutputStream;
+import java.io.File;
+import java.io.FileInputStream;
+import java.io.FileOutputStream;
+import java.io.IOException;
+import java.util.Arrays;
+
+/**
+ * Sparse timestamp index of a classic pcap savefile, kept in a sidecar file (savefile + ".idx").
+ * Every interval packets an entry maps a timestamp to the file offset of a record, so a time
+ * range can be read without scanning the file from the beginning (see MappedPcap.openRange()).
+ * Timestamps are in microseconds since the epoch. The timestamp of an entry is the latest
+ * timestamp of all packets up to and including the record it points to, so every packet before
+ * an entry with a timestamp lower than t is also earlier than t, even if the capture is not
+ * strictly ordered. The sidecar records the length and modification time of the savefile
+ * it was built for, so a stale sidecar can be detected (see isCurrent()).
+ * @author Ardika Rommy Sanjaya
+ * @since 1.1.5
+ */
+public final class PcapIndex {
+
+	public static final int DEFAULT_INTERVAL = 4096;
+
+	public static final String SUFFIX = ".idx";
+
+	private static final int MAGIC = 0x4a584958;
+
+	private static final int VERSION = 2;
+
+	private final int interval;
+
+	private long[] timestamps;
+
+	private long[] offsets;
+
+	private int count;
+
+	private long packets;
+
+	private long latest = Long.MIN_VALUE;
+
+	private long fileSize = -1;
+
+	private long lastModified = -1;
+
+	/**
+	 * Create an empty index.
+	 * @param interval number of packets between entries.
+	 */
+	public PcapIndex(int interval) {
+		if (interval < 1) {
+			throw new IllegalArgumentException("Interval must be positive.");
+		}
+		this.interval = interval;
+		this.timestamps = new long[16];
+		this.offsets = new long[16];
+	}
+
+	/**
+	 * Return true if the next packet passed to add() starts a new entry, so its file offset is needed.
+	 * @return true if the next packet starts a new entry.
+	 */
+	public boolean isDue() {
+		return this.packets % this.interval == 0;
+	}
+
+	/**
+	 * Account for the next packet of the file.
+	 * @param timestamp packet timestamp in microseconds.
+	 * @param offset file offset of the packet record, only used if isDue().
+	 */
+	public void add(long timestamp, long offset) {
+		if (timestamp > this.latest) {
+			this.latest = timestamp;
+		}
+		if (this.isDue()) {
+			if (this.count == this.offsets.length) {
+				this.timestamps = Arrays.copyOf(this.timestamps, this.count * 2);
+				this.offsets = Arrays.copyOf(this.offsets, this.count * 2);
+			}
+			this.timestamps[this.count] = this.latest;
+			this.offsets[this.count] = offset;
+			this.count++;
+		}
+		this.packets++;
+	}
+
+	/**
+	 * Index a mapped savefile from its current position.
+	 * @param file mapped savefile.
+	 * @param interval number of packets between entries.
+	 * @return index.
+	 */
+	public static PcapIndex build(MappedPcap file, int interval) {
+		PcapIndex index = new PcapIndex(interval);
+		long offset = file.getPosition();
+		while (file.next()) {
+			index.add(file.getTimestamp(), offset);
+			offset = file.getPosition();
+		}
+		return index;
+	}
+
+	/**
+	 * Index a classic pcap savefile.
+	 * @param path savefile path.
+	 * @param interval number of packets between entries.
+	 * @param errbuf error buffer.
+	 * @return index or null on error.
+	 */
+	public static PcapIndex build(String path, int interval, StringBuilder errbuf) {
+		MappedPcap file = MappedPcap.open(path, errbuf);
+		if (file == null) {
+			return null;
+		}
+		try {
+			PcapIndex index = build(file, interval);
+			index.setSavefile(new File(path));
+			return index;
+		} finally {
+			file.close();
+		}
+	}
+
+	/**
+	 * Return the file offset to start reading from to get every packet at or after fromTs
+	 * (O(log n) binary search).
+	 * @param fromTs timestamp in microseconds.
+	 * @return file offset of a record, or -1 if the index is empty.
+	 */
+	public long seek(long fromTs) {
+		if (this.count == 0) {
+			return -1;
+		}
+		int low = 0;
+		int high = this.count - 1;
+		while (low < high) {
+			int mid = (low + high + 1) >>> 1;
+			if (this.timestamps[mid] < fromTs) {
+				low = mid;
+			} else {
+				high = mid - 1;
+			}
+		}
+		return this.offsets[low];
+	}
+
+	/**
+	 * Record the length and modification time of the indexed savefile, stored with the index.
+	 * @param savefile indexed savefile.
+	 */
+	public void setSavefile(File savefile) {
+		this.fileSize = savefile.length();
+		this.lastModified = savefile.lastModified();
+	}
+
+	/**
+	 * Return true if the savefile has the length and modification time recorded by setSavefile(),
+	 * so the offsets of this index are still valid for it.
+	 * @param savefile savefile.
+	 * @return true if the index matches the savefile.
+	 */
+	public boolean isCurrent(File savefile) {
+		return this.fileSize >= 0 && this.fileSize == savefile.length()
+				&& this.lastModified == savefile.lastModified();
+	}
+
+	/**
+	 * Write the index to a sidecar file.
+	 * @param path sidecar path, usually sidecar(savefile).
+	 * @throws IOException I/O error.
+	 */
+	public void store(String path) throws IOException {
+		DataOutputStream out = new DataOutputStream(new BufferedOutputStream(new FileOutputStream(path)));
+		try {
+			out.writeInt(MAGIC);
+			out.writeInt(VERSION);
+			out.writeInt(this.interval);
+			out.writeLong(this.fileSize);
+			out.writeLong(this.lastModified);
+			out.writeInt(this.count);
+			for (int i = 0; i < this.count; i++) {
+				out.writeLong(this.timestamps[i]);
+				out.writeLong(this.offsets[i]);
+			}
+		} finally {
+			out.close();
+		}
+	}
+
+	/**
+	 * Read an index from a sidecar file.
+	 * @param path sidecar path.
+	 * @return index.
+	 * @throws IOException I/O error or not an index file.
+	 */
+	public static PcapIndex load(String path) throws IOException {
+		DataInputStream in = new DataInputStream(new BufferedInputStream(new FileInputStream(path)));
+		try {
+			if (in.readInt() != MAGIC || in.readInt() != VERSION) {
+				throw new IOException("Not a pcap index file: " + path);
+			}
+			PcapIndex index = new PcapIndex(in.readInt());
+			index.fileSize = in.readLong();
+			index.lastModified = in.readLong();
+			int count = in.readInt();
+			index.timestamps = new long[Math.max(count, 1)];
+			index.offsets = new long[Math.max(count, 1)];
+			for (int i = 0; i < count; i++) {
+				index.timestamps[i] = in.readLong();
+				index.offsets[i] = in.readLong();
+			}
+			index.count = count;
+			index.latest = count > 0 ? index.timestamps[count - 1] : Long.MIN_VALUE;
+			return index;
+		} finally {
+			in.close();
+		}
+	}
+
+	/**
+	 * Returning sidecar path of a savefile.
+	 * @param path savefile path.
+	 * @return sidecar path.
+	 */
+	public static String sidecar(String path) {
+		return path + SUFFIX;
+	}
+
+	public int getInterval() {
+		return this.interval;
+	}
+
+	public int getCount() {
+		return this.count;
+	}
+
+	public long getTimestamp(int i) {
+		return this.timestamps[i];
+	}
+
+	public long getOffset(int i) {
+		return this.offsets[i];
+	}
+
+	@Override
+	public String toString() {
+		return new StringBuilder().append("[Interval: ")
+				.append(this.interval)
+				.append(", Entries: ").append(this.count)
+				.append("]").toString();
+	}
+
+}
@@ -0,0 +1,113 @@
+/**
+ * Copyright (C) 2017  Ardika Rommy Sanjaya
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+package com.ardikars.jxnet;
+
+import com.ardikars.jxnet.exception.PcapDumperCloseException;
+
+import java.io.File;
+import java.io.IOException;
+import java.nio.ByteBuffer;
+
+/**
+ * PcapDumper that builds the PcapIndex of the savefile while writing it.
+ * The record offset is taken with PcapDumpFTell once per index interval only,
+ * and the sidecar is written by close().
+ * @author Ardika Rommy Sanjaya
+ * @since 1.1.5
+ */
+public final class PcapIndexWriter {
+
+	private final PcapDumper dumper;
+
+	private final String path;
+
+	private final PcapIndex index;
+
+	private final boolean nanosecond;
+
+	private PcapIndexWriter(PcapDumper dumper, String path, int interval, boolean nanosecond) {
+		this.dumper = dumper;
+		this.path = path;
+		this.index = new PcapIndex(interval);
+		this.nanosecond = nanosecond;
+	}
+
+	/**
+	 * Open a savefile for writing, indexed every PcapIndex.DEFAULT_INTERVAL packets.
+	 * @param pcap pcap object.
+	 * @param fname savefile path.
+	 * @return PcapIndexWriter or null on error (see PcapGetErr).
+	 */
+	public static PcapIndexWriter open(Pcap pcap, String fname) {
+		return open(pcap, fname, PcapIndex.DEFAULT_INTERVAL);
+	}
+
+	/**
+	 * Open a savefile for writing.
+	 * @param pcap pcap object.
+	 * @param fname savefile path.
+	 * @param interval number of packets between index entries.
+	 * @return PcapIndexWriter or null on error (see PcapGetErr).
+	 */
+	public static PcapIndexWriter open(Pcap pcap, String fname, int interval) {
+		PcapDumper dumper;
+		try {
+			dumper = Jxnet.PcapDumpOpen(pcap, fname);
+		} catch (PcapDumperCloseException e) {
+			return null;
+		}
+		if (dumper == null) {
+			return null;
+		}
+		return new PcapIndexWriter(dumper, fname, interval,
+				Jxnet.PcapGetTStampPrecision(pcap) == TimestampPrecision.TIMESTAMP_NANO.getValue());
+	}
+
+	/**
+	 * Write a packet to the savefile.
+	 * @param h packet header, tv_usec in nanoseconds on nanosecond precision handles.
+	 * @param sp packet buffer.
+	 */
+	public void dump(PcapPktHdr h, ByteBuffer sp) {
+		long offset = this.index.isDue() ? Jxnet.PcapDumpFTell(this.dumper) : -1;
+		long fraction = this.nanosecond ? h.getTvUsec() / 1000 : h.getTvUsec();
+		this.index.add((h.getTvSec() & 0xFFFFFFFFL) * 1000000L + fraction, offset);
+		Jxnet.PcapDump(this.dumper, h, sp);
+	}
+
+	public PcapDumper getDumper() {
+		return this.dumper;
+	}
+
+	public PcapIndex getIndex() {
+		return this.index;
+	}
+
+	/**
+	 * Close the savefile and write its sidecar index.
+	 * @throws IOException failed to write the index.
+	 */
+	public void close() throws IOException {
+		if (!this.dumper.isClosed()) {
+			Jxnet.PcapDumpClose(this.dumper);
+			this.index.setSavefile(new File(this.path));
+			this.index.store(PcapIndex.sidecar(this.path));
+		}
+	}
+
+}
@@ -0,0 +1,290 @@
+/**
+ * Copyright (C) 2017  Ardika Rommy Sanjaya
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+package com.ardikars.jxnet;
+
+import com.ardikars.jxnet.exception.JxnetException;
+
+import java.nio.ByteBuffer;
+import java.util.Comparator;
+import java.util.PriorityQueue;
+
+/**
+ * Merge savefiles into one stream ordered by timestamp, like mergecap.
+ * Every input is read with PcapNextEx() into its own buffer and the inputs are
+ * kept in a heap ordered by the timestamp of their next packet, so memory is one
+ * packet per input whatever the size of the files. Packets with the same
+ * timestamp come out in the order of the inputs.
+ * Optionally, a packet identical to one of the last emitted packets is dropped
+ * (see setDeduplication()), like editcap -D.
+ * @author Ardika Rommy Sanjaya
+ * @since 1.1.5
+ */
+public final class PcapMerger {
+
+	private static final int MAX_SNAPSHOT_LENGTH = 262144;
+
+	private static final class Cursor {
+
+		private final Pcap pcap;
+
+		private final int index;
+
+		private final PcapPktHdr pktHdr = new PcapPktHdr();
+
+		private final ByteBuffer buffer;
+
+		private long timestamp;
+
+		private Cursor(Pcap pcap, int index) {
+			this.pcap = pcap;
+			this.index = index;
+			int snaplen = Jxnet.PcapSnapshot(pcap);
+			this.buffer = ByteBuffer.allocateDirect(snaplen > 0 && snaplen < MAX_SNAPSHOT_LENGTH
+					? snaplen : MAX_SNAPSHOT_LENGTH);
+		}
+
+		private boolean read() {
+			int r = Jxnet.PcapNextEx(this.pcap, this.pktHdr, this.buffer);
+			if (r == -2) {
+				return false;
+			}
+			if (r != 1) {
+				throw new JxnetException(Jxnet.PcapGetErr(this.pcap));
+			}
+			this.buffer.limit(this.pktHdr.getCapLen()).position(0);
+			this.timestamp = (this.pktHdr.getTvSec() & 0xFFFFFFFFL) * 1000000L + this.pktHdr.getTvUsec();
+			return true;
+		}
+
+	}
+
+	private final Cursor[] cursors;
+
+	private final PriorityQueue<Cursor> heap;
+
+	private Cursor current;
+
+	private ByteBuffer[] recent;
+
+	private int recentIndex;
+
+	private long duplicates;
+
+	private boolean closed;
+
+	private PcapMerger(Pcap[] pcaps) {
+		this.cursors = new Cursor[pcaps.length];
+		this.heap = new PriorityQueue<Cursor>(Math.max(1, pcaps.length), new Comparator<Cursor>() {
+			@Override
+			public int compare(Cursor a, Cursor b) {
+				if (a.timestamp != b.timestamp) {
+					return a.timestamp < b.timestamp ? -1 : 1;
+				}
+				return a.index - b.index;
+			}
+		});
+		for (int i = 0; i < pcaps.length; i++) {
+			this.cursors[i] = new Cursor(pcaps[i], i);
+		}
+	}
+
+	/**
+	 * Open the savefiles to merge with PcapOpenOffline().
+	 * @param paths savefile paths, all of the same link type.
+	 * @param errbuf error buffer.
+	 * @return PcapMerger or null on error.
+	 */
+	public static PcapMerger open(String[] paths, StringBuilder errbuf) {
+		if (paths.length == 0) {
+			throw new IllegalArgumentException("No file to merge.");
+		}
+		Pcap[] pcaps = new Pcap[paths.length];
+		for (int i = 0; i < paths.length; i++) {
+			pcaps[i] = Jxnet.PcapOpenOffline(paths[i], errbuf);
+			if (pcaps[i] != null && Jxnet.PcapDataLink(pcaps[i]) != Jxnet.PcapDataLink(pcaps[0])) {
+				errbuf.setLength(0);
+				errbuf.append(paths[i]).append(": link type differs from ").append(paths[0]).append('.');
+				Jxnet.PcapClose(pcaps[i]);
+				pcaps[i] = null;
+			}
+			if (pcaps[i] == null) {
+				for (int j = 0; j < i; j++) {
+					Jxnet.PcapClose(pcaps[j]);
+				}
+				return null;
+			}
+		}
+		PcapMerger merger = new PcapMerger(pcaps);
+		for (Cursor cursor : merger.cursors) {
+			if (cursor.read()) {
+				merger.heap.add(cursor);
+			}
+		}
+		return merger;
+	}
+
+	/**
+	 * Drop packets identical (same length and data) to one of the last emitted packets.
+	 * @param window number of emitted packets compared, 0 to disable.
+	 */
+	public void setDeduplication(int window) {
+		if (window < 0) {
+			throw new IllegalArgumentException("Deduplication window must not be negative.");
+		}
+		this.recent = window == 0 ? null : new ByteBuffer[window];
+		this.recentIndex = 0;
+	}
+
+	private boolean isDuplicate(ByteBuffer packet) {
+		for (ByteBuffer previous : this.recent) {
+			if (previous != null && previous.equals(packet)) {
+				return true;
+			}
+		}
+		ByteBuffer copy = this.recent[this.recentIndex];
+		if (copy == null || copy.capacity() < packet.remaining()) {
+			copy = ByteBuffer.allocate(Math.max(packet.remaining(), 64));
+			this.recent[this.recentIndex] = copy;
+		}
+		copy.clear();
+		copy.put(packet.duplicate()).flip();
+		this.recentIndex = (this.recentIndex + 1) % this.recent.length;
+		return false;
+	}
+
+	/**
+	 * Move to the next packet in timestamp order.
+	 * @return false if every input is exhausted, true otherwise.
+	 */
+	public boolean next() {
+		if (this.closed) {
+			throw new IllegalStateException("PcapMerger is closed.");
+		}
+		while (true) {
+			if (this.current != null && this.current.read()) {
+				this.heap.add(this.current);
+			}
+			this.current = this.heap.poll();
+			if (this.current == null) {
+				return false;
+			}
+			if (this.recent == null || !this.isDuplicate(this.current.buffer)) {
+				return true;
+			}
+			this.duplicates++;
+		}
+	}
+
+	/**
+	 * Returning header of current packet, valid until the next call to next().
+	 * @return packet header.
+	 */
+	public PcapPktHdr getPktHdr() {
+		return this.current.pktHdr;
+	}
+
+	/**
+	 * Returning current packet, valid until the next call to next().
+	 * @return direct buffer holding caplen bytes.
+	 */
+	public ByteBuffer getPacket() {
+		return this.current.buffer;
+	}
+
+	/**
+	 * Returning index in paths of the input of current packet.
+	 * @return input index.
+	 */
+	public int getInput() {
+		return this.current.index;
+	}
+
+	/**
+	 * Returning handle of the first input, to open the output with PcapDumpOpen().
+	 * @return pcap object.
+	 */
+	public Pcap getPcap() {
+		return this.cursors[0].pcap;
+	}
+
+	/**
+	 * Returning number of packets dropped as duplicates.
+	 * @return duplicate packets.
+	 */
+	public long getDuplicates() {
+		return this.duplicates;
+	}
+
+	/**
+	 * Hand the merged packets to a callback, the way PcapLoop does.
+	 * @param cnt maximum number of packets, -1 or 0 for all of them.
+	 * @param callback callback function.
+	 * @param user arg.
+	 * @param <T> type.
+	 * @return number of packets.
+	 */
+	public <T> int loop(int cnt, PcapHandler<T> callback, T user) {
+		int count = 0;
+		while ((cnt <= 0 || count < cnt) && this.next()) {
+			callback.nextPacket(user, this.current.pktHdr, this.current.buffer);
+			count++;
+		}
+		return count;
+	}
+
+	/**
+	 * Write the merged packets to a savefile.
+	 * @param dumper pcap dumper object, opened with getPcap().
+	 * @return number of packets.
+	 */
+	public long dump(PcapDumper dumper) {
+		long count = 0;
+		while (this.next()) {
+			Jxnet.PcapDump(dumper, this.current.pktHdr, this.current.buffer);
+			count++;
+		}
+		return count;
+	}
+
+	public boolean isClosed() {
+		return this.closed;
+	}
+
+	/**
+	 * Close every input.
+	 */
+	public void close() {
+		if (!this.closed) {
+			for (Cursor cursor : this.cursors) {
+				Jxnet.PcapClose(cursor.pcap);
+			}
+			this.heap.clear();
+			this.current = null;
+			this.closed = true;
+		}
+	}
+
+	@Override
+	public String toString() {
+		return new StringBuilder().append("[Inputs: ")
+				.append(this.cursors.length)
+				.append(", Duplicates: ").append(this.duplicates)
+				.append("]").toString();
+	}
+
+}
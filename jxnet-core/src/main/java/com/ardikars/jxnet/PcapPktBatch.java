@@ -0,0 +1,140 @@
+/**
+ * Copyright (C) 2017  Ardika Rommy Sanjaya
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+package com.ardikars.jxnet;
+
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+
+/**
+ * Packed packets collected by PcapDispatchBatch().
+ * Each record is a 16 byte header (tv_sec, tv_usec, caplen and len) followed by
+ * caplen bytes of packet data, which is the record layout of a savefile.
+ * @author Ardika Rommy Sanjaya
+ * @since 1.1.5
+ */
+public final class PcapPktBatch {
+
+	public static final int HEADER_LENGTH = 16;
+
+	private final ByteBuffer buffer;
+
+	private int count;
+
+	private int index;
+
+	private int offset;
+
+	/**
+	 * Create packet batch backed by a direct buffer.
+	 * @param capacity buffer capacity in bytes.
+	 */
+	public PcapPktBatch(int capacity) {
+		this.buffer = ByteBuffer.allocateDirect(capacity).order(ByteOrder.nativeOrder());
+		this.reset(0);
+	}
+
+	/**
+	 * Returning backing buffer.
+	 * @return direct buffer in native byte order.
+	 */
+	public ByteBuffer getBuffer() {
+		return this.buffer;
+	}
+
+	/**
+	 * Returning number of packets in this batch.
+	 * @return number of packets.
+	 */
+	public int getCount() {
+		return this.count;
+	}
+
+	/**
+	 * Set number of packets in this batch and rewind to the first packet.
+	 * @param count number of packets.
+	 */
+	public void reset(int count) {
+		this.count = count;
+		this.index = -1;
+		this.offset = 0;
+	}
+
+	/**
+	 * Move to the next packet.
+	 * @return false if there are no more packets, true otherwise.
+	 */
+	public boolean next() {
+		if (this.index + 1 >= this.count) {
+			return false;
+		}
+		if (this.index >= 0) {
+			this.offset += HEADER_LENGTH + this.getCapLen();
+		}
+		this.index++;
+		return true;
+	}
+
+	/**
+	 * Returning tv_sec of current packet.
+	 * @return tv_sec.
+	 */
+	public int getTvSec() {
+		return this.buffer.getInt(this.offset);
+	}
+
+	/**
+	 * Returning tv_usec of current packet.
+	 * @return tv_usec.
+	 */
+	public long getTvUsec() {
+		return this.buffer.getInt(this.offset + 4) & 0xFFFFFFFFL;
+	}
+
+	/**
+	 * Returning capture length of current packet.
+	 * @return capture length.
+	 */
+	public int getCapLen() {
+		return this.buffer.getInt(this.offset + 8);
+	}
+
+	/**
+	 * Returning packet length of current packet.
+	 * @return packet length.
+	 */
+	public int getLen() {
+		return this.buffer.getInt(this.offset + 12);
+	}
+
+	/**
+	 * Returning offset of current packet data in backing buffer.
+	 * @return data offset.
+	 */
+	public int getDataOffset() {
+		return this.offset + HEADER_LENGTH;
+	}
+
+	@Override
+	public String toString() {
+		return new StringBuilder()
+				.append("[Count: ").append(this.count)
+				.append(", Capacity: ").append(this.buffer.capacity())
+				.append("]").toString();
+	}
+
+}
@@ -0,0 +1,297 @@
+/**
+ * Copyright (C) 2017  Ardika Rommy Sanjaya
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+package com.ardikars.jxnet;
+
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+import java.nio.IntBuffer;
+import java.nio.ShortBuffer;
+
+/**
+ * Header summaries of packets collected by PcapDispatchSummary(), stored column by
+ * column (struct of arrays) in one direct buffer, so a batch of packets is reduced
+ * to flow keys, lengths and timestamps by a single native call and read back with
+ * plain loops over the column views.
+ * Ethernet (with 802.1Q/802.1ad tags), Linux cooked and raw IP link types are parsed,
+ * followed by IPv4/IPv6 (with IPv6 extension headers), TCP, UDP, ICMP and ICMPv6.
+ * Values are numbers in native byte order; addresses and ports read like
+ * Inet4Address.toInt() and TCP.getSourcePort(), unsigned fields must be masked.
+ * A column is 0 when its header is not present or not captured, except vlan which is -1.
+ * @author Ardika Rommy Sanjaya
+ * @since 1.1.5
+ */
+public final class PcapPktSummary {
+
+	/**
+	 * Size of the summary of one packet over all columns, in bytes.
+	 */
+	public static final int RECORD_SIZE = 2 * 16 + 7 * 4 + 6 * 2 + 2 * 1;
+
+	private static final int[] WIDTHS = { 16, 16, 4, 4, 4, 4, 4, 4, 4, 2, 2, 2, 2, 2, 2, 1, 1 };
+
+	// column order, widest first, as in jni/src/packet_summary.h
+	private static final int SRC_IP6 = 0;
+	private static final int DST_IP6 = 1;
+	private static final int TV_SEC = 2;
+	private static final int TV_USEC = 3;
+	private static final int CAPLEN = 4;
+	private static final int LEN = 5;
+	private static final int SRC_IP = 6;
+	private static final int DST_IP = 7;
+	private static final int PAYLOAD_LENGTH = 8;
+	private static final int ETHER_TYPE = 9;
+	private static final int VLAN = 10;
+	private static final int SRC_PORT = 11;
+	private static final int DST_PORT = 12;
+	private static final int TCP_FLAGS = 13;
+	private static final int PAYLOAD_OFFSET = 14;
+	private static final int IP_VERSION = 15;
+	private static final int PROTOCOL = 16;
+
+	private final ByteBuffer buffer;
+
+	private final int capacity;
+
+	private final ByteBuffer[] columns = new ByteBuffer[WIDTHS.length];
+
+	private final IntBuffer tvSec;
+	private final IntBuffer tvUsec;
+	private final IntBuffer capLen;
+	private final IntBuffer len;
+	private final IntBuffer srcIp;
+	private final IntBuffer dstIp;
+	private final IntBuffer payloadLength;
+	private final ShortBuffer etherType;
+	private final ShortBuffer vlan;
+	private final ShortBuffer srcPort;
+	private final ShortBuffer dstPort;
+	private final ShortBuffer tcpFlags;
+	private final ShortBuffer payloadOffset;
+
+	private int count;
+
+	/**
+	 * Create summary columns for up to capacity packets, backed by one direct buffer.
+	 * @param capacity maximum number of packets.
+	 */
+	public PcapPktSummary(int capacity) {
+		if (capacity <= 0) {
+			throw new IllegalArgumentException("Capacity must be positive.");
+		}
+		this.capacity = capacity;
+		this.buffer = ByteBuffer.allocateDirect(capacity * RECORD_SIZE).order(ByteOrder.nativeOrder());
+		int offset = 0;
+		for (int i = 0; i < WIDTHS.length; i++) {
+			ByteBuffer column = this.buffer.duplicate();
+			column.position(offset).limit(offset + capacity * WIDTHS[i]);
+			this.columns[i] = column.slice().order(ByteOrder.nativeOrder());
+			offset += capacity * WIDTHS[i];
+		}
+		this.tvSec = this.columns[TV_SEC].asIntBuffer();
+		this.tvUsec = this.columns[TV_USEC].asIntBuffer();
+		this.capLen = this.columns[CAPLEN].asIntBuffer();
+		this.len = this.columns[LEN].asIntBuffer();
+		this.srcIp = this.columns[SRC_IP].asIntBuffer();
+		this.dstIp = this.columns[DST_IP].asIntBuffer();
+		this.payloadLength = this.columns[PAYLOAD_LENGTH].asIntBuffer();
+		this.etherType = this.columns[ETHER_TYPE].asShortBuffer();
+		this.vlan = this.columns[VLAN].asShortBuffer();
+		this.srcPort = this.columns[SRC_PORT].asShortBuffer();
+		this.dstPort = this.columns[DST_PORT].asShortBuffer();
+		this.tcpFlags = this.columns[TCP_FLAGS].asShortBuffer();
+		this.payloadOffset = this.columns[PAYLOAD_OFFSET].asShortBuffer();
+	}
+
+	/**
+	 * Returning backing buffer.
+	 * @return direct buffer in native byte order.
+	 */
+	public ByteBuffer getBuffer() {
+		return this.buffer;
+	}
+
+	/**
+	 * Returning maximum number of packets.
+	 * @return capacity.
+	 */
+	public int getCapacity() {
+		return this.capacity;
+	}
+
+	/**
+	 * Returning number of packets in the columns.
+	 * @return number of packets.
+	 */
+	public int getCount() {
+		return this.count;
+	}
+
+	/**
+	 * Set number of packets in the columns.
+	 * @param count number of packets.
+	 */
+	public void reset(int count) {
+		this.count = count;
+	}
+
+	/**
+	 * Returning tv_sec column.
+	 * @return tv_sec of every packet.
+	 */
+	public IntBuffer getTvSec() {
+		return this.tvSec;
+	}
+
+	/**
+	 * Returning tv_usec column (nanoseconds on nanosecond precision handles).
+	 * @return tv_usec of every packet.
+	 */
+	public IntBuffer getTvUsec() {
+		return this.tvUsec;
+	}
+
+	/**
+	 * Returning capture length column.
+	 * @return capture length of every packet.
+	 */
+	public IntBuffer getCapLen() {
+		return this.capLen;
+	}
+
+	/**
+	 * Returning packet length column.
+	 * @return packet length of every packet.
+	 */
+	public IntBuffer getLen() {
+		return this.len;
+	}
+
+	/**
+	 * Returning IPv4 source address column.
+	 * @return source address of every IPv4 packet.
+	 */
+	public IntBuffer getSrcIp() {
+		return this.srcIp;
+	}
+
+	/**
+	 * Returning IPv4 destination address column.
+	 * @return destination address of every IPv4 packet.
+	 */
+	public IntBuffer getDstIp() {
+		return this.dstIp;
+	}
+
+	/**
+	 * Returning IPv6 source address column, 16 bytes per packet.
+	 * @return source address of every IPv6 packet.
+	 */
+	public ByteBuffer getSrcIp6() {
+		return this.columns[SRC_IP6];
+	}
+
+	/**
+	 * Returning IPv6 destination address column, 16 bytes per packet.
+	 * @return destination address of every IPv6 packet.
+	 */
+	public ByteBuffer getDstIp6() {
+		return this.columns[DST_IP6];
+	}
+
+	/**
+	 * Returning transport payload length column, computed from the IP lengths
+	 * so it is not limited by the capture length.
+	 * @return payload length of every packet.
+	 */
+	public IntBuffer getPayloadLength() {
+		return this.payloadLength;
+	}
+
+	/**
+	 * Returning transport payload offset column, from the start of the packet.
+	 * @return payload offset of every packet.
+	 */
+	public ShortBuffer getPayloadOffset() {
+		return this.payloadOffset;
+	}
+
+	/**
+	 * Returning ethernet type column, after any VLAN tag.
+	 * @return ethernet type of every packet.
+	 */
+	public ShortBuffer getEtherType() {
+		return this.etherType;
+	}
+
+	/**
+	 * Returning VLAN identifier column, of the outer tag.
+	 * @return VLAN identifier of every packet, -1 if untagged.
+	 */
+	public ShortBuffer getVlan() {
+		return this.vlan;
+	}
+
+	/**
+	 * Returning source port column, ICMP type for ICMP and ICMPv6.
+	 * @return source port of every packet.
+	 */
+	public ShortBuffer getSrcPort() {
+		return this.srcPort;
+	}
+
+	/**
+	 * Returning destination port column, ICMP code for ICMP and ICMPv6.
+	 * @return destination port of every packet.
+	 */
+	public ShortBuffer getDstPort() {
+		return this.dstPort;
+	}
+
+	/**
+	 * Returning TCP flags column (9 bits, as TCPFlags).
+	 * @return TCP flags of every packet.
+	 */
+	public ShortBuffer getTcpFlags() {
+		return this.tcpFlags;
+	}
+
+	/**
+	 * Returning IP version column.
+	 * @return 4, 6 or 0 for every packet.
+	 */
+	public ByteBuffer getIpVersion() {
+		return this.columns[IP_VERSION];
+	}
+
+	/**
+	 * Returning IP protocol column, of the transport header after IPv6 extension headers.
+	 * @return IP protocol of every packet.
+	 */
+	public ByteBuffer getProtocol() {
+		return this.columns[PROTOCOL];
+	}
+
+	@Override
+	public String toString() {
+		return new StringBuilder()
+				.append("[Count: ").append(this.count)
+				.append(", Capacity: ").append(this.capacity)
+				.append("]").toString();
+	}
+
+}
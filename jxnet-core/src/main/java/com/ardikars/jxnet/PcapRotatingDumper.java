@@ -0,0 +1,289 @@
+/**
+ * Copyright (C) 2017  Ardika Rommy Sanjaya
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+package com.ardikars.jxnet;
+
+import com.ardikars.jxnet.exception.JxnetException;
+import com.ardikars.jxnet.exception.PcapDumperCloseException;
+
+import java.io.File;
+import java.nio.ByteBuffer;
+import java.util.ArrayDeque;
+import java.util.Deque;
+import java.util.concurrent.Callable;
+import java.util.concurrent.ExecutionException;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+import java.util.concurrent.Future;
+import java.util.concurrent.ThreadFactory;
+import java.util.concurrent.TimeUnit;
+
+/**
+ * Savefile writer that rotates through a ring of files by size, time and file count,
+ * like tcpdump -C, -G and -W. Files are named fname.0, fname.1, ...
+ * The next file is opened ahead of time and closing the previous one, the completion
+ * callback and deleting old files happen on a background thread, so rotating in dump()
+ * is a reference swap. If the next file could not be opened, writing goes on in the
+ * current file and the next rotation retries.
+ * dump() must be called from a single thread.
+ * @author Ardika Rommy Sanjaya
+ * @since 1.1.5
+ */
+public final class PcapRotatingDumper {
+
+	private static final int FILE_HEADER_LENGTH = 24;
+
+	private static final int RECORD_HEADER_LENGTH = 16;
+
+	/**
+	 * Notified on the background thread when a file is complete (closed).
+	 * Old files are deleted only after the listener returns.
+	 */
+	@FunctionalInterface
+	public interface FileListener {
+
+		/**
+		 * A file is complete.
+		 * @param path file path.
+		 */
+		void fileCompleted(String path);
+
+	}
+
+	private final Pcap pcap;
+
+	private final String fname;
+
+	private final long maxFileSize;
+
+	private final long maxSeconds;
+
+	private final int maxFiles;
+
+	private final FileListener listener;
+
+	private final ExecutorService executor;
+
+	private final Deque<String> completed = new ArrayDeque<String>();
+
+	private PcapDumper dumper;
+
+	private String path;
+
+	private long sequence;
+
+	private long size;
+
+	private long openedAt = -1;
+
+	private Future<PcapDumper> next;
+
+	private String nextPath;
+
+	private PcapRotatingDumper(Pcap pcap, String fname, long maxFileSize, long maxSeconds, int maxFiles,
+							   FileListener listener) {
+		this.pcap = pcap;
+		this.fname = fname;
+		this.maxFileSize = maxFileSize;
+		this.maxSeconds = maxSeconds;
+		this.maxFiles = maxFiles;
+		this.listener = listener;
+		this.executor = Executors.newSingleThreadExecutor(new ThreadFactory() {
+			@Override
+			public Thread newThread(Runnable r) {
+				Thread thread = new Thread(r, "PcapRotatingDumper");
+				thread.setDaemon(true);
+				return thread;
+			}
+		});
+	}
+
+	/**
+	 * Open the first file of a ring.
+	 * @param pcap pcap object.
+	 * @param fname file name prefix, files are fname.0, fname.1, ...
+	 * @param maxFileSize rotate when a file reaches this many bytes (-C), 0 for no limit.
+	 * @param maxSeconds rotate when the first packet of a file is this many seconds old, by packet time (-G), 0 for no limit.
+	 * @param maxFiles number of files kept, including the current one (-W), 0 for no limit.
+	 * @param listener completed file listener, or null.
+	 * @return PcapRotatingDumper or null on error (see PcapGetErr).
+	 */
+	public static PcapRotatingDumper open(Pcap pcap, String fname, long maxFileSize, long maxSeconds, int maxFiles,
+										  FileListener listener) {
+		if (maxFileSize < 0 || maxSeconds < 0 || maxFiles < 0) {
+			throw new IllegalArgumentException("Rotation limits must not be negative.");
+		}
+		PcapRotatingDumper rotating = new PcapRotatingDumper(pcap, fname, maxFileSize, maxSeconds, maxFiles, listener);
+		rotating.path = rotating.nextPath();
+		rotating.dumper = dumpOpen(pcap, rotating.path);
+		if (rotating.dumper == null) {
+			rotating.executor.shutdown();
+			return null;
+		}
+		rotating.size = FILE_HEADER_LENGTH;
+		rotating.next = rotating.openNext(rotating.nextPath());
+		return rotating;
+	}
+
+	private String nextPath() {
+		return this.fname + "." + this.sequence++;
+	}
+
+	private static PcapDumper dumpOpen(Pcap pcap, String path) {
+		try {
+			return Jxnet.PcapDumpOpen(pcap, path);
+		} catch (PcapDumperCloseException e) {
+			return null;
+		}
+	}
+
+	private Future<PcapDumper> openNext(final String path) {
+		this.nextPath = path;
+		return this.executor.submit(new Callable<PcapDumper>() {
+			@Override
+			public PcapDumper call() {
+				return dumpOpen(pcap, path);
+			}
+		});
+	}
+
+	/**
+	 * Write a packet, rotating first if a limit is reached.
+	 * @param h packet header.
+	 * @param sp packet buffer.
+	 */
+	public void dump(PcapPktHdr h, ByteBuffer sp) {
+		if (this.dumper == null) {
+			throw new IllegalStateException("PcapRotatingDumper is closed.");
+		}
+		long now = h.getTvSec() & 0xFFFFFFFFL;
+		if (this.openedAt < 0) {
+			this.openedAt = now;
+		}
+		long record = RECORD_HEADER_LENGTH + h.getCapLen();
+		if ((this.maxFileSize > 0 && this.size > FILE_HEADER_LENGTH && this.size + record > this.maxFileSize)
+				|| (this.maxSeconds > 0 && now - this.openedAt >= this.maxSeconds)) {
+			this.rotate(now);
+		}
+		Jxnet.PcapDump(this.dumper, h, sp);
+		this.size += record;
+	}
+
+	private void rotate(long now) {
+		if (!this.next.isDone()) {
+			return; // not opened yet, retried on the next packet
+		}
+		PcapDumper opened = get(this.next);
+		if (opened == null) {
+			this.next = this.openNext(this.nextPath);
+			return;
+		}
+		this.complete(this.dumper, this.path, false);
+		this.dumper = opened;
+		this.path = this.nextPath;
+		this.size = FILE_HEADER_LENGTH;
+		this.openedAt = now;
+		this.next = this.openNext(this.nextPath());
+	}
+
+	private void complete(final PcapDumper dumper, final String path, final boolean last) {
+		this.executor.execute(new Runnable() {
+			@Override
+			public void run() {
+				Jxnet.PcapDumpClose(dumper);
+				if (listener != null) {
+					listener.fileCompleted(path);
+				}
+				completed.addLast(path);
+				while (maxFiles > 0 && completed.size() > (last ? maxFiles : maxFiles - 1)) {
+					new File(completed.removeFirst()).delete();
+				}
+			}
+		});
+	}
+
+	private static PcapDumper get(Future<PcapDumper> future) {
+		try {
+			return future.get();
+		} catch (InterruptedException e) {
+			Thread.currentThread().interrupt();
+			throw new JxnetException(e);
+		} catch (ExecutionException e) {
+			throw new JxnetException(e.getCause());
+		}
+	}
+
+	/**
+	 * Returning path of the file being written.
+	 * @return file path.
+	 */
+	public String getCurrentFile() {
+		return this.path;
+	}
+
+	public PcapDumper getDumper() {
+		return this.dumper;
+	}
+
+	public boolean isClosed() {
+		return this.dumper == null;
+	}
+
+	/**
+	 * Close the current file, report it to the listener and wait for the background thread.
+	 * The file opened ahead of time is deleted.
+	 */
+	public void close() {
+		if (this.dumper == null) {
+			return;
+		}
+		this.complete(this.dumper, this.path, true);
+		this.dumper = null;
+		final Future<PcapDumper> unused = this.next;
+		final String unusedPath = this.nextPath;
+		this.executor.execute(new Runnable() {
+			@Override
+			public void run() {
+				PcapDumper dumper;
+				try {
+					dumper = get(unused);
+				} catch (JxnetException e) {
+					dumper = null;
+				}
+				if (dumper != null) {
+					Jxnet.PcapDumpClose(dumper);
+					new File(unusedPath).delete();
+				}
+			}
+		});
+		this.executor.shutdown();
+		try {
+			this.executor.awaitTermination(Long.MAX_VALUE, TimeUnit.MILLISECONDS);
+		} catch (InterruptedException e) {
+			Thread.currentThread().interrupt();
+		}
+	}
+
+	@Override
+	public String toString() {
+		return new StringBuilder().append("[Current File: ")
+				.append(this.path)
+				.append(", Size: ").append(this.size)
+				.append("]").toString();
+	}
+
+}
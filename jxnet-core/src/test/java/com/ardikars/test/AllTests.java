@@ -19,7 +19,9 @@ import java.util.List;
 		PcapLookupDev.class, PcapLookupNet.class, Generic.class, Error.class,
 		PcapNextEx.class, PcapOpenDead.class, PcapOpenLive.class,
 		PcapOpenOffline.class, PcapBreakLoop.class, Blocking.class,
-		PcapDatalink.class, PcapDispatch.class, Preconditions.class,
+		PcapDatalink.class, PcapDispatch.class, PcapDispatchBatch.class, PcapLoopReuse.class, PacketRingCapture.class,
+		PcapFanout.class, PcapCaptureRingTest.class, PcapSendBatch.class, BpfMatches.class, BpfJit.class, MappedPcapRead.class, ParallelRead.class, PcapIndexRange.class, PcapAsyncDump.class, PcapRotatingDump.class, PcapCompressedDump.class, PcapDumpBatch.class, PcapFileRead.class, PcapMerge.class, PcapDispatchSummary.class,
+		Preconditions.class,
 		MacAddr.class, PcapDump.class, AddJavaLibraryPath.class })
 public class AllTests {
 
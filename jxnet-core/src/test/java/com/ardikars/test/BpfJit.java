@@ -0,0 +1,82 @@
+package com.ardikars.test;
+
+import com.ardikars.jxnet.BpfProgram;
+import com.ardikars.jxnet.Pcap;
+import com.ardikars.jxnet.PcapPktBatch;
+import com.ardikars.jxnet.exception.JxnetException;
+import com.ardikars.jxnet.exception.PcapCloseException;
+import org.junit.Assert;
+import org.junit.Test;
+
+import java.nio.ByteBuffer;
+
+import static com.ardikars.jxnet.Jxnet.*;
+
+public class BpfJit {
+
+	private static final String FILTER = "tcp port 80";
+
+	private static final int ROUNDS = 10000;
+
+	private Pcap open() throws PcapCloseException {
+		StringBuilder errbuf = new StringBuilder();
+		Pcap handler = PcapOpenOffline("../sample-capture/eth_ipv4_tcp.pcapng", errbuf);
+		if (handler == null) {
+			throw new PcapCloseException(errbuf.toString());
+		}
+		return handler;
+	}
+
+	private BpfProgram compile(Pcap handler) {
+		BpfProgram fp = new BpfProgram();
+		if (PcapCompile(handler, fp, FILTER, AllTests.optimize, AllTests.netmask) != 0) {
+			String err = PcapGetErr(handler);
+			PcapClose(handler);
+			throw new JxnetException(err);
+		}
+		return fp;
+	}
+
+	@Test
+	public void run() throws PcapCloseException {
+		Pcap handler = open();
+		BpfProgram interpreted = compile(handler);
+		BpfProgram compiled = compile(handler);
+		boolean jit = compiled.jit();
+		PcapPktBatch batch = new PcapPktBatch(PcapSnapshot(handler) * 64);
+		int count = PcapDispatchBatch(handler, batch, 64);
+		Assert.assertTrue(count > 0);
+		long[] expected = new long[1];
+		long[] actual = new long[1];
+		int matched = interpreted.matches(batch, expected);
+		Assert.assertEquals(matched, compiled.matches(batch, actual));
+		Assert.assertArrayEquals(expected, actual);
+
+		long start = System.nanoTime();
+		for (int i = 0; i < ROUNDS; i++) {
+			interpreted.matches(batch, expected);
+		}
+		long interpreterTime = System.nanoTime() - start;
+		start = System.nanoTime();
+		for (int i = 0; i < ROUNDS; i++) {
+			compiled.matches(batch, actual);
+		}
+		long jitTime = System.nanoTime() - start;
+		System.out.println("BPF JIT (native code: " + jit + "), " + ROUNDS * count + " packets: interpreter "
+				+ interpreterTime / 1000000 + " ms, jit " + jitTime / 1000000 + " ms.");
+		PcapClose(handler);
+
+		handler = open();
+		Assert.assertEquals(0, PcapSetJitFilter(handler, compiled));
+		PcapFreeCode(compiled);
+		Assert.assertEquals(matched, PcapDispatchBatch(handler, batch, count));
+		while (batch.next()) {
+			ByteBuffer packet = batch.getBuffer().duplicate();
+			packet.limit(batch.getDataOffset() + batch.getCapLen()).position(batch.getDataOffset());
+			Assert.assertTrue(interpreted.matches(packet, batch.getLen()));
+		}
+		PcapFreeCode(interpreted);
+		PcapClose(handler);
+	}
+
+}
@@ -0,0 +1,53 @@
+package com.ardikars.test;
+
+import com.ardikars.jxnet.BpfProgram;
+import com.ardikars.jxnet.Pcap;
+import com.ardikars.jxnet.PcapPktBatch;
+import com.ardikars.jxnet.exception.JxnetException;
+import com.ardikars.jxnet.exception.PcapCloseException;
+import org.junit.Assert;
+import org.junit.Test;
+
+import java.nio.ByteBuffer;
+
+import static com.ardikars.jxnet.Jxnet.*;
+
+public class BpfMatches {
+
+	@Test
+	public void run() throws PcapCloseException {
+		StringBuilder errbuf = new StringBuilder();
+		Pcap handler = PcapOpenOffline("../sample-capture/eth_ipv4_tcp.pcapng", errbuf);
+		if (handler == null) {
+			throw new PcapCloseException(errbuf.toString());
+		}
+		BpfProgram fp = new BpfProgram();
+		if (PcapCompile(handler, fp, "tcp", AllTests.optimize, AllTests.netmask) != 0) {
+			String err = PcapGetErr(handler);
+			PcapClose(handler);
+			throw new JxnetException(err);
+		}
+		PcapPktBatch batch = new PcapPktBatch(PcapSnapshot(handler) * 8);
+		long[] bitmap = new long[1];
+		int r;
+		while ((r = PcapDispatchBatch(handler, batch, 8)) > 0) {
+			int matched = fp.matches(batch, bitmap);
+			int expected = 0;
+			int i = 0;
+			while (batch.next()) {
+				ByteBuffer packet = batch.getBuffer().duplicate();
+				packet.limit(batch.getDataOffset() + batch.getCapLen()).position(batch.getDataOffset());
+				boolean match = fp.matches(packet, batch.getLen());
+				Assert.assertEquals(match, (bitmap[0] & (1L << i)) != 0);
+				if (match) {
+					expected++;
+				}
+				i++;
+			}
+			Assert.assertEquals(expected, matched);
+		}
+		PcapFreeCode(fp);
+		PcapClose(handler);
+	}
+
+}
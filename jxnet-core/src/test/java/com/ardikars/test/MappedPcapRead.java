@@ -0,0 +1,57 @@
+package com.ardikars.test;
+
+import com.ardikars.jxnet.MappedPcap;
+import com.ardikars.jxnet.Pcap;
+import com.ardikars.jxnet.PcapPktHdr;
+import com.ardikars.jxnet.exception.PcapCloseException;
+import org.junit.Assert;
+import org.junit.Test;
+
+import java.nio.ByteBuffer;
+
+import static com.ardikars.jxnet.Jxnet.*;
+
+public class MappedPcapRead {
+
+	private static final String FILE = "../sample-capture/eth_vlan_ipv4_tcp.cap";
+
+	private void compare(int windowSize) throws PcapCloseException {
+		StringBuilder errbuf = new StringBuilder();
+		Pcap handler = PcapOpenOffline(FILE, errbuf);
+		if (handler == null) {
+			throw new PcapCloseException(errbuf.toString());
+		}
+		MappedPcap file = MappedPcap.open(FILE, windowSize, errbuf);
+		if (file == null) {
+			PcapClose(handler);
+			throw new PcapCloseException(errbuf.toString());
+		}
+		Assert.assertEquals(PcapSnapshot(handler), file.getSnapshotLength());
+		Assert.assertEquals((short) PcapDataLink(handler), file.getDataLinkType().getValue());
+		int count = 0;
+		PcapPktHdr pktHdr = new PcapPktHdr();
+		ByteBuffer expected;
+		while ((expected = PcapNext(handler, pktHdr)) != null) {
+			Assert.assertTrue(file.next());
+			Assert.assertEquals(pktHdr.getCapLen(), file.getCapLen());
+			Assert.assertEquals(pktHdr.getLen(), file.getLen());
+			Assert.assertEquals(pktHdr.getTvSec(), file.getTvSec());
+			Assert.assertEquals(pktHdr.getTvUsec(), file.getTvUsec());
+			expected.limit(pktHdr.getCapLen()).position(0);
+			Assert.assertEquals(expected, file.getPacket());
+			count++;
+		}
+		Assert.assertFalse(file.next());
+		Assert.assertEquals(file.getSize(), file.getPosition());
+		System.out.println("Mapped " + count + " packets, window size " + windowSize + ".");
+		file.close();
+		PcapClose(handler);
+	}
+
+	@Test
+	public void run() throws PcapCloseException {
+		compare(MappedPcap.DEFAULT_WINDOW_SIZE);
+		compare(MappedPcap.FILE_HEADER_LENGTH);
+	}
+
+}
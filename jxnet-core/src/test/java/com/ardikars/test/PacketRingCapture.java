@@ -0,0 +1,41 @@
+package com.ardikars.test;
+
+import com.ardikars.jxnet.PacketRing;
+import com.ardikars.jxnet.util.Platforms;
+import org.junit.Assert;
+import org.junit.Test;
+
+import java.nio.ByteBuffer;
+
+public class PacketRingCapture {
+
+	@Test
+	public void run() {
+		if (!Platforms.isLinux()) {
+			return;
+		}
+		StringBuilder errbuf = new StringBuilder();
+		PacketRing ring = PacketRing.open(AllTests.deviceName, 1 << 16, 8, AllTests.to_ms, AllTests.promisc == 1, errbuf);
+		if (ring == null) {
+			throw new IllegalStateException(errbuf.toString());
+		}
+		for (int i = 0; i < AllTests.maxIteration; i++) {
+			ByteBuffer block = ring.nextBlock(AllTests.to_ms);
+			if (block == null) {
+				continue;
+			}
+			while (ring.next()) {
+				System.out.println("Header : [Capture Length: " + ring.getCapLen()
+						+ ", Length: " + ring.getLen()
+						+ ", TvSec: " + ring.getTvSec()
+						+ ", TvNSec: " + ring.getTvNsec() + "]");
+				Assert.assertTrue(ring.getCapLen() <= ring.getLen());
+				Assert.assertTrue(ring.getDataOffset() + ring.getCapLen() <= block.capacity());
+			}
+			ring.releaseBlock();
+		}
+		ring.close();
+		Assert.assertTrue(ring.isClosed());
+	}
+
+}
@@ -0,0 +1,81 @@
+package com.ardikars.test;
+
+import com.ardikars.jxnet.BpfProgram;
+import com.ardikars.jxnet.MappedPcap;
+import com.ardikars.jxnet.ParallelPcapReader;
+import com.ardikars.jxnet.PcapHandler;
+import com.ardikars.jxnet.PcapPktHdr;
+import com.ardikars.jxnet.exception.JxnetException;
+import com.ardikars.jxnet.exception.PcapCloseException;
+import org.junit.Assert;
+import org.junit.Test;
+
+import java.nio.ByteBuffer;
+import java.util.ArrayList;
+import java.util.List;
+import java.util.concurrent.atomic.AtomicLong;
+import java.util.function.Consumer;
+
+import static com.ardikars.jxnet.Jxnet.*;
+
+public class ParallelRead {
+
+	private static final String FILE = "../sample-capture/eth_vlan_ipv4_tcp.cap";
+
+	private static final String FILTER = "tcp";
+
+	@Test
+	public void run() throws PcapCloseException {
+		StringBuilder errbuf = new StringBuilder();
+		MappedPcap file = MappedPcap.open(FILE, errbuf);
+		if (file == null) {
+			throw new PcapCloseException(errbuf.toString());
+		}
+		BpfProgram fp = new BpfProgram();
+		if (PcapCompileNoPcap(file.getSnapshotLength(), file.getDataLinkType().getValue(), fp, FILTER,
+				AllTests.optimize, AllTests.netmask) != 0) {
+			file.close();
+			throw new JxnetException("Failed to compile filter.");
+		}
+		List<Long> expected = new ArrayList<Long>();
+		while (file.next()) {
+			if (fp.matches(file.getPacket(), file.getLen())) {
+				expected.add(file.getTvSec() * 1000000 + file.getTvUsec());
+			}
+		}
+		PcapFreeCode(fp);
+		file.close();
+
+		ParallelPcapReader reader = ParallelPcapReader.open(FILE, 4, 512, errbuf);
+		if (reader == null) {
+			throw new PcapCloseException(errbuf.toString());
+		}
+		Assert.assertEquals(0, reader.setFilter(FILTER, AllTests.optimize, AllTests.netmask));
+		Assert.assertTrue(reader.getRangeCount() >= 4);
+
+		final AtomicLong count = new AtomicLong();
+		Assert.assertEquals(expected.size(), reader.loop(new PcapHandler<AtomicLong>() {
+			@Override
+			public void nextPacket(AtomicLong user, PcapPktHdr h, ByteBuffer bytes) {
+				user.incrementAndGet();
+			}
+		}, count));
+		Assert.assertEquals(expected.size(), count.get());
+
+		final List<Long> actual = new ArrayList<Long>();
+		Assert.assertEquals(expected.size(), reader.loopOrdered(new ParallelPcapReader.Decoder<Long>() {
+			@Override
+			public Long decode(PcapPktHdr h, ByteBuffer bytes) {
+				return h.getTvSec() * 1000000L + h.getTvUsec();
+			}
+		}, new Consumer<Long>() {
+			@Override
+			public void accept(Long value) {
+				actual.add(value);
+			}
+		}));
+		Assert.assertEquals(expected, actual);
+		reader.close();
+	}
+
+}
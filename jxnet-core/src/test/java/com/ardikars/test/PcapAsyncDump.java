@@ -0,0 +1,83 @@
+package com.ardikars.test;
+
+import com.ardikars.jxnet.MappedPcap;
+import com.ardikars.jxnet.Pcap;
+import com.ardikars.jxnet.PcapAsyncDumper;
+import com.ardikars.jxnet.PcapPktHdr;
+import com.ardikars.jxnet.exception.PcapCloseException;
+import org.junit.Assert;
+import org.junit.Test;
+
+import java.io.File;
+import java.io.IOException;
+import java.nio.ByteBuffer;
+
+import static com.ardikars.jxnet.Jxnet.*;
+
+public class PcapAsyncDump {
+
+	private static final String FILE = "../sample-capture/eth_vlan_ipv4_tcp.cap";
+
+	private Pcap open() throws PcapCloseException {
+		StringBuilder errbuf = new StringBuilder();
+		Pcap handler = PcapOpenOffline(FILE, errbuf);
+		if (handler == null) {
+			throw new PcapCloseException(errbuf.toString());
+		}
+		return handler;
+	}
+
+	private void compare(String path) throws PcapCloseException {
+		StringBuilder errbuf = new StringBuilder();
+		MappedPcap expected = MappedPcap.open(FILE, errbuf);
+		MappedPcap actual = MappedPcap.open(path, errbuf);
+		if (expected == null || actual == null) {
+			throw new PcapCloseException(errbuf.toString());
+		}
+		Assert.assertEquals(expected.getDataLinkType(), actual.getDataLinkType());
+		while (expected.next()) {
+			Assert.assertTrue(actual.next());
+			Assert.assertEquals(expected.getTimestamp(), actual.getTimestamp());
+			Assert.assertEquals(expected.getLen(), actual.getLen());
+			Assert.assertEquals(expected.getPacket(), actual.getPacket());
+		}
+		Assert.assertFalse(actual.next());
+		expected.close();
+		actual.close();
+	}
+
+	@Test
+	public void run() throws PcapCloseException, IOException {
+		StringBuilder errbuf = new StringBuilder();
+		File file = File.createTempFile("jxnet", ".pcap");
+
+		Pcap handler = open();
+		PcapAsyncDumper dumper = PcapAsyncDumper.open(handler, file.getAbsolutePath(), 4096, 4, false, 0, errbuf);
+		if (dumper == null) {
+			PcapClose(handler);
+			throw new PcapCloseException(errbuf.toString());
+		}
+		Assert.assertEquals(0, dumper.loop(handler, -1));
+		System.out.println("Queued: " + dumper.getPackets() + ", dropped: " + dumper.getDropped()
+				+ ", queue depth: " + dumper.getQueueDepth() + ".");
+		long packets = dumper.getPackets();
+		dumper.close();
+		PcapClose(handler);
+		Assert.assertEquals(file.length() > 0, packets > 0);
+
+		handler = open();
+		dumper = PcapAsyncDumper.open(handler, file.getAbsolutePath(), errbuf);
+		PcapPktHdr pktHdr = new PcapPktHdr();
+		ByteBuffer buf;
+		while ((buf = PcapNext(handler, pktHdr)) != null) {
+			Assert.assertTrue(dumper.dump(pktHdr, buf));
+		}
+		Assert.assertEquals(0, dumper.getDropped());
+		dumper.close();
+		PcapClose(handler);
+		compare(file.getAbsolutePath());
+
+		file.delete();
+	}
+
+}
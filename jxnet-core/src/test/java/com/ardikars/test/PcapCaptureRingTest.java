@@ -0,0 +1,45 @@
+package com.ardikars.test;
+
+import com.ardikars.jxnet.Pcap;
+import com.ardikars.jxnet.PcapCaptureRing;
+import com.ardikars.jxnet.exception.PcapCloseException;
+import com.ardikars.jxnet.util.Platforms;
+import org.junit.Assert;
+import org.junit.Test;
+
+import static com.ardikars.jxnet.Jxnet.*;
+
+public class PcapCaptureRingTest {
+
+	@Test
+	public void run() throws PcapCloseException {
+		if (Platforms.isWindows()) {
+			return;
+		}
+		StringBuilder errbuf = new StringBuilder();
+		Pcap handler = PcapOpenOffline("../sample-capture/eth_ipv4_tcp.pcapng", errbuf);
+		if (handler == null) {
+			throw new PcapCloseException(errbuf.toString());
+		}
+		PcapCaptureRing ring = PcapCaptureRing.start(handler, 1 << 16);
+		int total = 0;
+		while (!ring.isFinished()) {
+			if (!ring.next()) {
+				Thread.yield();
+				continue;
+			}
+			System.out.println("Header : [Capture Length: " + ring.getCapLen()
+					+ ", Length: " + ring.getLen()
+					+ ", TvSec: " + ring.getTvSec()
+					+ ", TvUSec: " + ring.getTvUsec() + "]");
+			Assert.assertTrue(ring.getCapLen() <= ring.getLen());
+			total++;
+		}
+		Assert.assertFalse(ring.isError());
+		Assert.assertTrue(total > 0);
+		System.out.println("Dropped : " + ring.getDropped());
+		ring.close();
+		PcapClose(handler);
+	}
+
+}
@@ -0,0 +1,124 @@
+package com.ardikars.test;
+
+import com.ardikars.jxnet.Pcap;
+import com.ardikars.jxnet.PcapCompression;
+import com.ardikars.jxnet.PcapDumper;
+import com.ardikars.jxnet.PcapPktHdr;
+import com.ardikars.jxnet.exception.PcapCloseException;
+import org.junit.Assert;
+import org.junit.Assume;
+import org.junit.Test;
+
+import java.io.DataInputStream;
+import java.io.File;
+import java.io.FileInputStream;
+import java.io.FileOutputStream;
+import java.io.IOException;
+import java.io.InputStream;
+import java.io.OutputStream;
+import java.nio.ByteBuffer;
+
+import static com.ardikars.jxnet.Jxnet.*;
+
+public class PcapCompressedDump {
+
+	private static final String FILE = "../sample-capture/eth_ipv4_tcp.pcapng";
+
+	private Pcap open(String path) throws PcapCloseException {
+		StringBuilder errbuf = new StringBuilder();
+		Pcap handler = PcapOpenOffline(path, errbuf);
+		if (handler == null) {
+			throw new PcapCloseException(errbuf.toString());
+		}
+		return handler;
+	}
+
+	@Test
+	public void run() throws PcapCloseException, IOException {
+		File file = File.createTempFile("jxnet", ".pcap.gz");
+		Pcap handler = open(FILE);
+		PcapDumper dumper = PcapDumpOpenCompressed(handler, file.getAbsolutePath(), PcapCompression.GZIP, -1);
+		PcapPktHdr pktHdr = new PcapPktHdr();
+		ByteBuffer buf;
+		int count = 0;
+		while ((buf = PcapNext(handler, pktHdr)) != null) {
+			PcapDump(dumper, pktHdr, buf);
+			count++;
+		}
+		long uncompressed = PcapDumpFTell(dumper);
+		PcapDumpClose(dumper);
+		PcapClose(handler);
+
+		DataInputStream in = new DataInputStream(new FileInputStream(file));
+		Assert.assertEquals(0x1f8b, in.readUnsignedShort());
+		in.close();
+		System.out.println("Compressed " + uncompressed + " bytes to " + file.length() + " bytes.");
+
+		Pcap expected = open(FILE);
+		Pcap actual = open(file.getAbsolutePath());
+		PcapPktHdr actualHdr = new PcapPktHdr();
+		ByteBuffer expectedBuf;
+		while ((expectedBuf = PcapNext(expected, pktHdr)) != null) {
+			ByteBuffer actualBuf = PcapNext(actual, actualHdr);
+			Assert.assertNotNull(actualBuf);
+			Assert.assertEquals(pktHdr.getCapLen(), actualHdr.getCapLen());
+			Assert.assertEquals(pktHdr.getTvSec(), actualHdr.getTvSec());
+			Assert.assertEquals(expectedBuf, actualBuf);
+			count--;
+		}
+		Assert.assertNull(PcapNext(actual, actualHdr));
+		Assert.assertEquals(0, count);
+		PcapClose(expected);
+		PcapClose(actual);
+		file.delete();
+	}
+
+	@Test
+	public void pipe() throws PcapCloseException, IOException, InterruptedException {
+		final File fifo = new File(System.getProperty("java.io.tmpdir"), "jxnet-" + System.nanoTime() + ".fifo");
+		int status;
+		try {
+			status = new ProcessBuilder("mkfifo", fifo.getAbsolutePath()).start().waitFor();
+		} catch (IOException e) {
+			status = -1;
+		}
+		Assume.assumeTrue(status == 0);
+		Thread writer = new Thread(new Runnable() {
+			@Override
+			public void run() {
+				try {
+					InputStream in = new FileInputStream(FILE);
+					OutputStream out = new FileOutputStream(fifo);
+					byte[] buf = new byte[4096];
+					int len;
+					while ((len = in.read(buf)) > 0) {
+						out.write(buf, 0, len);
+					}
+					out.close();
+					in.close();
+				} catch (IOException e) {
+					e.printStackTrace();
+				}
+			}
+		});
+		writer.start();
+
+		Pcap expected = open(FILE);
+		Pcap actual = open(fifo.getAbsolutePath());
+		PcapPktHdr pktHdr = new PcapPktHdr();
+		PcapPktHdr actualHdr = new PcapPktHdr();
+		ByteBuffer expectedBuf;
+		while ((expectedBuf = PcapNext(expected, pktHdr)) != null) {
+			ByteBuffer actualBuf = PcapNext(actual, actualHdr);
+			Assert.assertNotNull(actualBuf);
+			Assert.assertEquals(pktHdr.getCapLen(), actualHdr.getCapLen());
+			Assert.assertEquals(expectedBuf, actualBuf);
+		}
+		Assert.assertNull(PcapNext(actual, actualHdr));
+		PcapClose(expected);
+		PcapClose(actual);
+		writer.join();
+		fifo.delete();
+	}
+
+}
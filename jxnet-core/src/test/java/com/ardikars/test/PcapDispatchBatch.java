@@ -0,0 +1,38 @@
+package com.ardikars.test;
+
+import com.ardikars.jxnet.Pcap;
+import com.ardikars.jxnet.PcapPktBatch;
+import com.ardikars.jxnet.exception.PcapCloseException;
+import org.junit.Assert;
+import org.junit.Test;
+
+import static com.ardikars.jxnet.Jxnet.*;
+
+public class PcapDispatchBatch {
+
+	@Test
+	public void run() throws PcapCloseException {
+		StringBuilder errbuf = new StringBuilder();
+		Pcap handler = PcapOpenOffline("../sample-capture/eth_ipv4_tcp.pcapng", errbuf);
+		if (handler == null) {
+			throw new PcapCloseException(errbuf.toString());
+		}
+		PcapPktBatch batch = new PcapPktBatch(PcapSnapshot(handler) * 4);
+		int total = 0;
+		int r;
+		while ((r = PcapDispatchBatch(handler, batch, AllTests.maxIteration)) > 0) {
+			Assert.assertEquals(r, batch.getCount());
+			while (batch.next()) {
+				System.out.println("Header : [Capture Length: " + batch.getCapLen()
+						+ ", Length: " + batch.getLen()
+						+ ", TvSec: " + batch.getTvSec()
+						+ ", TvUSec: " + batch.getTvUsec() + "]");
+				Assert.assertTrue(batch.getCapLen() <= batch.getLen());
+				total++;
+			}
+		}
+		Assert.assertTrue(total > 0);
+		PcapClose(handler);
+	}
+
+}
@@ -0,0 +1,106 @@
+package com.ardikars.test;
+
+import com.ardikars.jxnet.Pcap;
+import com.ardikars.jxnet.PcapPktBatch;
+import com.ardikars.jxnet.PcapPktSummary;
+import com.ardikars.jxnet.exception.PcapCloseException;
+import org.junit.Assert;
+import org.junit.Test;
+
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+
+import static com.ardikars.jxnet.Jxnet.*;
+
+public class PcapDispatchSummary {
+
+	private static Pcap open(String file) throws PcapCloseException {
+		StringBuilder errbuf = new StringBuilder();
+		Pcap handler = PcapOpenOffline("../sample-capture/" + file, errbuf);
+		if (handler == null) {
+			throw new PcapCloseException(errbuf.toString());
+		}
+		return handler;
+	}
+
+	@Test
+	public void ipv4Tcp() throws PcapCloseException {
+		Pcap handler = open("eth_ipv4_tcp.pcapng");
+		Pcap raw = open("eth_ipv4_tcp.pcapng");
+		PcapPktSummary summary = new PcapPktSummary(8);
+		PcapPktBatch batch = new PcapPktBatch(PcapSnapshot(raw) * 8);
+		int total = 0;
+		while (PcapDispatchSummary(handler, summary, 8) > 0) {
+			Assert.assertEquals(summary.getCount(), PcapDispatchBatch(raw, batch, summary.getCount()));
+			for (int i = 0; i < summary.getCount(); i++) {
+				Assert.assertTrue(batch.next());
+				Assert.assertEquals(batch.getCapLen(), summary.getCapLen().get(i));
+				Assert.assertEquals(batch.getLen(), summary.getLen().get(i));
+				Assert.assertEquals(batch.getTvSec(), summary.getTvSec().get(i));
+				if (summary.getEtherType().get(i) != 0x0800) {
+					continue;
+				}
+				// compare with the headers of the same packet
+				ByteBuffer data = batch.getBuffer().duplicate().order(ByteOrder.BIG_ENDIAN);
+				int ip = batch.getDataOffset() + 14;
+				int tcp = ip + (data.get(ip) & 0x0f) * 4;
+				Assert.assertEquals(-1, summary.getVlan().get(i));
+				Assert.assertEquals(4, summary.getIpVersion().get(i));
+				Assert.assertEquals(data.get(ip + 9), summary.getProtocol().get(i));
+				Assert.assertEquals(data.getInt(ip + 12), summary.getSrcIp().get(i));
+				Assert.assertEquals(data.getInt(ip + 16), summary.getDstIp().get(i));
+				if (summary.getProtocol().get(i) == 6) {
+					Assert.assertEquals(data.getShort(tcp), summary.getSrcPort().get(i));
+					Assert.assertEquals(data.getShort(tcp + 2), summary.getDstPort().get(i));
+					Assert.assertEquals(data.getShort(tcp + 12) & 0x1ff, summary.getTcpFlags().get(i));
+					int payloadOffset = tcp - batch.getDataOffset() + ((data.get(tcp + 12) >> 4) & 0xf) * 4;
+					Assert.assertEquals(payloadOffset, summary.getPayloadOffset().get(i));
+					Assert.assertEquals((data.getShort(ip + 2) & 0xffff) - (payloadOffset - 14),
+							summary.getPayloadLength().get(i));
+				}
+				total++;
+			}
+		}
+		Assert.assertTrue(total > 0);
+		PcapClose(handler);
+		PcapClose(raw);
+	}
+
+	@Test
+	public void vlan() throws PcapCloseException {
+		Pcap handler = open("eth_vlan_ipv4_tcp.cap");
+		PcapPktSummary summary = new PcapPktSummary(64);
+		int tagged = 0;
+		while (PcapDispatchSummary(handler, summary, 64) > 0) {
+			for (int i = 0; i < summary.getCount(); i++) {
+				if (summary.getVlan().get(i) != -1) {
+					Assert.assertNotEquals(0x8100, summary.getEtherType().get(i) & 0xffff);
+					tagged++;
+				}
+			}
+		}
+		Assert.assertTrue(tagged > 0);
+		PcapClose(handler);
+	}
+
+	@Test
+	public void icmpv6() throws PcapCloseException {
+		Pcap handler = open("eth-ipv6-icmpv6_ping.cap");
+		PcapPktSummary summary = new PcapPktSummary(64);
+		int echo = 0;
+		while (PcapDispatchSummary(handler, summary, 64) > 0) {
+			for (int i = 0; i < summary.getCount(); i++) {
+				if (summary.getIpVersion().get(i) == 6 && summary.getProtocol().get(i) == 58) {
+					int type = summary.getSrcPort().get(i);
+					if (type == 128 || type == 129) {
+						echo++;
+					}
+					Assert.assertEquals(0, summary.getSrcIp().get(i));
+				}
+			}
+		}
+		Assert.assertTrue(echo > 0);
+		PcapClose(handler);
+	}
+
+}
@@ -0,0 +1,78 @@
+package com.ardikars.test;
+
+import com.ardikars.jxnet.Pcap;
+import com.ardikars.jxnet.PcapDumper;
+import com.ardikars.jxnet.PcapPktBatch;
+import com.ardikars.jxnet.PcapPktHdr;
+import com.ardikars.jxnet.exception.PcapCloseException;
+import org.junit.Assert;
+import org.junit.Test;
+
+import java.io.File;
+import java.io.IOException;
+import java.nio.ByteBuffer;
+
+import static com.ardikars.jxnet.Jxnet.*;
+
+public class PcapDumpBatch {
+
+	private static final String FILE = "../sample-capture/eth_ipv4_tcp.pcapng";
+
+	private Pcap open(String path) throws PcapCloseException {
+		StringBuilder errbuf = new StringBuilder();
+		Pcap handler = PcapOpenOffline(path, errbuf);
+		if (handler == null) {
+			throw new PcapCloseException(errbuf.toString());
+		}
+		return handler;
+	}
+
+	@Test
+	public void run() throws PcapCloseException, IOException {
+		File file = File.createTempFile("jxnet", ".pcap");
+		Pcap handler = open(FILE);
+		PcapDumper dumper = PcapDumpOpen(handler, file.getAbsolutePath());
+		PcapPktBatch batch = new PcapPktBatch(PcapSnapshot(handler) * 4);
+		int count = 0;
+		boolean heap = false;
+		while (PcapDispatchBatch(handler, batch, 4) > 0) {
+			if (heap) {
+				// the same records from a heap array
+				byte[] array = new byte[batch.getBuffer().capacity()];
+				ByteBuffer copy = batch.getBuffer().duplicate();
+				copy.clear();
+				copy.get(array);
+				Assert.assertEquals(batch.getCount(), PcapDumpBatch(dumper, array, batch.getCount()));
+			} else {
+				Assert.assertEquals(batch.getCount(), PcapDumpBatch(dumper, batch));
+			}
+			count += batch.getCount();
+			heap = !heap;
+		}
+		PcapDumpClose(dumper);
+		PcapClose(handler);
+		Assert.assertTrue(count > 0);
+
+		Pcap expected = open(FILE);
+		Pcap actual = open(file.getAbsolutePath());
+		PcapPktHdr expectedHdr = new PcapPktHdr();
+		PcapPktHdr actualHdr = new PcapPktHdr();
+		ByteBuffer expectedBuf;
+		while ((expectedBuf = PcapNext(expected, expectedHdr)) != null) {
+			ByteBuffer actualBuf = PcapNext(actual, actualHdr);
+			Assert.assertNotNull(actualBuf);
+			Assert.assertEquals(expectedHdr.getCapLen(), actualHdr.getCapLen());
+			Assert.assertEquals(expectedHdr.getLen(), actualHdr.getLen());
+			Assert.assertEquals(expectedHdr.getTvSec(), actualHdr.getTvSec());
+			Assert.assertEquals(expectedHdr.getTvUsec(), actualHdr.getTvUsec());
+			Assert.assertEquals(expectedBuf, actualBuf);
+			count--;
+		}
+		Assert.assertNull(PcapNext(actual, actualHdr));
+		Assert.assertEquals(0, count);
+		PcapClose(expected);
+		PcapClose(actual);
+		file.delete();
+	}
+
+}
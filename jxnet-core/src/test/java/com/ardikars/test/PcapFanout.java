@@ -0,0 +1,40 @@
+package com.ardikars.test;
+
+import com.ardikars.jxnet.PcapFanoutGroup;
+import com.ardikars.jxnet.PcapFanoutMode;
+import com.ardikars.jxnet.PcapHandler;
+import com.ardikars.jxnet.PcapStat;
+import com.ardikars.jxnet.PromiscuousMode;
+import com.ardikars.jxnet.exception.JxnetException;
+import com.ardikars.jxnet.util.Platforms;
+import org.junit.Assert;
+import org.junit.Test;
+
+public class PcapFanout {
+
+	@Test
+	public void run() throws InterruptedException {
+		if (!Platforms.isLinux()) {
+			return;
+		}
+		StringBuilder errbuf = new StringBuilder();
+		PcapFanoutGroup group = PcapFanoutGroup.open(AllTests.deviceName, 2, 42, PcapFanoutMode.HASH,
+				AllTests.snaplen, PromiscuousMode.PRIMISCUOUS, AllTests.to_ms, errbuf);
+		if (group == null) {
+			throw new JxnetException(errbuf.toString());
+		}
+		PcapHandler<String> callback = (user, h, bytes) -> {
+			System.out.println(Thread.currentThread().getName() + " : " + h);
+		};
+		group.start(AllTests.maxIteration, callback, null);
+		Thread.sleep(AllTests.to_ms * 2);
+		group.stop();
+		PcapStat[] stats = group.getStats();
+		Assert.assertEquals(group.size(), stats.length);
+		for (PcapStat stat : stats) {
+			System.out.println(stat);
+		}
+		group.close();
+	}
+
+}
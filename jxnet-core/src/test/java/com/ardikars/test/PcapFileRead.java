@@ -0,0 +1,92 @@
+package com.ardikars.test;
+
+import com.ardikars.jxnet.Pcap;
+import com.ardikars.jxnet.PcapFileReader;
+import com.ardikars.jxnet.PcapPktHdr;
+import com.ardikars.jxnet.exception.PcapCloseException;
+import org.junit.Assert;
+import org.junit.Test;
+
+import java.io.DataOutputStream;
+import java.io.File;
+import java.io.FileOutputStream;
+import java.io.IOException;
+import java.nio.ByteBuffer;
+
+import static com.ardikars.jxnet.Jxnet.*;
+
+public class PcapFileRead {
+
+	private static final String CAP = "../sample-capture/eth_vlan_ipv4_tcp.cap";
+
+	private static final String PCAPNG = "../sample-capture/eth_ipv4_tcp.pcapng";
+
+	private void compare(String expectedPath, String path, int chunkSize) throws PcapCloseException, IOException {
+		StringBuilder errbuf = new StringBuilder();
+		Pcap handler = PcapOpenOffline(expectedPath, errbuf);
+		if (handler == null) {
+			throw new PcapCloseException(errbuf.toString());
+		}
+		PcapFileReader file = PcapFileReader.open(path, chunkSize);
+		int count = 0;
+		PcapPktHdr pktHdr = new PcapPktHdr();
+		ByteBuffer expected;
+		while ((expected = PcapNext(handler, pktHdr)) != null) {
+			Assert.assertTrue(file.next());
+			Assert.assertEquals((short) PcapDataLink(handler), file.getDataLinkType().getValue());
+			Assert.assertEquals(pktHdr.getCapLen(), file.getCapLen());
+			Assert.assertEquals(pktHdr.getLen(), file.getLen());
+			Assert.assertEquals(pktHdr.getTvSec(), file.getTvSec());
+			Assert.assertEquals(pktHdr.getTvUsec(), file.getTvUsec());
+			expected.limit(pktHdr.getCapLen()).position(0);
+			Assert.assertEquals(expected, file.getPacket());
+			count++;
+		}
+		Assert.assertFalse(file.next());
+		Assert.assertTrue(count > 0);
+		System.out.println("Read " + count + " packets from " + path + ", chunk size " + chunkSize + ".");
+		file.close();
+		PcapClose(handler);
+	}
+
+	/**
+	 * Rewrite a classic pcap file in big endian.
+	 */
+	private File swap(String path) throws IOException {
+		File swapped = File.createTempFile("jxnet", ".pcap");
+		PcapFileReader file = PcapFileReader.open(path);
+		DataOutputStream out = new DataOutputStream(new FileOutputStream(swapped));
+		out.writeInt(0xa1b2c3d4);
+		out.writeShort(2);
+		out.writeShort(4);
+		out.writeInt(0);
+		out.writeInt(0);
+		out.writeInt(file.getSnapshotLength());
+		out.writeInt(file.getDataLinkType().getValue());
+		while (file.next()) {
+			out.writeInt((int) file.getTvSec());
+			out.writeInt((int) file.getTvUsec());
+			out.writeInt(file.getCapLen());
+			out.writeInt(file.getLen());
+			ByteBuffer packet = file.getPacket();
+			byte[] data = new byte[packet.remaining()];
+			packet.get(data);
+			out.write(data);
+		}
+		out.close();
+		file.close();
+		return swapped;
+	}
+
+	@Test
+	public void run() throws PcapCloseException, IOException {
+		compare(CAP, CAP, PcapFileReader.DEFAULT_CHUNK_SIZE);
+		compare(CAP, CAP, 24);
+		compare(PCAPNG, PCAPNG, PcapFileReader.DEFAULT_CHUNK_SIZE);
+		compare(PCAPNG, PCAPNG, 24);
+		File swapped = swap(CAP);
+		compare(CAP, swapped.getAbsolutePath(), 4096);
+		swapped.delete();
+	}
+
+}
@@ -0,0 +1,97 @@
+package com.ardikars.test;
+
+import com.ardikars.jxnet.MappedPcap;
+import com.ardikars.jxnet.Pcap;
+import com.ardikars.jxnet.PcapIndex;
+import com.ardikars.jxnet.PcapIndexWriter;
+import com.ardikars.jxnet.PcapPktHdr;
+import com.ardikars.jxnet.exception.JxnetException;
+import com.ardikars.jxnet.exception.PcapCloseException;
+import org.junit.Assert;
+import org.junit.Test;
+
+import java.io.File;
+import java.io.IOException;
+import java.nio.ByteBuffer;
+import java.util.ArrayList;
+import java.util.List;
+
+import static com.ardikars.jxnet.Jxnet.*;
+
+public class PcapIndexRange {
+
+	private static final int INTERVAL = 4;
+
+	@Test
+	public void run() throws PcapCloseException, IOException {
+		StringBuilder errbuf = new StringBuilder();
+		Pcap handler = PcapOpenOffline("../sample-capture/eth_vlan_ipv4_tcp.cap", errbuf);
+		if (handler == null) {
+			throw new PcapCloseException(errbuf.toString());
+		}
+		File file = File.createTempFile("jxnet", ".pcap");
+		String path = file.getAbsolutePath();
+		PcapIndexWriter writer = PcapIndexWriter.open(handler, path, INTERVAL);
+		if (writer == null) {
+			String err = PcapGetErr(handler);
+			PcapClose(handler);
+			throw new JxnetException(err);
+		}
+		PcapPktHdr pktHdr = new PcapPktHdr();
+		ByteBuffer buf;
+		while ((buf = PcapNext(handler, pktHdr)) != null) {
+			writer.dump(pktHdr, buf);
+		}
+		writer.close();
+		PcapClose(handler);
+
+		PcapIndex built = PcapIndex.build(path, INTERVAL, errbuf);
+		PcapIndex loaded = PcapIndex.load(PcapIndex.sidecar(path));
+		Assert.assertTrue(built.getCount() > 2);
+		Assert.assertEquals(built.getCount(), loaded.getCount());
+		for (int i = 0; i < built.getCount(); i++) {
+			Assert.assertEquals(built.getTimestamp(i), loaded.getTimestamp(i));
+			Assert.assertEquals(built.getOffset(i), loaded.getOffset(i));
+		}
+
+		MappedPcap mapped = MappedPcap.open(path, errbuf);
+		List<Long> timestamps = new ArrayList<Long>();
+		while (mapped.next()) {
+			timestamps.add(mapped.getTimestamp());
+		}
+		mapped.close();
+		long fromTs = timestamps.get(timestamps.size() / 3);
+		long toTs = timestamps.get(timestamps.size() * 2 / 3);
+		List<Long> expected = new ArrayList<Long>();
+		for (Long timestamp : timestamps) {
+			if (timestamp >= fromTs && timestamp <= toTs) {
+				expected.add(timestamp);
+			}
+		}
+
+		MappedPcap range = MappedPcap.openRange(path, fromTs, toTs, errbuf);
+		Assert.assertTrue(range.getPosition() > MappedPcap.FILE_HEADER_LENGTH);
+		List<Long> actual = new ArrayList<Long>();
+		while (range.next()) {
+			actual.add(range.getTimestamp());
+		}
+		range.close();
+		Assert.assertEquals(expected, actual);
+
+		// a sidecar that does not match the savefile is not trusted
+		Assert.assertTrue(loaded.isCurrent(file));
+		Assert.assertTrue(file.setLastModified(file.lastModified() - 60000));
+		Assert.assertFalse(PcapIndex.load(PcapIndex.sidecar(path)).isCurrent(file));
+		range = MappedPcap.openRange(path, fromTs, toTs, errbuf);
+		actual.clear();
+		while (range.next()) {
+			actual.add(range.getTimestamp());
+		}
+		range.close();
+		Assert.assertEquals(expected, actual);
+
+		new File(PcapIndex.sidecar(path)).delete();
+		file.delete();
+	}
+
+}
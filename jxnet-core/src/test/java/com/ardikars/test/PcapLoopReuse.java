@@ -0,0 +1,41 @@
+package com.ardikars.test;
+
+import com.ardikars.jxnet.Pcap;
+import com.ardikars.jxnet.PcapHandler;
+import com.ardikars.jxnet.PcapPktHdr;
+import com.ardikars.jxnet.exception.PcapCloseException;
+import org.junit.Assert;
+import org.junit.Test;
+
+import java.util.concurrent.atomic.AtomicInteger;
+
+import static com.ardikars.jxnet.Jxnet.*;
+
+public class PcapLoopReuse {
+
+	@Test
+	public void run() throws PcapCloseException {
+		StringBuilder errbuf = new StringBuilder();
+		Pcap handler = PcapOpenOffline("../sample-capture/eth_ipv4_tcp.pcapng", errbuf);
+		if (handler == null) {
+			throw new PcapCloseException(errbuf.toString());
+		}
+		final PcapPktHdr[] firstHdr = new PcapPktHdr[1];
+		final AtomicInteger count = new AtomicInteger();
+		PcapHandler<String> callback = (user, h, bytes) -> {
+			if (firstHdr[0] == null) {
+				firstHdr[0] = h;
+			}
+			Assert.assertSame(firstHdr[0], h);
+			Assert.assertEquals(0, bytes.position());
+			Assert.assertEquals(h.getCapLen(), bytes.limit());
+			System.out.println("User   : " + user);
+			System.out.println("Header : " + h);
+			count.incrementAndGet();
+		};
+		PcapLoopReuse(handler, AllTests.maxIteration, callback, "Jxnet!");
+		Assert.assertTrue(count.get() > 0);
+		PcapClose(handler);
+	}
+
+}
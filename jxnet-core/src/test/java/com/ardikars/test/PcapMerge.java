@@ -0,0 +1,75 @@
+package com.ardikars.test;
+
+import com.ardikars.jxnet.Pcap;
+import com.ardikars.jxnet.PcapDumper;
+import com.ardikars.jxnet.PcapMerger;
+import com.ardikars.jxnet.PcapPktHdr;
+import com.ardikars.jxnet.exception.PcapCloseException;
+import org.junit.Assert;
+import org.junit.Test;
+
+import java.io.File;
+import java.io.IOException;
+
+import static com.ardikars.jxnet.Jxnet.*;
+
+public class PcapMerge {
+
+	private static final String FILE = "../sample-capture/eth_ipv4_tcp.pcapng";
+
+	private PcapMerger open() throws PcapCloseException {
+		StringBuilder errbuf = new StringBuilder();
+		PcapMerger merger = PcapMerger.open(new String[] { FILE, FILE }, errbuf);
+		if (merger == null) {
+			throw new PcapCloseException(errbuf.toString());
+		}
+		return merger;
+	}
+
+	private int count(String path) throws PcapCloseException {
+		StringBuilder errbuf = new StringBuilder();
+		Pcap handler = PcapOpenOffline(path, errbuf);
+		if (handler == null) {
+			throw new PcapCloseException(errbuf.toString());
+		}
+		int count = 0;
+		while (PcapNext(handler, new PcapPktHdr()) != null) {
+			count++;
+		}
+		PcapClose(handler);
+		return count;
+	}
+
+	@Test
+	public void run() throws PcapCloseException, IOException {
+		int packets = count(FILE);
+		Assert.assertTrue(packets > 0);
+
+		PcapMerger merger = open();
+		long previous = Long.MIN_VALUE;
+		int count = 0;
+		while (merger.next()) {
+			PcapPktHdr pktHdr = merger.getPktHdr();
+			long timestamp = (pktHdr.getTvSec() & 0xFFFFFFFFL) * 1000000L + pktHdr.getTvUsec();
+			Assert.assertTrue(timestamp >= previous);
+			Assert.assertEquals(count % 2, merger.getInput());
+			Assert.assertEquals(pktHdr.getCapLen(), merger.getPacket().remaining());
+			previous = timestamp;
+			count++;
+		}
+		Assert.assertEquals(packets * 2, count);
+		merger.close();
+
+		merger = open();
+		merger.setDeduplication(4);
+		File file = File.createTempFile("jxnet", ".pcap");
+		PcapDumper dumper = PcapDumpOpen(merger.getPcap(), file.getAbsolutePath());
+		Assert.assertEquals(packets, merger.dump(dumper));
+		Assert.assertEquals(packets, merger.getDuplicates());
+		PcapDumpClose(dumper);
+		merger.close();
+		Assert.assertEquals(packets, count(file.getAbsolutePath()));
+		file.delete();
+	}
+
+}
@@ -0,0 +1,71 @@
+package com.ardikars.test;
+
+import com.ardikars.jxnet.MappedPcap;
+import com.ardikars.jxnet.Pcap;
+import com.ardikars.jxnet.PcapPktHdr;
+import com.ardikars.jxnet.PcapRotatingDumper;
+import com.ardikars.jxnet.exception.JxnetException;
+import com.ardikars.jxnet.exception.PcapCloseException;
+import org.junit.Assert;
+import org.junit.Test;
+
+import java.io.File;
+import java.io.IOException;
+import java.nio.ByteBuffer;
+import java.util.ArrayList;
+import java.util.Collections;
+import java.util.List;
+
+import static com.ardikars.jxnet.Jxnet.*;
+
+public class PcapRotatingDump {
+
+	private static final int MAX_FILES = 3;
+
+	@Test
+	public void run() throws PcapCloseException, IOException {
+		StringBuilder errbuf = new StringBuilder();
+		Pcap handler = PcapOpenOffline("../sample-capture/eth_vlan_ipv4_tcp.cap", errbuf);
+		if (handler == null) {
+			throw new PcapCloseException(errbuf.toString());
+		}
+		File dir = File.createTempFile("jxnet", "");
+		Assert.assertTrue(dir.delete() && dir.mkdir());
+		final List<String> files = Collections.synchronizedList(new ArrayList<String>());
+		PcapRotatingDumper dumper = PcapRotatingDumper.open(handler, new File(dir, "ring").getAbsolutePath(),
+				16 * 1024, 0, MAX_FILES, new PcapRotatingDumper.FileListener() {
+			@Override
+			public void fileCompleted(String path) {
+				files.add(path);
+			}
+		});
+		if (dumper == null) {
+			String err = PcapGetErr(handler);
+			PcapClose(handler);
+			throw new JxnetException(err);
+		}
+		PcapPktHdr pktHdr = new PcapPktHdr();
+		ByteBuffer buf;
+		while ((buf = PcapNext(handler, pktHdr)) != null) {
+			dumper.dump(pktHdr, buf);
+		}
+		String last = dumper.getCurrentFile();
+		dumper.close();
+		PcapClose(handler);
+
+		System.out.println("Completed files: " + files);
+		Assert.assertTrue(files.size() > 1);
+		Assert.assertEquals(last, files.get(files.size() - 1));
+		File[] kept = dir.listFiles();
+		Assert.assertEquals(Math.min(files.size(), MAX_FILES), kept.length);
+		for (File file : kept) {
+			Assert.assertTrue(files.subList(files.size() - kept.length, files.size()).contains(file.getAbsolutePath()));
+			MappedPcap mapped = MappedPcap.open(file.getAbsolutePath(), errbuf);
+			Assert.assertTrue(mapped.next());
+			mapped.close();
+			file.delete();
+		}
+		dir.delete();
+	}
+
+}
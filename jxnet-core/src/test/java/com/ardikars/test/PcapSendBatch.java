@@ -0,0 +1,33 @@
+package com.ardikars.test;
+
+import com.ardikars.jxnet.Pcap;
+import com.ardikars.jxnet.exception.PcapCloseException;
+import org.junit.Assert;
+import org.junit.Test;
+
+import java.nio.ByteBuffer;
+
+import static com.ardikars.jxnet.Jxnet.*;
+
+public class PcapSendBatch {
+
+	@Test
+	public void run() throws PcapCloseException {
+		byte[] packet = HexUtils4Test.parseHex(AllTests.rawData);
+		int count = AllTests.maxIteration;
+		ByteBuffer buf = ByteBuffer.allocateDirect(packet.length * count);
+		int[] offsets = new int[count];
+		int[] lengths = new int[count];
+		for (int i = 0; i < count; i++) {
+			offsets[i] = buf.position();
+			lengths[i] = packet.length;
+			buf.put(packet);
+		}
+		Pcap handler = AllTests.openHandle(); // Exception already thrown
+		int sent = PcapSendBatch(handler, buf, offsets, lengths, count);
+		System.out.println("Sent : " + sent + " of " + count);
+		Assert.assertEquals(count, sent);
+		PcapClose(handler);
+	}
+
+}
@@ -3,11 +3,7 @@ package com.ardikars.jxnet.packet;
 import com.ardikars.jxnet.*;
 import com.ardikars.jxnet.exception.JxnetException;
 import com.ardikars.jxnet.exception.PcapCloseException;
-import com.ardikars.jxnet.packet.ethernet.Ethernet;
-import com.ardikars.jxnet.packet.radiotap.RadioTap;
-import com.ardikars.jxnet.packet.sll.SLL;
 
-import java.lang.reflect.ParameterizedType;
 import java.nio.ByteBuffer;
 
 public abstract class AbstractPacketListener<T, V extends Packet> implements Encoder<byte[], Packet>, Decoder<V, byte[]> {
@@ -16,6 +12,9 @@ public abstract class AbstractPacketListener<T, V extends Packet> implements Enc
     private Pcap pcap;
     private T userArgument;
     private PcapPktHdr pcapPktHdr;
+    private ByteBuffer sendBuffer;
+    private PacketDispatcher<V> dispatcher;
+    private final boolean encoderOverridden = overridesEncode(this.getClass());
 
     protected void initialize(int packetNumber, T userArgument, Pcap pcap, PcapPktHdr pktHdr) {
         this.packetNumber = packetNumber;
@@ -34,12 +33,18 @@ public abstract class AbstractPacketListener<T, V extends Packet> implements Enc
         e.printStackTrace();
     }
 
+    /**
+     * Send a packet, written straight into a reused direct buffer (see Packet.writeTo()),
+     * or encoded with encode() if a subclass overrides it.
+     * @param packet packet to send.
+     */
     public void sendPacket(Packet packet) {
-        byte[] data = encode(packet);
-        ByteBuffer buffer = ByteBuffer.allocateDirect(data.length);
-        buffer.put(data);
+        byte[] encoded = this.encoderOverridden ? this.encode(packet) : null;
+        int length = encoded != null ? encoded.length : packet.computeLength();
+        ByteBuffer buffer = sendBuffer(length);
+        write(buffer, packet, encoded);
         if (!this.pcap.isClosed()) {
-            if (Jxnet.PcapSendPacket(this.pcap, buffer, buffer.capacity()) != Jxnet.OK) {
+            if (Jxnet.PcapSendPacket(this.pcap, buffer, length) != Jxnet.OK) {
                 exceptionCaught(new JxnetException(Jxnet.PcapGetErr(this.pcap)));
             }
         } else {
@@ -47,6 +52,67 @@ public abstract class AbstractPacketListener<T, V extends Packet> implements Enc
         }
     }
 
+    /**
+     * Send packets with as few system calls as possible (see Jxnet.PcapSendBatch()),
+     * written or encoded like in sendPacket().
+     * @param packets packets to send.
+     * @return number of packets sent.
+     */
+    public int sendPackets(Packet... packets) {
+        if (packets.length == 0) {
+            return 0;
+        }
+        byte[][] encoded = this.encoderOverridden ? new byte[packets.length][] : null;
+        int[] offsets = new int[packets.length];
+        int[] lengths = new int[packets.length];
+        int size = 0;
+        for (int i = 0; i < packets.length; i++) {
+            if (encoded != null) {
+                encoded[i] = this.encode(packets[i]);
+            }
+            offsets[i] = size;
+            lengths[i] = encoded != null && encoded[i] != null ? encoded[i].length : packets[i].computeLength();
+            size += lengths[i];
+        }
+        ByteBuffer buffer = sendBuffer(size);
+        for (int i = 0; i < packets.length; i++) {
+            write(buffer, packets[i], encoded == null ? null : encoded[i]);
+        }
+        if (this.pcap.isClosed()) {
+            exceptionCaught(new PcapCloseException());
+            return 0;
+        }
+        int sent = Jxnet.PcapSendBatch(this.pcap, buffer, offsets, lengths, packets.length);
+        if (sent != packets.length) {
+            exceptionCaught(new JxnetException("Sent " + (sent < 0 ? 0 : sent) + " of " + packets.length + " packets."));
+        }
+        return sent < 0 ? 0 : sent;
+    }
+
+    private static void write(ByteBuffer buffer, Packet packet, byte[] encoded) {
+        if (encoded != null) {
+            buffer.put(encoded);
+        } else {
+            packet.writeTo(buffer);
+        }
+    }
+
+    private static boolean overridesEncode(Class<?> type) {
+        try {
+            return type.getMethod("encode", Packet.class).getDeclaringClass() != AbstractPacketListener.class;
+        } catch (NoSuchMethodException e) {
+            return false;
+        }
+    }
+
+    private ByteBuffer sendBuffer(int size) {
+        if (this.sendBuffer == null || this.sendBuffer.capacity() < size) {
+            this.sendBuffer = ByteBuffer.allocateDirect(Math.max(size, 2048));
+        }
+        this.sendBuffer.clear();
+        return this.sendBuffer;
+    }
+
     public void stop() {
         Jxnet.PcapBreakLoop(this.pcap);
     }
@@ -66,49 +132,14 @@ public abstract class AbstractPacketListener<T, V extends Packet> implements Enc
         }
     }
 
-    @SuppressWarnings("unchecked")
     @Override
     public V decode(byte[] data) {
-        Packet packet;
-        String className = ((ParameterizedType) getClass().getGenericSuperclass()).getActualTypeArguments()[1].getTypeName();
-        Class clazz = null;
-        try {
-            clazz = Class.forName(className);
-        } catch (ClassNotFoundException e) {
-            e.printStackTrace();
-        }
-        switch (pcap.getDataLinkType()) {
-            case EN10MB:
-                packet = Ethernet.newInstance(data);
-                while (packet != null) {
-                    if (packet.getClass() == clazz) {
-                        nextPacket(this.userArgument, this.pcapPktHdr, (V) packet);
-                        return (V) packet;
-                    }
-                    packet = packet.getPacket();
-                }
-            case IEEE802_11_RADIO:
-                packet = RadioTap.newInstance(data);
-                while (packet != null) {
-                    if (packet.getClass() == clazz) {
-                        nextPacket(this.userArgument, this.pcapPktHdr, (V) packet);
-                        return (V) packet;
-                    }
-                    packet = packet.getPacket();
-                }
-            case LINUX_SLL:
-                packet = SLL.newInstance(data);
-                while (packet != null) {
-                    if (packet.getClass() == clazz) {
-                        nextPacket(this.userArgument, this.pcapPktHdr, (V) packet);
-                        return (V) packet;
-                    }
-                    packet = packet.getPacket();
-                }
-            default:
-                nextPacket(this.userArgument, this.pcapPktHdr, null);
-                return null;
+        if (this.dispatcher == null) {
+            this.dispatcher = PacketDispatcher.newInstance(this);
         }
+        V packet = this.dispatcher.dispatch(this.pcap.getDataLinkType(), data);
+        nextPacket(this.userArgument, this.pcapPktHdr, packet);
+        return packet;
     }
 
 }
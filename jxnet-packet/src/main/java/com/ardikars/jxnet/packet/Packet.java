@@ -19,6 +19,7 @@ package com.ardikars.jxnet.packet;
 
 import com.ardikars.jxnet.Builder;
 
+import java.nio.ByteBuffer;
 import java.util.ArrayList;
 import java.util.List;
 
@@ -30,6 +31,11 @@ public abstract class Packet implements Builder<Packet> {
 
     protected byte[] nextPacket;
 
+    private Packet packet;
+    private byte[] decodedFrom;
+    private boolean decoded;
+    private Packet pendingPacket;
+
     /**
      * Set payload.
      * @param packet paket.
@@ -40,13 +46,118 @@ public abstract class Packet implements Builder<Packet> {
     }
 
     /**
-     * Get payload.
+     * Get payload, decoded on first access and memoized until the payload bytes
+     * or the type of the payload change. A payload set with setNextPacket(Packet) is returned as is.
      * @return packet.
      */
     public Packet getPacket() {
+        if (this.pendingPacket != null) {
+            return this.pendingPacket;
+        }
+        if (!this.decoded || this.decodedFrom != this.nextPacket) {
+            this.packet = this.decodePacket();
+            this.decodedFrom = this.nextPacket;
+            this.decoded = true;
+        }
+        return this.packet;
+    }
+
+    /**
+     * Decode payload, called by getPacket() when there is no memoized payload.
+     * @return packet.
+     */
+    protected Packet decodePacket() {
         return null;
     }
 
+    /**
+     * Drop the memoized payload, for setters that change how the payload decodes.
+     */
+    protected void invalidatePacket() {
+        this.packet = null;
+        this.decoded = false;
+    }
+
+    /**
+     * Set payload bytes.
+     * @param nextPacket payload bytes.
+     */
+    protected void setNextPacket(final byte[] nextPacket) {
+        this.pendingPacket = null;
+        this.nextPacket = nextPacket;
+    }
+
+    /**
+     * Set payload without serializing it, it is written by writeTo() straight after this header.
+     * @param packet payload.
+     */
+    protected void setNextPacket(final Packet packet) {
+        this.pendingPacket = packet;
+        this.nextPacket = null;
+    }
+
+    /**
+     * Get payload bytes. A payload set with setNextPacket(Packet) is serialized into a new array
+     * on every call and stays deferred, so later changes to it are still written by writeTo().
+     * @return payload bytes.
+     */
+    protected byte[] getNextPacket() {
+        if (this.pendingPacket != null) {
+            ByteBuffer buffer = ByteBuffer.allocate(this.pendingPacket.computeLength());
+            this.writeNextPacket(buffer);
+            return buffer.array();
+        }
+        return this.nextPacket;
+    }
+
+    /**
+     * Get payload set with setNextPacket(Packet) and not serialized yet.
+     * @return payload or null.
+     */
+    protected Packet getPendingPacket() {
+        return this.pendingPacket;
+    }
+
+    /**
+     * Returning length of payload.
+     * @return payload length.
+     */
+    protected int getNextPacketLength() {
+        if (this.pendingPacket != null) {
+            return this.pendingPacket.computeLength();
+        }
+        return this.nextPacket == null ? 0 : this.nextPacket.length;
+    }
+
+    /**
+     * Write payload at the position of buffer.
+     * @param buffer buffer.
+     */
+    protected void writeNextPacket(final ByteBuffer buffer) {
+        if (this.pendingPacket != null) {
+            this.pendingPacket.writeTo(buffer);
+        } else if (this.nextPacket != null) {
+            buffer.put(this.nextPacket);
+        }
+    }
+
+    /**
+     * Returning number of bytes written by writeTo().
+     * @return length.
+     */
+    public int computeLength() {
+        return this.toBytes().length;
+    }
+
+    /**
+     * Write packet and its payloads at the position of a big endian buffer,
+     * so a whole frame is serialized once into a (direct) buffer.
+     * @param buffer buffer with at least computeLength() bytes remaining.
+     */
+    public void writeTo(final ByteBuffer buffer) {
+        buffer.put(this.toBytes());
+    }
+
     /**
      * Return packet in byte array.
      * @return byte array.
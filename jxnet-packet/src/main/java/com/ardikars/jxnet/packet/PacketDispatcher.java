@@ -0,0 +1,148 @@
+/**
+ * Copyright (C) 2017  Ardika Rommy Sanjaya
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+package com.ardikars.jxnet.packet;
+
+import com.ardikars.jxnet.DataLinkType;
+import com.ardikars.jxnet.PcapPktHdr;
+import com.ardikars.jxnet.annotation.Type;
+import com.ardikars.jxnet.packet.ethernet.Ethernet;
+import com.ardikars.jxnet.packet.radiotap.RadioTap;
+import com.ardikars.jxnet.packet.sll.SLL;
+
+import java.lang.annotation.Annotation;
+import java.lang.reflect.ParameterizedType;
+import java.util.Arrays;
+import java.util.function.Function;
+
+/**
+ * Find the layer a listener asked for in a decoded packet.
+ * The layer class and number are resolved once, when the dispatcher is created,
+ * and the first layer decoder is looked up by DataLinkType ordinal, so finding the
+ * layer of a packet costs an array load and a walk down the layers, with no reflection.
+ * @param <V> layer type.
+ * @author Ardika Rommy Sanjaya
+ * @since 1.1.5
+ */
+public final class PacketDispatcher<V extends Packet> {
+
+    private static final Function<byte[], Packet>[] DECODERS = decoders();
+
+    private final Class<?> type;
+
+    private final int number;
+
+    private PacketDispatcher(final Class<?> type, final int number) {
+        this.type = type;
+        this.number = number;
+    }
+
+    @SuppressWarnings("unchecked")
+    private static Function<byte[], Packet>[] decoders() {
+        Function<byte[], Packet>[] decoders = new Function[DataLinkType.values().length];
+        Arrays.fill(decoders, (Function<byte[], Packet>) UnknownPacket::newInstance);
+        decoders[DataLinkType.EN10MB.ordinal()] = Ethernet::newInstance;
+        decoders[DataLinkType.IEEE802_11_RADIO.ordinal()] = RadioTap::newInstance;
+        decoders[DataLinkType.LINUX_SLL.ordinal()] = SLL::newInstance;
+        return decoders;
+    }
+
+    /**
+     * Dispatcher for a layer.
+     * @param type layer class, null for the first layer.
+     * @param number 1 for the first layer of that class, 2 for the second, ..., 0 for the last one.
+     * @param <V> layer type.
+     * @return dispatcher.
+     */
+    public static <V extends Packet> PacketDispatcher<V> newInstance(final Class<V> type, final int number) {
+        if (number < 0) {
+            throw new IllegalArgumentException("Layer number must not be negative.");
+        }
+        return new PacketDispatcher<V>(type, number);
+    }
+
+    /**
+     * Dispatcher for the layer named by the @Type annotation of the packet parameter of
+     * PacketListener.nextPacket(), or for the first layer without annotation.
+     * @param listener packet listener.
+     * @return dispatcher.
+     * @throws NoSuchMethodException the listener has no nextPacket method.
+     */
+    public static PacketDispatcher<Packet> newInstance(final PacketListener<?> listener) throws NoSuchMethodException {
+        Annotation[] annotations = listener.getClass()
+                .getMethod("nextPacket", Object.class, PcapPktHdr.class, Packet.class)
+                .getParameters()[2].getAnnotations();
+        if (annotations.length != 0 && annotations[0] instanceof Type) {
+            Type type = (Type) annotations[0];
+            return new PacketDispatcher<Packet>(type.value(), type.number());
+        }
+        return new PacketDispatcher<Packet>(null, 0);
+    }
+
+    /**
+     * Dispatcher for the first layer of the packet type argument of an AbstractPacketListener.
+     * @param listener packet listener.
+     * @param <V> layer type.
+     * @return dispatcher.
+     */
+    public static <V extends Packet> PacketDispatcher<V> newInstance(final AbstractPacketListener<?, V> listener) {
+        java.lang.reflect.Type type = ((ParameterizedType) listener.getClass().getGenericSuperclass())
+                .getActualTypeArguments()[1];
+        return new PacketDispatcher<V>(type instanceof Class ? (Class<?>) type
+                : (Class<?>) ((ParameterizedType) type).getRawType(), 1);
+    }
+
+    /**
+     * Decode the first layer of a packet.
+     * @param dataLinkType link type.
+     * @param data packet data.
+     * @return first layer.
+     */
+    public static Packet decode(final DataLinkType dataLinkType, final byte[] data) {
+        if (dataLinkType == null) {
+            return UnknownPacket.newInstance(data);
+        }
+        return DECODERS[dataLinkType.ordinal()].apply(data);
+    }
+
+    /**
+     * Decode a packet and find the layer.
+     * @param dataLinkType link type.
+     * @param data packet data.
+     * @return layer, null if the packet does not have it.
+     */
+    @SuppressWarnings("unchecked")
+    public V dispatch(final DataLinkType dataLinkType, final byte[] data) {
+        Packet packet = decode(dataLinkType, data);
+        if (this.type == null) {
+            return (V) packet;
+        }
+        Packet result = null;
+        int count = 0;
+        while (packet != null) {
+            if (packet.getClass() == this.type) {
+                if (++count == this.number) {
+                    return (V) packet;
+                }
+                result = packet;
+            }
+            packet = packet.getPacket();
+        }
+        return this.number == 0 ? (V) result : null;
+    }
+
+}
@@ -18,13 +18,12 @@
 package com.ardikars.jxnet.packet;
 
 import com.ardikars.jxnet.*;
-import com.ardikars.jxnet.annotation.Type;
 import com.ardikars.jxnet.packet.radiotap.RadioTap;
 import com.ardikars.jxnet.packet.sll.SLL;
 import com.ardikars.jxnet.packet.ethernet.Ethernet;
+import com.ardikars.jxnet.packet.ethernet.EthernetView;
 import com.ardikars.jxnet.util.ByteUtils;
 
-import java.lang.reflect.Parameter;
 import java.nio.ByteBuffer;
 import java.util.HashMap;
 import java.util.Map;
@@ -38,27 +37,56 @@ import static com.ardikars.jxnet.Jxnet.*;
 public class PacketHelper {
 
     public static <T> int loop(Pcap pcap, int count, PacketHandler<T> handler, T arg) {
+        return loop(pcap, count, handler, arg, false);
+    }
+
+    /**
+     * Loop with an optional reused capture path (see Jxnet.PcapLoopReuse()).
+     * Decoded packets own a copy of the packet data and the handler gets its own copy of the header,
+     * so both may be kept; for decoding without copying use a PacketViewHandler.
+     * @param pcap pcap object.
+     * @param count maximum iteration, -1 to infinite.
+     * @param handler packet handler.
+     * @param arg user argument.
+     * @param reuse reuse the packet header and buffer between packets.
+     * @param <T> argument type.
+     * @return -1 on error, 0 otherwise.
+     * @since 1.1.5
+     */
+    public static <T> int loop(Pcap pcap, int count, PacketHandler<T> handler, T arg, boolean reuse) {
         DataLinkType datalinkType = pcap.getDataLinkType();
         PcapHandler<PacketHandler<T>> callback = (tPacketHandler, pcapPktHdr, buffer) -> {
             if (pcapPktHdr == null || buffer == null) return;
-            tPacketHandler.nextPacket(arg, pcapPktHdr, parsePacket(datalinkType, ByteUtils.toByteArray(buffer)));
+            tPacketHandler.nextPacket(arg, copyOf(pcapPktHdr, reuse), parsePacket(datalinkType, ByteUtils.toByteArray(buffer)));
         };
-        return PcapLoop(pcap, count, callback, handler);
+        return pcapLoop(pcap, count, callback, handler, reuse);
     }
 
     public static <T> int loop(Pcap pcap, int count, PacketListener<T> handler, T arg) {
+        return loop(pcap, count, handler, arg, false);
+    }
+
+    /**
+     * Same as {@link #loop(Pcap, int, PacketHandler, Object, boolean)} for a PacketListener.
+     * @param pcap pcap object.
+     * @param count maximum iteration, -1 to infinite.
+     * @param handler packet listener.
+     * @param arg user argument.
+     * @param reuse reuse the packet header and buffer between packets.
+     * @param <T> argument type.
+     * @return -1 on error, 0 otherwise.
+     * @since 1.1.5
+     */
+    public static <T> int loop(Pcap pcap, int count, PacketListener<T> handler, T arg, boolean reuse) {
         DataLinkType datalinkType = pcap.getDataLinkType();
         try {
-            Parameter parameter = handler.getClass().getMethod("nextPacket", Object.class, PcapPktHdr.class, Packet.class).getParameters()[2];
+            PacketDispatcher<Packet> dispatcher = PacketDispatcher.newInstance(handler);
             PcapHandler<PacketListener<T>> callback = (tPacketHandler, pcapPktHdr, buffer) -> {
                 if (pcapPktHdr == null || buffer == null) return;
-                Type type = null;
-                if (parameter.getAnnotations().length != 0) {
-                    type = (Type) parameter.getAnnotations()[0];
-                }
-                tPacketHandler.nextPacket(arg, pcapPktHdr, parsePacket(datalinkType, ByteUtils.toByteArray(buffer), type));
+                tPacketHandler.nextPacket(arg, copyOf(pcapPktHdr, reuse),
+                        dispatcher.dispatch(datalinkType, ByteUtils.toByteArray(buffer)));
             };
-            return PcapLoop(pcap, count, callback, handler);
+            return pcapLoop(pcap, count, callback, handler, reuse);
         } catch (NoSuchMethodException e) {
             return -1;
         }
@@ -66,12 +94,68 @@ public class PacketHelper {
 
     private static int packetNumber;
     public static <T, V extends Packet> int loop(Pcap pcap, int count, AbstractPacketListener<T, V> handler, T arg) {
+        return loop(pcap, count, handler, arg, false);
+    }
+
+    /**
+     * Same as {@link #loop(Pcap, int, PacketHandler, Object, boolean)} for an AbstractPacketListener.
+     * @param pcap pcap object.
+     * @param count maximum iteration, -1 to infinite.
+     * @param handler packet listener.
+     * @param arg user argument.
+     * @param reuse reuse the packet header and buffer between packets.
+     * @param <T> argument type.
+     * @param <V> packet type.
+     * @return -1 on error, 0 otherwise.
+     * @since 1.1.5
+     */
+    public static <T, V extends Packet> int loop(Pcap pcap, int count, AbstractPacketListener<T, V> handler, T arg, boolean reuse) {
         packetNumber = 0;
         PcapHandler<AbstractPacketListener<T, V>> callback = (user, h, bytes) -> {
-            user.initialize(++packetNumber, arg, pcap, h);
+            user.initialize(++packetNumber, arg, pcap, copyOf(h, reuse));
             user.decode(ByteUtils.toByteArray(bytes));
         };
-        return Jxnet.PcapLoop(pcap, count, callback, handler);
+        return pcapLoop(pcap, count, callback, handler, reuse);
+    }
+
+    /**
+     * Loop without allocating or copying per packet.
+     * The same PcapPktHdr and EthernetView are passed to every call of the handler,
+     * the view reading the packet in place in the libpcap buffer.
+     * @param pcap pcap object, data link type must be EN10MB.
+     * @param count maximum iteration, -1 to infinite.
+     * @param handler packet view handler.
+     * @param arg user argument.
+     * @param <T> argument type.
+     * @return -1 on error, 0 otherwise.
+     * @since 1.1.5
+     */
+    public static <T> int loop(Pcap pcap, int count, PacketViewHandler<T> handler, T arg) {
+        if (pcap.getDataLinkType() != DataLinkType.EN10MB) {
+            return -1;
+        }
+        EthernetView view = new EthernetView();
+        PcapHandler<PacketViewHandler<T>> callback = (tPacketHandler, pcapPktHdr, buffer) -> {
+            if (pcapPktHdr == null || buffer == null) return;
+            if (view.wrap(buffer, 0, buffer.limit())) {
+                tPacketHandler.nextPacket(arg, pcapPktHdr, view);
+            }
+        };
+        return PcapLoopReuse(pcap, count, callback, handler);
+    }
+
+    private static PcapPktHdr copyOf(PcapPktHdr pktHdr, boolean reuse) {
+        if (!reuse) {
+            return pktHdr;
+        }
+        return new PcapPktHdr(pktHdr.getCapLen(), pktHdr.getLen(), pktHdr.getTvSec(), pktHdr.getTvUsec());
+    }
+
+    private static <T> int pcapLoop(Pcap pcap, int count, PcapHandler<T> callback, T user, boolean reuse) {
+        if (reuse) {
+            return PcapLoopReuse(pcap, count, callback, user);
+        }
+        return PcapLoop(pcap, count, callback, user);
     }
 
     public static Map<Class, Packet> next(Pcap pcap, PcapPktHdr pcapPktHdr) {
@@ -92,80 +176,6 @@ public class PacketHelper {
         return ret;
     }
 
-    private static Packet parsePacket(DataLinkType dataLinkType, byte[] bytes, Type type) {
-        Packet packet = null;
-        Packet result = null;
-        int packetNumber = 1;
-        int typeNumber = 0;
-        if (type != null) {
-            typeNumber = type.number();
-        }
-        switch (dataLinkType) {
-            case EN10MB:
-                packet = Ethernet.newInstance(bytes);
-                if (type == null) {
-                    return packet;
-                }
-                while (packet != null) {
-                    if (packet.getClass() == type.value()) {
-                        if (typeNumber == 0) {
-                            result = packet;
-                        } else {
-                            if (packetNumber == typeNumber) {
-                                return packet;
-                            } else {
-                                packetNumber = packetNumber + 1;
-                            }
-                        }
-                    }
-                    packet = packet.getPacket();
-                }
-                return result;
-            case IEEE802_11_RADIO:
-                packet = RadioTap.newInstance(bytes);
-                if (type == null) {
-                    return packet;
-                }
-                while (packet != null) {
-                    if (packet.getClass() == type.value()) {
-                        if (typeNumber == 0) {
-                            result = packet;
-                        } else {
-                            if (packetNumber == typeNumber) {
-                                return packet;
-                            } else {
-                                packetNumber = packetNumber + 1;
-                            }
-                        }
-                    }
-                    packet = packet.getPacket();
-                }
-                return result;
-            case LINUX_SLL:
-                packet = SLL.newInstance(bytes);
-                if (type == null) {
-                    return packet;
-                }
-                while (packet != null) {
-                    if (packet.getClass() == type.value()) {
-                        if (typeNumber == 0) {
-                            result = packet;
-                        } else {
-                            if (packetNumber == typeNumber) {
-                                return packet;
-                            } else {
-                                packetNumber = packetNumber + 1;
-                            }
-                        }
-                    }
-                    packet = packet.getPacket();
-                }
-                return result;
-            default:
-                return UnknownPacket.newInstance(bytes);
-        }
-    }
-
     private static Map<Class, Packet> parsePacket(DataLinkType datalinkType, byte[] bytes) {
         Map<Class, Packet> pkts = new HashMap<Class, Packet>();
         Packet packet = null;
@@ -0,0 +1,109 @@
+/**
+ * Copyright (C) 2017  Ardika Rommy Sanjaya
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+package com.ardikars.jxnet.packet;
+
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+
+/**
+ * Flyweight over a protocol header in a ByteBuffer.
+ * A view reads its fields in place at an offset of the buffer, in network byte order
+ * whatever the order of the buffer, and is rewrapped for every packet, so decoding
+ * allocates and copies nothing. Moving to the next layer wraps the next view over
+ * the payload of this one.
+ * @author Ardika Rommy Sanjaya
+ * @since 1.1.5
+ */
+public abstract class PacketView {
+
+    protected ByteBuffer buffer;
+    protected int offset;
+    protected int length;
+    private boolean swap;
+
+    /**
+     * Wrap a header.
+     * @param buffer buffer.
+     * @param offset offset of the header in buffer.
+     * @param length number of bytes from offset that belong to this packet.
+     * @return false if length is too short for the header, true otherwise.
+     */
+    public boolean wrap(final ByteBuffer buffer, final int offset, final int length) {
+        this.buffer = buffer;
+        this.offset = offset;
+        this.length = length;
+        this.swap = buffer.order() != ByteOrder.BIG_ENDIAN;
+        return length >= this.getMinimumLength() && length >= this.getPayloadOffset() - offset;
+    }
+
+    /**
+     * Wrap the payload of an outer view.
+     * @param outer outer view.
+     * @return false if the payload is too short for the header, true otherwise.
+     */
+    public boolean wrap(final PacketView outer) {
+        return this.wrap(outer.buffer, outer.getPayloadOffset(), outer.getPayloadLength());
+    }
+
+    /**
+     * Returning minimum header length in bytes.
+     * @return header length.
+     */
+    protected abstract int getMinimumLength();
+
+    /**
+     * Returning buffer offset of the payload.
+     * @return payload offset.
+     */
+    public abstract int getPayloadOffset();
+
+    /**
+     * Returning payload length in bytes.
+     * @return payload length.
+     */
+    public int getPayloadLength() {
+        return this.length - (this.getPayloadOffset() - this.offset);
+    }
+
+    public ByteBuffer getBuffer() {
+        return this.buffer;
+    }
+
+    public int getOffset() {
+        return this.offset;
+    }
+
+    public int getLength() {
+        return this.length;
+    }
+
+    protected int getUnsignedByte(final int index) {
+        return this.buffer.get(this.offset + index) & 0xff;
+    }
+
+    protected int getUnsignedShort(final int index) {
+        short value = this.buffer.getShort(this.offset + index);
+        return (this.swap ? Short.reverseBytes(value) : value) & 0xffff;
+    }
+
+    protected int getInt(final int index) {
+        int value = this.buffer.getInt(this.offset + index);
+        return this.swap ? Integer.reverseBytes(value) : value;
+    }
+
+}
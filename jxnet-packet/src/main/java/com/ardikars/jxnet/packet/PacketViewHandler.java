@@ -0,0 +1,40 @@
+/**
+ * Copyright (C) 2017  Ardika Rommy Sanjaya
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+package com.ardikars.jxnet.packet;
+
+import com.ardikars.jxnet.PcapPktHdr;
+import com.ardikars.jxnet.packet.ethernet.EthernetView;
+
+/**
+ * Handler for packets decoded in place (see PacketHelper.loop(Pcap, int, PacketViewHandler, Object)).
+ * @author Ardika Rommy Sanjaya
+ * @since 1.1.5
+ */
+@FunctionalInterface
+public interface PacketViewHandler<T> {
+
+    /**
+     * Next available packet.
+     * The header and the view are reused for the next packet and must not be kept after this call returns.
+     * @param arg user argument.
+     * @param pktHdr PcapPktHdr.
+     * @param ethernet ethernet view over the packet, inner layers are wrapped with PacketView.wrap(PacketView).
+     */
+    void nextPacket(T arg, PcapPktHdr pktHdr, EthernetView ethernet);
+
+}
@@ -21,8 +21,6 @@ import com.ardikars.jxnet.MacAddress;
 import com.ardikars.jxnet.packet.Packet;
 import com.ardikars.jxnet.packet.UnknownPacket;
 import com.ardikars.jxnet.packet.arp.ARP;
-import com.ardikars.jxnet.packet.ip.IPv4;
-import com.ardikars.jxnet.packet.ip.IPv6;
 
 import java.nio.ByteBuffer;
 
@@ -110,17 +108,18 @@ public class Ethernet extends Packet {
 
     public Ethernet setEthernetType(final ProtocolType ethernetType) {
         this.ethernetType = ethernetType;
+        this.invalidatePacket();
         return this;
     }
 
     @Deprecated
     public byte[] getPayload() {
-        return this.nextPacket;
+        return this.getNextPacket();
     }
 
     @Deprecated
     public Ethernet setPayload(final byte[] payload) {
-        this.nextPacket = payload;
+        this.setNextPacket(payload);
         return this;
     }
 
@@ -170,41 +169,43 @@ public class Ethernet extends Packet {
         }
         switch (packet.getClass().getName()) {
             case "com.ardikars.jxnet.packet.ip.IPv4":
-                IPv4 ipv4 = (IPv4) packet;
                 this.setEthernetType(ProtocolType.IPV4);
-                this.nextPacket = ipv4.toBytes();
+                this.setNextPacket(packet);
                 return this;
             case "com.ardikars.jxnet.packet.ip.IPv6":
-                IPv6 ipv6 = (IPv6) packet;
                 this.setEthernetType(ProtocolType.IPV6);
-                this.nextPacket = ipv6.toBytes();
+                this.setNextPacket(packet);
                 return this;
             case "com.ardikars.jxnet.packet.arp.ARP":
                 ARP arp = (ARP) packet;
                 this.setEthernetType(ProtocolType.ARP);
-                this.nextPacket = arp.toBytes();
+                this.setNextPacket(arp.toBytes());
                 return this;
             default:
-                this.nextPacket = packet.toBytes();
+                this.setNextPacket(packet.toBytes());
                 return this;
         }
     }
 
     @Override
-    public Packet getPacket() {
+    protected Packet decodePacket() {
         return this.getEthernetType().decode(this.nextPacket);
     }
 
     @Override
-    public byte[] toBytes() {
-        int headerLength = ETHERNET_HEADER_LENGTH +
+    public int computeLength() {
+        int length = ETHERNET_HEADER_LENGTH +
                 ((this.getVlanIdentifier() != (short) 0xffff) ? VLAN_HEADER_LENGTH : 0) +
-                ((this.nextPacket == null) ? 0 : this.nextPacket.length);
-        if ((this.padding == true) && (headerLength < 60)) {
-            headerLength = 60;
+                this.getNextPacketLength();
+        if ((this.padding == true) && (length < 60)) {
+            length = 60;
         }
-        byte[] data = new byte[headerLength];
-        ByteBuffer buffer = ByteBuffer.wrap(data);
+        return length;
+    }
+
+    @Override
+    public void writeTo(final ByteBuffer buffer) {
+        final int end = buffer.position() + this.computeLength();
         buffer.put(this.getDestinationMacAddress().toBytes());
         buffer.put(this.getSourceMacAddress().toBytes());
         if (this.getVlanIdentifier() != (short) 0xffff) {
@@ -213,9 +214,16 @@ public class Ethernet extends Packet {
                     | ((this.getCanonicalFormatIndicator() << 14) & 0x01) | (this.getVlanIdentifier() & 0x0fff)));
         }
         buffer.putShort((short) (this.getEthernetType().getValue() & 0xffff));
-        if (this.nextPacket != null) {
-            buffer.put(this.nextPacket);
+        this.writeNextPacket(buffer);
+        while (buffer.position() < end) {
+            buffer.put((byte) 0); // padding, the buffer may be reused
         }
+    }
+
+    @Override
+    public byte[] toBytes() {
+        byte[] data = new byte[this.computeLength()];
+        this.writeTo(ByteBuffer.wrap(data));
         return data;
     }
 
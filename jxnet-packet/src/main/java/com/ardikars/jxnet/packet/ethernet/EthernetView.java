@@ -0,0 +1,84 @@
+/**
+ * Copyright (C) 2017  Ardika Rommy Sanjaya
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+package com.ardikars.jxnet.packet.ethernet;
+
+import com.ardikars.jxnet.packet.PacketView;
+
+/**
+ * Flyweight over an Ethernet II header, with an optional IEEE 802.1Q tag.
+ * @author Ardika Rommy Sanjaya
+ * @since 1.1.5
+ */
+public class EthernetView extends PacketView {
+
+    public boolean hasVlan() {
+        return this.length >= Ethernet.ETHERNET_HEADER_LENGTH
+                && (short) this.getUnsignedShort(12) == ProtocolType.DOT1Q_VLAN_TAGGED_FRAMES.getValue();
+    }
+
+    /**
+     * Returning destination address as the low 48 bits of a long (see MacAddress.valueOf(long)).
+     * @return destination address.
+     */
+    public long getDestinationMacAddress() {
+        return ((long) this.getUnsignedShort(0) << 32) | (this.getInt(2) & 0xffffffffL);
+    }
+
+    /**
+     * Returning source address as the low 48 bits of a long (see MacAddress.valueOf(long)).
+     * @return source address.
+     */
+    public long getSourceMacAddress() {
+        return ((long) this.getUnsignedShort(6) << 32) | (this.getInt(8) & 0xffffffffL);
+    }
+
+    public byte getPriorityCodePoint() {
+        return this.hasVlan() ? (byte) (this.getUnsignedShort(14) >> 13 & 0x07) : 0;
+    }
+
+    public byte getCanonicalFormatIndicator() {
+        return this.hasVlan() ? (byte) (this.getUnsignedShort(14) >> 12 & 0x01) : 0;
+    }
+
+    /**
+     * Returning VLAN identifier, 0xffff without a tag like Ethernet.getVlanIdentifier().
+     * @return vlan identifier.
+     */
+    public short getVlanIdentifier() {
+        return this.hasVlan() ? (short) (this.getUnsignedShort(14) & 0x0fff) : (short) 0xffff;
+    }
+
+    /**
+     * Returning type of the payload (see ProtocolType.getValue()).
+     * @return ethernet type.
+     */
+    public short getEthernetType() {
+        return (short) this.getUnsignedShort(this.hasVlan() ? 16 : 12);
+    }
+
+    @Override
+    protected int getMinimumLength() {
+        return Ethernet.ETHERNET_HEADER_LENGTH;
+    }
+
+    @Override
+    public int getPayloadOffset() {
+        return this.offset + Ethernet.ETHERNET_HEADER_LENGTH + (this.hasVlan() ? Ethernet.VLAN_HEADER_LENGTH : 0);
+    }
+
+}
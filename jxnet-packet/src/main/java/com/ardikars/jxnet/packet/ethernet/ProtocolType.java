@@ -22,9 +22,6 @@ import com.ardikars.jxnet.packet.ip.IPv4;
 import com.ardikars.jxnet.packet.ip.IPv6;
 import com.ardikars.jxnet.NamedNumber;
 
-import java.util.HashMap;
-import java.util.Map;
-
 /**
  * @author Ardika Rommy Sanjaya
  * @since 1.1.0
@@ -99,20 +96,28 @@ public final class ProtocolType extends NamedNumber<Short, ProtocolType> {
     public static final ProtocolType UNKNOWN
             = new ProtocolType((short) -1, "Unknown");
 
-    private static final Map<Short, ProtocolType> registry
-            = new HashMap<Short, ProtocolType>();
+    /**
+     * Registered types indexed by the high then the low byte of the ethertype,
+     * a page of 256 entries is only allocated for high bytes in use.
+     */
+    private static final ProtocolType[][] registry = new ProtocolType[256][];
+
+    /**
+     * IEEE 802.3 length fields, created on first use.
+     */
+    private static final ProtocolType[] lengths = new ProtocolType[IEEE802_3_MAX_LENGTH + 1];
 
     static {
-        registry.put(IPV4.getValue(), IPV4);
-        registry.put(ARP.getValue(), ARP);
-        registry.put(DOT1Q_VLAN_TAGGED_FRAMES.getValue(), DOT1Q_VLAN_TAGGED_FRAMES);
-        registry.put(RARP.getValue(), RARP);
-        registry.put(APPLETALK.getValue(), APPLETALK);
-        registry.put(IPV6.getValue(), IPV6);
-        registry.put(PPP.getValue(), PPP);
-        registry.put(MPLS.getValue(), MPLS);
-        registry.put(PPPOE_DISCOVERY_STAGE.getValue(), PPPOE_DISCOVERY_STAGE);
-        registry.put(PPPOE_SESSION_STAGE.getValue(), PPPOE_SESSION_STAGE);
+        register(IPV4);
+        register(ARP);
+        register(DOT1Q_VLAN_TAGGED_FRAMES);
+        register(RARP);
+        register(APPLETALK);
+        register(IPV6);
+        register(PPP);
+        register(MPLS);
+        register(PPPOE_DISCOVERY_STAGE);
+        register(PPPOE_SESSION_STAGE);
     }
 
     /**
@@ -128,13 +133,31 @@ public final class ProtocolType extends NamedNumber<Short, ProtocolType> {
      * @return a ProtocolType object.
      */
     public static ProtocolType getInstance(final Short value) {
-        if (registry.containsKey(value)) {
-            return registry.get(value);
-        } else if ((value & 0xFFFF) <= IEEE802_3_MAX_LENGTH) {
-            return new ProtocolType(value, "-");
-        } else {
+        if (value == null) {
             return UNKNOWN;
         }
+        return getInstance(value.shortValue());
+    }
+
+    /**
+     * @param value value
+     * @return a ProtocolType object.
+     */
+    public static ProtocolType getInstance(final short value) {
+        ProtocolType[] page = registry[(value >> 8) & 0xff];
+        if (page != null && page[value & 0xff] != null) {
+            return page[value & 0xff];
+        }
+        int length = value & 0xffff;
+        if (length <= IEEE802_3_MAX_LENGTH) {
+            ProtocolType type = lengths[length];
+            if (type == null) {
+                type = new ProtocolType(value, "-");
+                lengths[length] = type;
+            }
+            return type;
+        }
+        return UNKNOWN;
     }
 
     /**
@@ -164,7 +187,15 @@ public final class ProtocolType extends NamedNumber<Short, ProtocolType> {
      * @return a ProtocolType object.
      */
     public static ProtocolType register(ProtocolType type) {
-        return registry.put(type.getValue(), type);
+        int value = type.getValue() & 0xffff;
+        ProtocolType[] page = registry[value >> 8];
+        if (page == null) {
+            page = new ProtocolType[256];
+            registry[value >> 8] = page;
+        }
+        ProtocolType previous = page[value & 0xff];
+        page[value & 0xff] = type;
+        return previous;
     }
 
     @Override
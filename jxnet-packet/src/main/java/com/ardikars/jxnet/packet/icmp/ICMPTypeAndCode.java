@@ -22,8 +22,10 @@ import com.ardikars.jxnet.TwoKeyMap;
 import com.ardikars.jxnet.packet.icmp.icmpv4.*;
 import com.ardikars.jxnet.packet.icmp.icmpv6.*;
 
-import java.util.HashMap;
+import java.util.AbstractMap;
+import java.util.HashSet;
 import java.util.Map;
+import java.util.Set;
 
 /**
  * @author Ardika Rommy Sanjaya
@@ -31,28 +33,189 @@ import java.util.Map;
  */
 public abstract class ICMPTypeAndCode extends NamedTwoKeyMap<Byte, Byte, ICMPTypeAndCode> {
 
-    protected static Map<TwoKeyMap<Byte, Byte>, ICMPTypeAndCode> registry =
-            new HashMap<TwoKeyMap<Byte, Byte>, ICMPTypeAndCode>();
+    /**
+     * Registered types and codes indexed by type then code, a table of 256 codes
+     * is only allocated for types in use. The defaults are registered when the table
+     * is first used, not when this class is initialized, so any subclass may be loaded first.
+     */
+    private static final class Registry {
+
+        private static final ICMPTypeAndCode[][] TABLE = new ICMPTypeAndCode[256][];
+
+        private static ICMPTypeAndCode get(final byte type, final byte code) {
+            ICMPTypeAndCode[] codes = TABLE[type & 0xff];
+            return codes == null ? null : codes[code & 0xff];
+        }
+
+        private static ICMPTypeAndCode put(final byte type, final byte code, ICMPTypeAndCode typeAndCode) {
+            ICMPTypeAndCode[] codes = TABLE[type & 0xff];
+            if (codes == null) {
+                if (typeAndCode == null) {
+                    return null;
+                }
+                codes = new ICMPTypeAndCode[256];
+                TABLE[type & 0xff] = codes;
+            }
+            ICMPTypeAndCode previous = codes[code & 0xff];
+            codes[code & 0xff] = typeAndCode;
+            return previous;
+        }
+
+        private static ICMPTypeAndCode put(ICMPTypeAndCode typeAndCode) {
+            return put(typeAndCode.getType(), typeAndCode.getCode(), typeAndCode);
+        }
+
+        static {
+            put(ICMPv4DestinationUnreachable.DESTINATION_NETWORK_UNREACHABLE);
+            put(ICMPv4DestinationUnreachable.DESTINATION_HOST_UNREACHABLE);
+            put(ICMPv4DestinationUnreachable.DESTINATION_PROTOCOL_UNREACHABLE);
+            put(ICMPv4DestinationUnreachable.DESTINATION_PORT_UNREACHABLE);
+            put(ICMPv4DestinationUnreachable.FRAGMENTATION_REQUIRED);
+            put(ICMPv4DestinationUnreachable.SOURCE_ROUTE_FAILED);
+            put(ICMPv4DestinationUnreachable.DESTINATION_NETWORK_UNKNOWN);
+            put(ICMPv4DestinationUnreachable.DESTINATION_HOST_UNKOWN);
+            put(ICMPv4DestinationUnreachable.SOURCE_HOST_ISOLATED);
+            put(ICMPv4DestinationUnreachable.NETWORK_ADMINISTRATIVELY_PROHIBITED);
+            put(ICMPv4DestinationUnreachable.HOST_ADMINISTRATIVELY_PROHIBITED);
+            put(ICMPv4DestinationUnreachable.NETWORK_UNREACHABLE_FOR_TOS);
+            put(ICMPv4DestinationUnreachable.HOST_UNREACHABLE_FOR_TOS);
+            put(ICMPv4DestinationUnreachable.COMMUNICATION_ADMINISTRATIVELY_PROHIBITED);
+            put(ICMPv4DestinationUnreachable.HOST_PRECEDENCE_VIOLATION);
+            put(ICMPv4DestinationUnreachable.PRECEDENCE_CUTOFF_IN_EFFECT);
+
+            put(ICMPv4EchoReply.ECHO_REPLY);
+
+            put(ICMPv4EchoRequest.ECHO_REQUEST);
+
+            put(ICMPv4ParameterProblem.POINTER_INDICATES_THE_ERROR);
+            put(ICMPv4ParameterProblem.MISSING_REQUIRED_OPTION);
+            put(ICMPv4ParameterProblem.BAD_LENGTH);
+
+            put(ICMPv4RedirectMessage.REDIRECT_DATAGRAM_FOR_NETWORK);
+
+            put(ICMPv4RouterAdvertisement.ROUTER_ADVERTISEMENT);
+
+            put(ICMPv4RouterSolicitation.ROUTER_DISCOVERY_SELECTION_SOLICITATION);
+
+            put(ICMPv4TimeExceeded.TTL_EXPIRED_IN_TRANSIT);
+            put(ICMPv4TimeExceeded.FRAGMENT_REASSEMBLY_TIME_EXEEDED);
+
+            put(ICMPv4Timestamp.TIMESTAMP);
+
+            put(ICMPv4TimestampReply.TIMESTAMP_REPLY);
+
+            // ICMPv6
+
+            put(ICMPv6EchoRequest.ECHO_REQUEST);
+
+            put(ICMPv6EchoReply.ECHO_REPLY);
+
+            put(ICMPv6DestinationUnreachable.NO_ROUTE_TO_DESTINATION);
+            put(ICMPv6DestinationUnreachable.COMMUNICATION_WITH_DESTINATION_ADMINIS_TRATIVELY_PROHIBITED);
+            put(ICMPv6DestinationUnreachable.BEYOND_SCOPE_OF_SOURCE_ADDRESS);
+            put(ICMPv6DestinationUnreachable.ADDRESS_UNREACHABLE);
+            put(ICMPv6DestinationUnreachable.PORT_UNREACHABLE);
+            put(ICMPv6DestinationUnreachable.SOURCE_ADDRESS_FAILED);
+            put(ICMPv6DestinationUnreachable.REJECT_ROUTE_TO_DESTINATION);
+            put(ICMPv6DestinationUnreachable.ERROR_IN_SOURCE_ROUTING_HEADER);
+
+            put(ICMPv6PacketTooBigMessage.PACKET_TOO_BIG_MESSAGE);
+
+            put(ICMPv6ParameterProblem.ERRORNEOUS_HEADER_FIELD_ENCOUTERED);
+            put(ICMPv6ParameterProblem.UNRECOGNIZED_NEXT_HEADER_TYPE_ENCOUNTERED);
+            put(ICMPv6ParameterProblem.UNRECOGNIZED_IPV6_OPTION_ENCOUNTERED);
+
+            put(ICMPv6TimeExceeded.HOP_LIMIT_EXCEEDED_IN_TRANSIT);
+            put(ICMPv6TimeExceeded.FRAGMENT_REASSEMBLY_TIME_EXCEEDED);
+        }
+
+    }
+
+    /**
+     * Map view of the registry for subclasses, reads and writes go to the same table
+     * as {@link #register(ICMPTypeAndCode)} and {@link #getTypeAndCode(byte, byte)}.
+     */
+    protected static final Map<TwoKeyMap<Byte, Byte>, ICMPTypeAndCode> registry =
+            new AbstractMap<TwoKeyMap<Byte, Byte>, ICMPTypeAndCode>() {
+
+        @Override
+        public ICMPTypeAndCode get(Object key) {
+            if (!(key instanceof TwoKeyMap)) {
+                return null;
+            }
+            TwoKeyMap<?, ?> typeAndCode = (TwoKeyMap<?, ?>) key;
+            if (!(typeAndCode.getFirstKey() instanceof Byte) || !(typeAndCode.getSecondKey() instanceof Byte)) {
+                return null;
+            }
+            return Registry.get((Byte) typeAndCode.getFirstKey(), (Byte) typeAndCode.getSecondKey());
+        }
+
+        @Override
+        public boolean containsKey(Object key) {
+            return get(key) != null;
+        }
+
+        @Override
+        public ICMPTypeAndCode put(TwoKeyMap<Byte, Byte> key, ICMPTypeAndCode value) {
+            return Registry.put(key.getFirstKey(), key.getSecondKey(), value);
+        }
+
+        @Override
+        public ICMPTypeAndCode remove(Object key) {
+            ICMPTypeAndCode typeAndCode = get(key);
+            if (typeAndCode != null) {
+                TwoKeyMap<?, ?> typeAndCodeKey = (TwoKeyMap<?, ?>) key;
+                Registry.put((Byte) typeAndCodeKey.getFirstKey(), (Byte) typeAndCodeKey.getSecondKey(), null);
+            }
+            return typeAndCode;
+        }
+
+        @Override
+        public Set<Entry<TwoKeyMap<Byte, Byte>, ICMPTypeAndCode>> entrySet() {
+            Set<Entry<TwoKeyMap<Byte, Byte>, ICMPTypeAndCode>> entries =
+                    new HashSet<Entry<TwoKeyMap<Byte, Byte>, ICMPTypeAndCode>>();
+            for (int type = 0; type < Registry.TABLE.length; type++) {
+                ICMPTypeAndCode[] codes = Registry.TABLE[type];
+                if (codes == null) {
+                    continue;
+                }
+                for (int code = 0; code < codes.length; code++) {
+                    if (codes[code] != null) {
+                        entries.add(new SimpleImmutableEntry<TwoKeyMap<Byte, Byte>, ICMPTypeAndCode>(
+                                TwoKeyMap.newInstance((byte) type, (byte) code), codes[code]));
+                    }
+                }
+            }
+            return entries;
+        }
+
+    };
 
     protected ICMPTypeAndCode(Byte firstKey, Byte secondKey, String name) {
         super(firstKey, secondKey, name);
     }
 
     public static ICMPTypeAndCode register(ICMPTypeAndCode typeAndCode) {
-        return registry.put(typeAndCode.getKey(), typeAndCode);
+        return Registry.put(typeAndCode);
     }
 
     public static ICMPTypeAndCode unregister(ICMPTypeAndCode typeAndCode) {
-        return registry.remove(typeAndCode.getKey());
+        return Registry.put(typeAndCode.getType(), typeAndCode.getCode(), null);
     }
 
     public static ICMPTypeAndCode getTypeAndCode(Byte type, Byte code) {
-        TwoKeyMap<Byte, Byte> key = TwoKeyMap.newInstance(type, code);
-        ICMPTypeAndCode typeAndCode = registry.get(key);
+        if (type == null || code == null) {
+            return ICMPUnknownTypeAndCode.UNKNOWN;
+        }
+        return getTypeAndCode(type.byteValue(), code.byteValue());
+    }
+
+    public static ICMPTypeAndCode getTypeAndCode(final byte type, final byte code) {
+        ICMPTypeAndCode typeAndCode = Registry.get(type, code);
         if (typeAndCode == null) {
             return ICMPUnknownTypeAndCode.UNKNOWN;
         }
-        return registry.get(key);
+        return typeAndCode;
     }
 
     public byte getType() {
@@ -70,71 +233,4 @@ public abstract class ICMPTypeAndCode extends NamedTwoKeyMap<Byte, Byte, ICMPTyp
                 .append("]").toString();
     }
 
-    static {
-        if (registry.size() == 0) {
-            register(ICMPv4DestinationUnreachable.DESTINATION_NETWORK_UNREACHABLE);
-            register(ICMPv4DestinationUnreachable.DESTINATION_HOST_UNREACHABLE);
-            register(ICMPv4DestinationUnreachable.DESTINATION_PROTOCOL_UNREACHABLE);
-            register(ICMPv4DestinationUnreachable.DESTINATION_PORT_UNREACHABLE);
-            register(ICMPv4DestinationUnreachable.FRAGMENTATION_REQUIRED);
-            register(ICMPv4DestinationUnreachable.SOURCE_ROUTE_FAILED);
-            register(ICMPv4DestinationUnreachable.DESTINATION_NETWORK_UNKNOWN);
-            register(ICMPv4DestinationUnreachable.DESTINATION_HOST_UNKOWN);
-            register(ICMPv4DestinationUnreachable.SOURCE_HOST_ISOLATED);
-            register(ICMPv4DestinationUnreachable.NETWORK_ADMINISTRATIVELY_PROHIBITED);
-            register(ICMPv4DestinationUnreachable.HOST_ADMINISTRATIVELY_PROHIBITED);
-            register(ICMPv4DestinationUnreachable.NETWORK_UNREACHABLE_FOR_TOS);
-            register(ICMPv4DestinationUnreachable.HOST_UNREACHABLE_FOR_TOS);
-            register(ICMPv4DestinationUnreachable.COMMUNICATION_ADMINISTRATIVELY_PROHIBITED);
-            register(ICMPv4DestinationUnreachable.HOST_PRECEDENCE_VIOLATION);
-            register(ICMPv4DestinationUnreachable.PRECEDENCE_CUTOFF_IN_EFFECT);
-
-            register(ICMPv4EchoReply.ECHO_REPLY);
-
-            register(ICMPv4EchoRequest.ECHO_REQUEST);
-
-            register(ICMPv4ParameterProblem.POINTER_INDICATES_THE_ERROR);
-            register(ICMPv4ParameterProblem.MISSING_REQUIRED_OPTION);
-            register(ICMPv4ParameterProblem.BAD_LENGTH);
-
-            register(ICMPv4RedirectMessage.REDIRECT_DATAGRAM_FOR_NETWORK);
-
-            register(ICMPv4RouterAdvertisement.ROUTER_ADVERTISEMENT);
-
-            register(ICMPv4RouterSolicitation.ROUTER_DISCOVERY_SELECTION_SOLICITATION);
-
-            register(ICMPv4TimeExceeded.TTL_EXPIRED_IN_TRANSIT);
-            register(ICMPv4TimeExceeded.FRAGMENT_REASSEMBLY_TIME_EXEEDED);
-
-            register(ICMPv4Timestamp.TIMESTAMP);
-
-            register(ICMPv4TimestampReply.TIMESTAMP_REPLY);
-
-            // ICMPv6
-
-            register(ICMPv6EchoRequest.ECHO_REQUEST);
-
-            register(ICMPv6EchoReply.ECHO_REPLY);
-
-            register(ICMPv6DestinationUnreachable.NO_ROUTE_TO_DESTINATION);
-            register(ICMPv6DestinationUnreachable.COMMUNICATION_WITH_DESTINATION_ADMINIS_TRATIVELY_PROHIBITED);
-            register(ICMPv6DestinationUnreachable.BEYOND_SCOPE_OF_SOURCE_ADDRESS);
-            register(ICMPv6DestinationUnreachable.ADDRESS_UNREACHABLE);
-            register(ICMPv6DestinationUnreachable.PORT_UNREACHABLE);
-            register(ICMPv6DestinationUnreachable.SOURCE_ADDRESS_FAILED);
-            register(ICMPv6DestinationUnreachable.REJECT_ROUTE_TO_DESTINATION);
-            register(ICMPv6DestinationUnreachable.ERROR_IN_SOURCE_ROUTING_HEADER);
-
-            register(ICMPv6PacketTooBigMessage.PACKET_TOO_BIG_MESSAGE);
-
-            register(ICMPv6ParameterProblem.ERRORNEOUS_HEADER_FIELD_ENCOUTERED);
-            register(ICMPv6ParameterProblem.UNRECOGNIZED_NEXT_HEADER_TYPE_ENCOUNTERED);
-            register(ICMPv6ParameterProblem.UNRECOGNIZED_IPV6_OPTION_ENCOUNTERED);
-
-            register(ICMPv6TimeExceeded.HOP_LIMIT_EXCEEDED_IN_TRANSIT);
-            register(ICMPv6TimeExceeded.FRAGMENT_REASSEMBLY_TIME_EXCEEDED);
-
-        }
-    }
-
 }
@@ -17,8 +17,6 @@
 
 package com.ardikars.jxnet.packet.icmp;
 
-import com.ardikars.jxnet.TwoKeyMap;
-
 /**
  * @author Ardika Rommy Sanjaya
  * @since 1.1.0
@@ -33,10 +31,9 @@ public class ICMPUnknownTypeAndCode extends ICMPTypeAndCode {
     }
 
     public static ICMPUnknownTypeAndCode register(Byte code, String name) {
-        TwoKeyMap<Byte, Byte> key = TwoKeyMap.newInstance((byte) -1, code);
         ICMPUnknownTypeAndCode unknownTypeAndCode =
-                new ICMPUnknownTypeAndCode(key.getSecondKey(), name);
-        return (ICMPUnknownTypeAndCode) ICMPTypeAndCode.registry.put(key, unknownTypeAndCode);
+                new ICMPUnknownTypeAndCode(code, name);
+        return (ICMPUnknownTypeAndCode) ICMPTypeAndCode.register(unknownTypeAndCode);
     }
 
     @Override
@@ -45,7 +42,7 @@ public class ICMPUnknownTypeAndCode extends ICMPTypeAndCode {
     }
 
     static {
-        ICMPTypeAndCode.registry.put(UNKNOWN.getKey(), UNKNOWN);
+        ICMPTypeAndCode.register(UNKNOWN);
     }
 
 }
@@ -18,7 +18,6 @@
 package com.ardikars.jxnet.packet.icmp.icmpv4;
 
 import com.ardikars.jxnet.packet.icmp.ICMPTypeAndCode;
-import com.ardikars.jxnet.TwoKeyMap;
 
 /**
  * @author Ardika Rommy Sanjaya
@@ -79,10 +78,9 @@ public class ICMPv4DestinationUnreachable extends ICMPTypeAndCode {
     }
 
     public static ICMPv4DestinationUnreachable register(Byte code, String name) {
-        TwoKeyMap<Byte, Byte> key = TwoKeyMap.newInstance((byte) 3, code);
         ICMPv4DestinationUnreachable destinationUnreachable =
-                new ICMPv4DestinationUnreachable(key.getSecondKey(), name);
-        return (ICMPv4DestinationUnreachable) ICMPTypeAndCode.registry.put(key, destinationUnreachable);
+                new ICMPv4DestinationUnreachable(code, name);
+        return (ICMPv4DestinationUnreachable) ICMPTypeAndCode.register(destinationUnreachable);
     }
 
     @Override
@@ -18,7 +18,6 @@
 package com.ardikars.jxnet.packet.icmp.icmpv4;
 
 import com.ardikars.jxnet.packet.icmp.ICMPTypeAndCode;
-import com.ardikars.jxnet.TwoKeyMap;
 
 /**
  * @author Ardika Rommy Sanjaya
@@ -34,10 +33,9 @@ public class ICMPv4EchoReply extends ICMPTypeAndCode {
     }
 
     public static ICMPv4EchoReply register(Byte code, String name) {
-        TwoKeyMap<Byte, Byte> key = TwoKeyMap.newInstance((byte) 0, code);
         ICMPv4EchoReply icmPv4EchoReply =
-                new ICMPv4EchoReply(key.getSecondKey(), name);
-        return (ICMPv4EchoReply) ICMPTypeAndCode.registry.put(key, icmPv4EchoReply);
+                new ICMPv4EchoReply(code, name);
+        return (ICMPv4EchoReply) ICMPTypeAndCode.register(icmPv4EchoReply);
     }
 
     @Override
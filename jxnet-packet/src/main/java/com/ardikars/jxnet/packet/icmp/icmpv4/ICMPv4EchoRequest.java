@@ -18,7 +18,6 @@
 package com.ardikars.jxnet.packet.icmp.icmpv4;
 
 import com.ardikars.jxnet.packet.icmp.ICMPTypeAndCode;
-import com.ardikars.jxnet.TwoKeyMap;
 
 /**
  * @author Ardika Rommy Sanjaya
@@ -34,10 +33,9 @@ public class ICMPv4EchoRequest extends ICMPTypeAndCode {
     }
 
     public static ICMPv4EchoRequest register(Byte code, String name) {
-        TwoKeyMap<Byte, Byte> key = TwoKeyMap.newInstance((byte) 8, code);
         ICMPv4EchoRequest icmPv4EchoRequest =
-                new ICMPv4EchoRequest(key.getSecondKey(), name);
-        return (ICMPv4EchoRequest) ICMPTypeAndCode.registry.put(key, icmPv4EchoRequest);
+                new ICMPv4EchoRequest(code, name);
+        return (ICMPv4EchoRequest) ICMPTypeAndCode.register(icmPv4EchoRequest);
     }
 
     @Override
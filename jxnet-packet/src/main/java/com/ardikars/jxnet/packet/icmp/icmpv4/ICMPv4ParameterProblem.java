@@ -18,7 +18,6 @@
 package com.ardikars.jxnet.packet.icmp.icmpv4;
 
 import com.ardikars.jxnet.packet.icmp.ICMPTypeAndCode;
-import com.ardikars.jxnet.TwoKeyMap;
 
 /**
  * @author Ardika Rommy Sanjaya
@@ -40,10 +39,9 @@ public class ICMPv4ParameterProblem extends ICMPTypeAndCode {
     }
 
     public static ICMPv4ParameterProblem register(Byte code, String name) {
-        TwoKeyMap<Byte, Byte> key = TwoKeyMap.newInstance((byte) 12, code);
         ICMPv4ParameterProblem parameterProblem =
-                new ICMPv4ParameterProblem(key.getSecondKey(), name);
-        return (ICMPv4ParameterProblem) ICMPTypeAndCode.registry.put(key, parameterProblem);
+                new ICMPv4ParameterProblem(code, name);
+        return (ICMPv4ParameterProblem) ICMPTypeAndCode.register(parameterProblem);
     }
 
     @Override
@@ -18,7 +18,6 @@
 package com.ardikars.jxnet.packet.icmp.icmpv4;
 
 import com.ardikars.jxnet.packet.icmp.ICMPTypeAndCode;
-import com.ardikars.jxnet.TwoKeyMap;
 
 /**
  * @author Ardika Rommy Sanjaya
@@ -34,9 +33,8 @@ public class ICMPv4RedirectMessage extends ICMPTypeAndCode {
     }
 
     public static ICMPv4RedirectMessage register(Byte code, String name) {
-        TwoKeyMap<Byte, Byte> key = TwoKeyMap.newInstance((byte) 5, code);
-        ICMPv4RedirectMessage redirectMessage = new ICMPv4RedirectMessage(key.getSecondKey(), name);
-        return (ICMPv4RedirectMessage) ICMPTypeAndCode.registry.put(key, redirectMessage);
+        ICMPv4RedirectMessage redirectMessage = new ICMPv4RedirectMessage(code, name);
+        return (ICMPv4RedirectMessage) ICMPTypeAndCode.register(redirectMessage);
     }
 
     @Override
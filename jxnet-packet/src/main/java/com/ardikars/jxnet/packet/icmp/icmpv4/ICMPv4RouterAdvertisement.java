@@ -18,7 +18,6 @@
 package com.ardikars.jxnet.packet.icmp.icmpv4;
 
 import com.ardikars.jxnet.packet.icmp.ICMPTypeAndCode;
-import com.ardikars.jxnet.TwoKeyMap;
 
 /**
  * @author Ardika Rommy Sanjaya
@@ -34,10 +33,9 @@ public class ICMPv4RouterAdvertisement extends ICMPTypeAndCode {
     }
 
     public static ICMPv4RouterAdvertisement register(Byte code, String name) {
-        TwoKeyMap<Byte, Byte> key = TwoKeyMap.newInstance((byte) 9, code);
         ICMPv4RouterAdvertisement routerAdvertisement =
-                new ICMPv4RouterAdvertisement(key.getSecondKey(), name);
-        return (ICMPv4RouterAdvertisement) ICMPTypeAndCode.registry.put(key, routerAdvertisement);
+                new ICMPv4RouterAdvertisement(code, name);
+        return (ICMPv4RouterAdvertisement) ICMPTypeAndCode.register(routerAdvertisement);
     }
 
     @Override
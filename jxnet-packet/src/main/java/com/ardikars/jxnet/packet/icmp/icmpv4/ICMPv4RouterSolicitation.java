@@ -18,7 +18,6 @@
 package com.ardikars.jxnet.packet.icmp.icmpv4;
 
 import com.ardikars.jxnet.packet.icmp.ICMPTypeAndCode;
-import com.ardikars.jxnet.TwoKeyMap;
 
 /**
  * @author Ardika Rommy Sanjaya
@@ -34,10 +33,9 @@ public class ICMPv4RouterSolicitation extends ICMPTypeAndCode {
     }
 
     public static ICMPv4RouterSolicitation register(Byte code, String name) {
-        TwoKeyMap<Byte, Byte> key = TwoKeyMap.newInstance((byte) 10, code);
         ICMPv4RouterSolicitation routerSolicitation =
-                new ICMPv4RouterSolicitation(key.getSecondKey(), name);
-        return (ICMPv4RouterSolicitation) ICMPTypeAndCode.registry.put(key, routerSolicitation);
+                new ICMPv4RouterSolicitation(code, name);
+        return (ICMPv4RouterSolicitation) ICMPTypeAndCode.register(routerSolicitation);
     }
 
     @Override
@@ -18,7 +18,6 @@
 package com.ardikars.jxnet.packet.icmp.icmpv4;
 
 import com.ardikars.jxnet.packet.icmp.ICMPTypeAndCode;
-import com.ardikars.jxnet.TwoKeyMap;
 
 /**
  * @author Ardika Rommy Sanjaya
@@ -37,10 +36,9 @@ public class ICMPv4TimeExceeded extends ICMPTypeAndCode {
     }
 
     public static ICMPv4TimeExceeded register(Byte code, String name) {
-        TwoKeyMap<Byte, Byte> key = TwoKeyMap.newInstance((byte) 11, code);
         ICMPv4TimeExceeded timeExceeded =
-                new ICMPv4TimeExceeded(key.getSecondKey(), name);
-        return (ICMPv4TimeExceeded) ICMPTypeAndCode.registry.put(key, timeExceeded);
+                new ICMPv4TimeExceeded(code, name);
+        return (ICMPv4TimeExceeded) ICMPTypeAndCode.register(timeExceeded);
     }
 
     @Override
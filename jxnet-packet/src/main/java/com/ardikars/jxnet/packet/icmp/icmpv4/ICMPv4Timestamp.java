@@ -18,7 +18,6 @@
 package com.ardikars.jxnet.packet.icmp.icmpv4;
 
 import com.ardikars.jxnet.packet.icmp.ICMPTypeAndCode;
-import com.ardikars.jxnet.TwoKeyMap;
 
 /**
  * @author Ardika Rommy Sanjaya
@@ -34,10 +33,9 @@ public class ICMPv4Timestamp extends ICMPTypeAndCode {
     }
 
     public static ICMPv4Timestamp register(Byte code, String name) {
-        TwoKeyMap<Byte, Byte> key = TwoKeyMap.newInstance((byte) 13, code);
         ICMPv4Timestamp timestamp =
-                new ICMPv4Timestamp(key.getSecondKey(), name);
-        return (ICMPv4Timestamp) ICMPTypeAndCode.registry.put(key, timestamp);
+                new ICMPv4Timestamp(code, name);
+        return (ICMPv4Timestamp) ICMPTypeAndCode.register(timestamp);
     }
 
     @Override
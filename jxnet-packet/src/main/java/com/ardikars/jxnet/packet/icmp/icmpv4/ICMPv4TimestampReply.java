@@ -18,7 +18,6 @@
 package com.ardikars.jxnet.packet.icmp.icmpv4;
 
 import com.ardikars.jxnet.packet.icmp.ICMPTypeAndCode;
-import com.ardikars.jxnet.TwoKeyMap;
 
 /**
  * @author Ardika Rommy Sanjaya
@@ -34,10 +33,9 @@ public class ICMPv4TimestampReply extends ICMPTypeAndCode {
     }
 
     public static ICMPv4TimestampReply register(Byte code, String name) {
-        TwoKeyMap<Byte, Byte> key = TwoKeyMap.newInstance((byte) 14, code);
         ICMPv4TimestampReply timestampReply =
-                new ICMPv4TimestampReply(key.getSecondKey(), name);
-        return (ICMPv4TimestampReply) ICMPTypeAndCode.registry.put(key, timestampReply);
+                new ICMPv4TimestampReply(code, name);
+        return (ICMPv4TimestampReply) ICMPTypeAndCode.register(timestampReply);
     }
 
     @Override
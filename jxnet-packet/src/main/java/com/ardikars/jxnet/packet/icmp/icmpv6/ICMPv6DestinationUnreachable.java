@@ -17,7 +17,6 @@
 
 package com.ardikars.jxnet.packet.icmp.icmpv6;
 
-import com.ardikars.jxnet.TwoKeyMap;
 import com.ardikars.jxnet.packet.icmp.ICMPTypeAndCode;
 
 /**
@@ -66,10 +65,9 @@ public class ICMPv6DestinationUnreachable extends ICMPTypeAndCode {
     }
 
     public static ICMPv6DestinationUnreachable register(Byte code, String name) {
-        TwoKeyMap<Byte, Byte> key = TwoKeyMap.newInstance((byte) 1, code);
         ICMPv6DestinationUnreachable destinationUnreachable =
-                new ICMPv6DestinationUnreachable(key.getSecondKey(), name);
-        return (ICMPv6DestinationUnreachable) ICMPTypeAndCode.registry.put(key, destinationUnreachable);
+                new ICMPv6DestinationUnreachable(code, name);
+        return (ICMPv6DestinationUnreachable) ICMPTypeAndCode.register(destinationUnreachable);
     }
 
     @Override
@@ -17,7 +17,6 @@
 
 package com.ardikars.jxnet.packet.icmp.icmpv6;
 
-import com.ardikars.jxnet.TwoKeyMap;
 import com.ardikars.jxnet.packet.icmp.ICMPTypeAndCode;
 
 /**
@@ -34,10 +33,9 @@ public class ICMPv6EchoReply extends ICMPTypeAndCode {
     }
 
     public static ICMPv6EchoReply register(Byte code, String name) {
-        TwoKeyMap<Byte, Byte> key = TwoKeyMap.newInstance((byte) 129, code);
         ICMPv6EchoReply echoReply =
-                new ICMPv6EchoReply(key.getSecondKey(), name);
-        return (ICMPv6EchoReply) ICMPTypeAndCode.registry.put(key, echoReply);
+                new ICMPv6EchoReply(code, name);
+        return (ICMPv6EchoReply) ICMPTypeAndCode.register(echoReply);
     }
 
     @Override
@@ -17,7 +17,6 @@
 
 package com.ardikars.jxnet.packet.icmp.icmpv6;
 
-import com.ardikars.jxnet.TwoKeyMap;
 import com.ardikars.jxnet.packet.icmp.ICMPTypeAndCode;
 
 /**
@@ -34,10 +33,9 @@ public class ICMPv6EchoRequest extends ICMPTypeAndCode {
     }
 
     public static ICMPv6EchoRequest register(Byte code, String name) {
-        TwoKeyMap<Byte, Byte> key = TwoKeyMap.newInstance((byte) 128, code);
         ICMPv6EchoRequest echoRequest =
-                new ICMPv6EchoRequest(key.getSecondKey(), name);
-        return (ICMPv6EchoRequest) ICMPTypeAndCode.registry.put(key, echoRequest);
+                new ICMPv6EchoRequest(code, name);
+        return (ICMPv6EchoRequest) ICMPTypeAndCode.register(echoRequest);
     }
 
     @Override
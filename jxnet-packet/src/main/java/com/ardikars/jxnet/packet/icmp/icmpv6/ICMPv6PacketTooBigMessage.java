@@ -17,7 +17,6 @@
 
 package com.ardikars.jxnet.packet.icmp.icmpv6;
 
-import com.ardikars.jxnet.TwoKeyMap;
 import com.ardikars.jxnet.packet.icmp.ICMPTypeAndCode;
 
 /**
@@ -47,10 +46,9 @@ public class ICMPv6PacketTooBigMessage extends ICMPTypeAndCode {
     }
 
     public static ICMPv6PacketTooBigMessage register(Byte code, String name) {
-        TwoKeyMap<Byte, Byte> key = TwoKeyMap.newInstance((byte) 2, code);
         ICMPv6PacketTooBigMessage packetTooBigMessage =
-                new ICMPv6PacketTooBigMessage(key.getSecondKey(), name);
-        return (ICMPv6PacketTooBigMessage) ICMPTypeAndCode.registry.put(key, packetTooBigMessage);
+                new ICMPv6PacketTooBigMessage(code, name);
+        return (ICMPv6PacketTooBigMessage) ICMPTypeAndCode.register(packetTooBigMessage);
     }
 
     @Override
@@ -17,7 +17,6 @@
 
 package com.ardikars.jxnet.packet.icmp.icmpv6;
 
-import com.ardikars.jxnet.TwoKeyMap;
 import com.ardikars.jxnet.packet.icmp.ICMPTypeAndCode;
 
 /**
@@ -40,10 +39,9 @@ public class ICMPv6ParameterProblem extends ICMPTypeAndCode {
     }
 
     public static ICMPv6ParameterProblem register(Byte code, String name) {
-        TwoKeyMap<Byte, Byte> key = TwoKeyMap.newInstance((byte) 4, code);
         ICMPv6ParameterProblem parameterProblem =
-                new ICMPv6ParameterProblem(key.getSecondKey(), name);
-        return (ICMPv6ParameterProblem) ICMPTypeAndCode.registry.put(key, parameterProblem);
+                new ICMPv6ParameterProblem(code, name);
+        return (ICMPv6ParameterProblem) ICMPTypeAndCode.register(parameterProblem);
     }
 
     @Override
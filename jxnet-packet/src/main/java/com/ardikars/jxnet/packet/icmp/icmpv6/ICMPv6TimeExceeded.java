@@ -17,7 +17,6 @@
 
 package com.ardikars.jxnet.packet.icmp.icmpv6;
 
-import com.ardikars.jxnet.TwoKeyMap;
 import com.ardikars.jxnet.packet.icmp.ICMPTypeAndCode;
 
 /**
@@ -37,10 +36,9 @@ public class ICMPv6TimeExceeded extends ICMPTypeAndCode {
     }
 
     public static ICMPv6TimeExceeded register(Byte code, String name) {
-        TwoKeyMap<Byte, Byte> key = TwoKeyMap.newInstance((byte) 3, code);
         ICMPv6TimeExceeded timeExceeded =
-                new ICMPv6TimeExceeded(key.getSecondKey(), name);
-        return (ICMPv6TimeExceeded) ICMPTypeAndCode.registry.put(key, timeExceeded);
+                new ICMPv6TimeExceeded(code, name);
+        return (ICMPv6TimeExceeded) ICMPTypeAndCode.register(timeExceeded);
     }
 
     @Override
@@ -18,6 +18,12 @@
 package com.ardikars.jxnet.packet.ip;
 
 import com.ardikars.jxnet.packet.Packet;
+import com.ardikars.jxnet.packet.icmp.ICMPv6;
+import com.ardikars.jxnet.packet.tcp.TCP;
+import com.ardikars.jxnet.packet.udp.UDP;
+import com.ardikars.jxnet.util.Checksum;
+
+import java.nio.ByteBuffer;
 
 /**
  * @author Ardika Rommy Sanjaya
@@ -36,4 +42,40 @@ abstract class IP extends Packet {
         return this;
     }
 
+    /**
+     * Sum of the pseudo header of an upper layer packet.
+     * @param protocol upper layer protocol.
+     * @param length upper layer length.
+     * @return unfolded sum.
+     */
+    protected abstract long pseudoHeader(int protocol, int length);
+
+    /**
+     * Write payload, filling in a zero TCP, UDP or ICMPv6 checksum in place.
+     * @param buffer buffer.
+     */
+    @Override
+    protected void writeNextPacket(final ByteBuffer buffer) {
+        final Packet packet = this.getPendingPacket();
+        final int offset = buffer.position();
+        super.writeNextPacket(buffer);
+        final int length = buffer.position() - offset;
+        if (packet instanceof TCP && ((TCP) packet).getChecksum() == 0) {
+            int checksum = Checksum.finish(Checksum.sum(this.pseudoHeader(IPProtocolType.TCP.getValue(), length),
+                    buffer, offset, length));
+            buffer.putShort(offset + 16, (short) checksum);
+        } else if (packet instanceof UDP && ((UDP) packet).getChecksum() == 0) {
+            int checksum = Checksum.finish(Checksum.sum(this.pseudoHeader(IPProtocolType.UDP.getValue(), length),
+                    buffer, offset, length));
+            if (checksum == 0) {
+                checksum = 0xffff; // 0 means no checksum
+            }
+            buffer.putShort(offset + 6, (short) checksum);
+        } else if (packet instanceof ICMPv6 && ((ICMPv6) packet).getChecksum() == 0) {
+            int checksum = Checksum.finish(Checksum.sum(this.pseudoHeader(IPProtocolType.IPV6_ICMP.getValue(), length),
+                    buffer, offset, length));
+            buffer.putShort(offset + 2, (short) checksum);
+        }
+    }
+
 }
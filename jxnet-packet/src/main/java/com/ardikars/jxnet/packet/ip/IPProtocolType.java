@@ -24,9 +24,6 @@ import com.ardikars.jxnet.packet.ip.ipv6.Fragment;
 import com.ardikars.jxnet.packet.ip.ipv6.Routing;
 import com.ardikars.jxnet.NamedNumber;
 
-import java.util.HashMap;
-import java.util.Map;
-
 /**
  * @author Ardika Rommy Sanjaya
  * @since 1.1.0
@@ -63,33 +60,43 @@ public class IPProtocolType extends NamedNumber<Byte, IPProtocolType> {
         super(value, name);
     }
 
-    private static Map<Byte, IPProtocolType> registry = new HashMap<Byte, IPProtocolType>();
+    /**
+     * Registered protocols indexed by protocol number, so lookups neither box nor hash.
+     */
+    private static final IPProtocolType[] registry = new IPProtocolType[256];
 
     static {
-        registry.put(ICMP.getValue(), ICMP);
-        registry.put(IPV6.getValue(), IPV6);
-        registry.put(IPV6_ICMP.getValue(), IPV6_ICMP);
-        registry.put(IPV6_ROUTING.getValue(), IPV6_ROUTING);
-        registry.put(IPV6_FRAGMENT.getValue(), IPV6_FRAGMENT);
-        registry.put(IPV6_HOPOPT.getValue(), IPV6_HOPOPT);
-        registry.put(IPV6_DSTOPT.getValue(), IPV6_DSTOPT);
-        registry.put(IPV6_ESP.getValue(), IPV6_ESP);
-        registry.put(IPV6_AS.getValue(), IPV6_AS);
-        registry.put(IGMP.getValue(), IGMP);
-        registry.put(TCP.getValue(), TCP);
-        registry.put(UDP.getValue(), UDP);
+        register(ICMP);
+        register(IPV6);
+        register(IPV6_ICMP);
+        register(IPV6_ROUTING);
+        register(IPV6_FRAGMENT);
+        register(IPV6_HOPOPT);
+        register(IPV6_DSTOPT);
+        register(IPV6_ESP);
+        register(IPV6_AS);
+        register(IGMP);
+        register(TCP);
+        register(UDP);
     }
 
     public static IPProtocolType register(IPProtocolType protocol) {
-        return registry.put(protocol.getValue(), protocol);
+        int index = protocol.getValue() & 0xff;
+        IPProtocolType previous = registry[index];
+        registry[index] = protocol;
+        return previous;
     }
 
     public static IPProtocolType getInstance(Byte value) {
-        if (registry.containsKey(value)) {
-            return registry.get(value);
-        } else {
+        if (value == null) {
             return UNKNOWN;
         }
+        return getInstance(value.byteValue());
+    }
+
+    public static IPProtocolType getInstance(final byte value) {
+        IPProtocolType protocol = registry[value & 0xff];
+        return protocol == null ? UNKNOWN : protocol;
     }
 
     /**
@@ -19,8 +19,7 @@ package com.ardikars.jxnet.packet.ip;
 
 import com.ardikars.jxnet.Inet4Address;
 import com.ardikars.jxnet.packet.Packet;
-import com.ardikars.jxnet.packet.tcp.TCP;
-import com.ardikars.jxnet.packet.udp.UDP;
+import com.ardikars.jxnet.util.Checksum;
 
 import java.nio.ByteBuffer;
 
@@ -152,6 +151,7 @@ public class IPv4 extends IP {
 
     public IPv4 setProtocol(final IPProtocolType protocol) {
         this.protocol = protocol;
+        this.invalidatePacket();
         return this;
     }
 
@@ -250,96 +250,54 @@ public class IPv4 extends IP {
         if (packet == null) {
             return this;
         }
-        ByteBuffer bb;
-        int length = 0;
-        int accumulation = 0;
-
         switch (packet.getClass().getName()) {
             case "com.ardikars.jxnet.packet.tcp.TCP":
-                TCP tcp = (TCP) packet;
-                if (tcp.getChecksum() == 0) {
-                    bb = ByteBuffer.wrap(tcp.toBytes());
-                    length += tcp.getDataOffset() << 2;
-                    if (tcp.getPacket() != null) {
-                        length += tcp.getPacket().toBytes().length;
-                    }
-                    accumulation += (this.getSourceAddress().toInt() >> 16 & 0xffff)
-                            + (this.getSourceAddress().toInt() & 0xffff);
-                    accumulation += (this.getDestinationAddress().toInt() >> 16 & 0xffff)
-                            + (this.getDestinationAddress().toInt() & 0xffff);
-                    accumulation += this.getProtocol().getValue() & 0xff;
-                    accumulation += length & 0xffff;
-
-                    for (int i = 0; i < length / 2; ++i) {
-                        accumulation += 0xffff & bb.getShort();
-                    }
-                    if (length % 2 > 0) {
-                        accumulation += (bb.get() & 0xff) << 8;
-                    }
-
-                    accumulation = (accumulation >> 16 & 0xffff)
-                            + (accumulation & 0xffff);
-                    tcp.setChecksum((short) (~accumulation & 0xffff));
-                }
                 this.setProtocol(IPProtocolType.TCP);
-                this.nextPacket = tcp.toBytes();
+                this.setNextPacket(packet);
                 return this;
-            case "com.ardikars.jxnet.packet.tcp.UDP":
-                UDP udp = (UDP) packet;
-                if (udp.getChecksum() == 0) {
-                    bb = ByteBuffer.wrap(udp.toBytes());
-                    if (udp.getPacket() != null) {
-                        byte[] udpPayload = udp.getPacket().toBytes();
-                        length += udp.getLength() + ((udpPayload == null) ? 0 : udpPayload.length);
-                    }
-                    if (udp.getChecksum() == 0) {
-                        accumulation += (this.getSourceAddress().toInt() >> 16 & 0xffff)
-                                + (this.getSourceAddress().toInt() & 0xffff);
-                        accumulation += (this.getDestinationAddress().toInt() >> 16 & 0xffff)
-                                + (this.getDestinationAddress().toInt() & 0xffff);
-                        accumulation += this.getProtocol().getValue() & 0xff;
-                        accumulation += length & 0xffff;
-                    }
-                    for (int i = 0; i < length / 2; ++i) {
-                        accumulation += 0xffff & bb.getShort();
-                    }
-                    if (length % 2 > 0) {
-                        accumulation += (bb.get() & 0xff) << 8;
-                    }
-                    accumulation = (accumulation >> 16 & 0xffff)
-                            + (accumulation & 0xffff);
-                    udp.setChecksum((short) (~accumulation & 0xffff));
-                }
+            case "com.ardikars.jxnet.packet.udp.UDP":
                 this.setProtocol(IPProtocolType.UDP);
-                this.nextPacket = udp.toBytes();
+                this.setNextPacket(packet);
                 return this;
             case "com.ardikars.jxnet.packet.icmp.ICMPv4":
                 this.setProtocol(IPProtocolType.ICMP);
-                this.nextPacket = packet.toBytes();
+                this.setNextPacket(packet.toBytes());
                 return this;
         }
         return this;
     }
 
     @Override
-    public Packet getPacket() {
+    protected Packet decodePacket() {
         return this.getProtocol().decode(this.nextPacket);
     }
 
     @Override
-    public byte[] toBytes() {
+    protected long pseudoHeader(final int protocol, final int length) {
+        return Checksum.pseudoHeader(this.getSourceAddress().toInt(), this.getDestinationAddress().toInt(),
+                protocol, length);
+    }
 
+    @Override
+    public int computeLength() {
         int optionsLength = 0;
         if (this.getOptions() != null) {
             optionsLength = this.getOptions().length / 4;
         }
-        this.setHeaderLength((byte) (5 + optionsLength));
-        this.setTotalLength((short) (this.getHeaderLength() * 4 + (this.nextPacket == null ? 0
-                : this.nextPacket.length)));
+        return (5 + optionsLength) * 4 + this.getNextPacketLength();
+    }
+
+    @Override
+    public void writeTo(final ByteBuffer buffer) {
 
-        byte[] data = new byte[this.getTotalLength()];
+        int optionsLength = 0;
+        if (this.getOptions() != null) {
+            optionsLength = this.getOptions().length / 4;
+        }
+        this.setHeaderLength((byte) (5 + optionsLength));
+        this.setTotalLength((short) (this.getHeaderLength() * 4 + this.getNextPacketLength()));
 
-        ByteBuffer buffer = ByteBuffer.wrap(data);
+        final int offset = buffer.position();
         buffer.put((byte) ((this.getVersion() & 0xf) << 4 | this.getHeaderLength() & 0xf));
         buffer.put((byte) (((this.getDiffServ() << 2) & 0x3f) | this.getExpCon() & 0x3));
         buffer.putShort(this.getTotalLength());
@@ -347,26 +305,23 @@ public class IPv4 extends IP {
         buffer.putShort((short) ((this.getFlags() & 0x7) << 13 | this.getFragmentOffset() & 0x1fff));
         buffer.put(this.getTtl());
         buffer.put(this.getProtocol().getValue());
-        buffer.putShort((byte) (this.getChecksum() & 0xffff));
+        buffer.putShort(this.getChecksum());
         buffer.put(this.getSourceAddress().toBytes());
         buffer.put(this.getDestinationAddress().toBytes());
         if (this.getOptions() != null && this.getHeaderLength() > 5) {
-            buffer.put(this.getOptions());
+            buffer.put(this.getOptions(), 0, (this.getHeaderLength() - 5) * 4);
         }
         if (this.getChecksum() == 0) {
-            buffer.rewind();
-            int accumulation = 0;
-            for (int i = 0; i < this.getHeaderLength() * 2; ++i) {
-                accumulation += 0xffff & buffer.getShort();
-            }
-            accumulation = (accumulation >> 16 & 0xffff)
-                    + (accumulation & 0xffff);
-            this.checksum = ((short) (~accumulation & 0xffff));
-            buffer.putShort(10, (short) (this.getChecksum() & 0xffff));
-        }
-        if (this.nextPacket != null) {
-            buffer.put(this.nextPacket);
+            buffer.putShort(offset + 10, (short) Checksum.finish(Checksum.sum(0, buffer, offset,
+                    this.getHeaderLength() * 4)));
         }
+        this.writeNextPacket(buffer);
+    }
+
+    @Override
+    public byte[] toBytes() {
+        byte[] data = new byte[this.computeLength()];
+        this.writeTo(ByteBuffer.wrap(data));
         return data;
     }
 
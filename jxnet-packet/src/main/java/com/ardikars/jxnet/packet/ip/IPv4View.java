@@ -0,0 +1,120 @@
+/**
+ * Copyright (C) 2017  Ardika Rommy Sanjaya
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+package com.ardikars.jxnet.packet.ip;
+
+import com.ardikars.jxnet.packet.PacketView;
+
+import java.nio.ByteBuffer;
+
+/**
+ * Flyweight over an IPv4 header. The payload ends at the total length,
+ * so link layer padding is not part of it.
+ * @author Ardika Rommy Sanjaya
+ * @since 1.1.5
+ */
+public class IPv4View extends PacketView {
+
+    @Override
+    public boolean wrap(final ByteBuffer buffer, final int offset, final int length) {
+        return super.wrap(buffer, offset, length) && this.getVersion() == 4 && this.getHeaderLength() >= 5;
+    }
+
+    public byte getVersion() {
+        return (byte) (this.getUnsignedByte(0) >> 4 & 0xf);
+    }
+
+    /**
+     * Returning header length in 32 bit words.
+     * @return header length.
+     */
+    public byte getHeaderLength() {
+        return (byte) (this.getUnsignedByte(0) & 0xf);
+    }
+
+    public byte getDiffServ() {
+        return (byte) (this.getUnsignedByte(1) >> 2 & 0x3f);
+    }
+
+    public byte getExpCon() {
+        return (byte) (this.getUnsignedByte(1) & 0x3);
+    }
+
+    public int getTotalLength() {
+        return this.getUnsignedShort(2);
+    }
+
+    public int getIdentification() {
+        return this.getUnsignedShort(4);
+    }
+
+    public byte getFlags() {
+        return (byte) (this.getUnsignedShort(6) >> 13 & 0x7);
+    }
+
+    public short getFragmentOffset() {
+        return (short) (this.getUnsignedShort(6) & 0x1fff);
+    }
+
+    public int getTtl() {
+        return this.getUnsignedByte(8);
+    }
+
+    /**
+     * Returning protocol of the payload (see IPProtocolType.getValue()).
+     * @return protocol.
+     */
+    public byte getProtocol() {
+        return (byte) this.getUnsignedByte(9);
+    }
+
+    public int getChecksum() {
+        return this.getUnsignedShort(10);
+    }
+
+    /**
+     * Returning source address (see Inet4Address.valueOf(int)).
+     * @return source address.
+     */
+    public int getSourceAddress() {
+        return this.getInt(12);
+    }
+
+    /**
+     * Returning destination address (see Inet4Address.valueOf(int)).
+     * @return destination address.
+     */
+    public int getDestinationAddress() {
+        return this.getInt(16);
+    }
+
+    @Override
+    protected int getMinimumLength() {
+        return IPv4.IPV4_HEADER_LENGTH;
+    }
+
+    @Override
+    public int getPayloadOffset() {
+        return this.offset + (this.getHeaderLength() << 2);
+    }
+
+    @Override
+    public int getPayloadLength() {
+        return Math.max(0, Math.min(this.length, this.getTotalLength()) - (this.getHeaderLength() << 2));
+    }
+
+}
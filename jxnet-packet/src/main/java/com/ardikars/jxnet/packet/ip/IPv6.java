@@ -19,9 +19,7 @@ package com.ardikars.jxnet.packet.ip;
 
 import com.ardikars.jxnet.Inet6Address;
 import com.ardikars.jxnet.packet.Packet;
-import com.ardikars.jxnet.packet.icmp.ICMPv6;
-import com.ardikars.jxnet.packet.tcp.TCP;
-import com.ardikars.jxnet.packet.udp.UDP;
+import com.ardikars.jxnet.util.Checksum;
 
 import java.nio.ByteBuffer;
 
@@ -96,6 +94,7 @@ public class IPv6 extends IP {
 
     public IPv6 setNextHeader(final IPProtocolType nextHeader) {
         this.nextHeader = nextHeader;
+        this.invalidatePacket();
         return this;
     }
 
@@ -128,14 +127,14 @@ public class IPv6 extends IP {
 
     @Deprecated
     public byte[] getPayload() {
-        return this.nextPacket;
+        return this.getNextPacket();
     }
 
     @Deprecated
     public IPv6 setPayload(final byte[] payload) {
         if (payload != null) {
             this.setPayloadLength((short) payload.length);
-            this.nextPacket = payload;
+            this.setNextPacket(payload);
         }
         return this;
     }
@@ -173,154 +172,56 @@ public class IPv6 extends IP {
         if (packet == null) {
             return this;
         }
-        ByteBuffer bb;
-        int length = 0;
-        int accumulation = 0;
-
         switch (packet.getClass().getName()) {
             case "com.ardikars.jxnet.packet.tcp.TCP":
-                TCP tcp = (TCP) packet;
-                if (tcp.getChecksum() == 0) {
-                    bb = ByteBuffer.wrap(tcp.toBytes());
-                    length += tcp.getDataOffset() << 2;
-                    if (tcp.getPacket() != null) {
-                        length += tcp.getPacket().toBytes().length;
-                    }
-                    final int bbLength =
-                            Inet6Address.IPV6_ADDRESS_LENGTH * 2 // IPv6 src, dst
-                                    + 2  // nextHeader (with padding)
-                                    + 4; // length
-                    final ByteBuffer bbChecksum = ByteBuffer.allocate(bbLength);
-                    bbChecksum.put(this.getSourceAddress().toBytes());
-                    bbChecksum.put(this.getDestinationAddress().toBytes());
-                    bbChecksum.put((byte) 0); // padding
-                    bbChecksum.put(this.getNextHeader().getValue());
-                    bbChecksum.putInt(length);
-                    bbChecksum.rewind();
-                    for (int i = 0; i < bbLength / 2; ++i) {
-                        accumulation += 0xffff & bbChecksum.getShort();
-                    }
-                    for (int i = 0; i < length / 2; ++i) {
-                        accumulation += 0xffff & bb.getShort();
-                    }
-                    // pad to an even number of shorts
-                    if (length % 2 > 0) {
-                        accumulation += (bb.get() & 0xff) << 8;
-                    }
-
-                    accumulation = (accumulation >> 16 & 0xffff)
-                            + (accumulation & 0xffff);
-                    tcp.setChecksum((short) (~accumulation & 0xffff));
-                }
                 this.setNextHeader(IPProtocolType.TCP);
-                this.nextPacket = tcp.toBytes();
+                this.setNextPacket(packet);
                 return this;
-            case "com.ardikars.jxnet.packet.tcp.UDP":
-                UDP udp = (UDP) packet;
-                if (udp.getChecksum() == 0) {
-                    bb = ByteBuffer.wrap(udp.toBytes());
-                    length += UDP.UDP_HEADER_LENGTH;
-                    if (udp.getPacket() != null) {
-                        length += udp.getPacket().toBytes().length;
-                    }
-                    final int bbLength =
-                            Inet6Address.IPV6_ADDRESS_LENGTH * 2 // IPv6 src, dst
-                                    + 2  // nextHeader (with padding)
-                                    + 4; // length
-                    final ByteBuffer bbChecksum = ByteBuffer.allocate(bbLength);
-                    bbChecksum.put(this.getSourceAddress().toBytes());
-                    bbChecksum.put(this.getDestinationAddress().toBytes());
-                    bbChecksum.put((byte) 0); // padding
-                    bbChecksum.put(this.getNextHeader().getValue());
-                    bbChecksum.putInt(length);
-                    bbChecksum.rewind();
-                    for (int i = 0; i < bbLength / 2; ++i) {
-                        accumulation += 0xffff & bbChecksum.getShort();
-                    }
-                    for (int i = 0; i < length / 2; ++i) {
-                        accumulation += 0xffff & bb.getShort();
-                    }
-                    // pad to an even number of shorts
-                    if (length % 2 > 0) {
-                        accumulation += (bb.get() & 0xff) << 8;
-                    }
-
-                    accumulation = (accumulation >> 16 & 0xffff)
-                            + (accumulation & 0xffff);
-                    udp.setChecksum((short) (~accumulation & 0xffff));
-                }
+            case "com.ardikars.jxnet.packet.udp.UDP":
                 this.setNextHeader(IPProtocolType.UDP);
-                this.nextPacket = udp.toBytes();
+                this.setNextPacket(packet);
                 return this;
             case "com.ardikars.jxnet.packet.icmp.ICMPv6":
-                ICMPv6 icmp = (ICMPv6) packet;
-                if (icmp.getChecksum() == 0) {
-                    bb = ByteBuffer.wrap(icmp.toBytes());
-                    byte[] icmpPayload = new byte[0];
-                    if (icmp.getPacket() != null) {
-                        icmpPayload = icmp.getPacket().toBytes();
-                    }
-                    final int bbLength =
-                            IPV6_HEADER_LENGTH + ICMPv6.ICMP_HEADER_LENGTH +
-                            icmpPayload.length;
-
-                    final ByteBuffer bbChecksum = ByteBuffer.allocate(bbLength);
-                    bbChecksum.put(this.getSourceAddress().toBytes());
-                    bbChecksum.put(this.getDestinationAddress().toBytes());
-                    bbChecksum.putInt(IPV6_HEADER_LENGTH + icmpPayload.length);
-                    bbChecksum.put((byte) 0);
-                    bbChecksum.put((byte) 0);
-                    bbChecksum.put((byte) 0);
-                    bbChecksum.put(IPProtocolType.IPV6_ICMP.getValue());
-                    bbChecksum.put(icmp.getTypeAndCode().getType());
-                    bbChecksum.put(icmp.getTypeAndCode().getCode());
-                    bbChecksum.put((byte) 0);
-                    bbChecksum.put((byte) 0);
-                    if (icmpPayload != null) {
-                        bb.put(icmpPayload);
-                        bbChecksum.put(icmpPayload);
-                    }
-                    bb.rewind();
-                    bbChecksum.rewind();
-
-                    for (int i = 0; i < bbChecksum.capacity() / 2; ++i) {
-                        accumulation += 0xffff & bbChecksum.getShort();
-                    }
-                    // pad to an even number of shorts
-                    if (bbChecksum.capacity() % 2 > 0) {
-                        accumulation += (bbChecksum.get() & 0xff) << 8;
-                    }
-
-                    accumulation = (accumulation >> 16 & 0xffff)
-                            + (accumulation & 0xffff);
-                    icmp.setChecksum((short) (~accumulation & 0xffff));
-                }
                 this.setNextHeader(IPProtocolType.IPV6_ICMP);
-                this.nextPacket = icmp.toBytes();
+                this.setNextPacket(packet);
                 return this;
         }
-        this.nextPacket = packet.toBytes();
+        this.setNextPacket(packet.toBytes());
         return this;
     }
 
     @Override
-    public Packet getPacket() {
+    protected Packet decodePacket() {
         return this.getNextHeader().decode(this.nextPacket);
     }
 
     @Override
-    public byte[] toBytes() {
-        byte[] data = new byte[IPV6_HEADER_LENGTH + ((this.nextPacket == null) ? 0 : this.nextPacket.length)];
-        ByteBuffer buffer = ByteBuffer.wrap(data);
+    protected long pseudoHeader(final int protocol, final int length) {
+        return Checksum.pseudoHeader(this.getSourceAddress().toBytes(), this.getDestinationAddress().toBytes(),
+                protocol, length);
+    }
+
+    @Override
+    public int computeLength() {
+        return IPV6_HEADER_LENGTH + this.getNextPacketLength();
+    }
+
+    @Override
+    public void writeTo(final ByteBuffer buffer) {
+        this.setPayloadLength((short) this.getNextPacketLength());
         buffer.putInt((this.getVersion() & 0xf) << 28 | (this.getTrafficClass() & 0xff) << 20 | this.getFlowLabel() & 0xfffff);
         buffer.putShort(this.getPayloadLength());
         buffer.put(this.getNextHeader().getValue());
         buffer.put(this.getHopLimit());
         buffer.put(this.getSourceAddress().toBytes());
-        buffer.put(this.getSourceAddress().toBytes());
-        if (this.nextPacket != null) {
-            buffer.put(this.nextPacket);
-        }
+        buffer.put(this.getDestinationAddress().toBytes());
+        this.writeNextPacket(buffer);
+    }
+
+    @Override
+    public byte[] toBytes() {
+        byte[] data = new byte[this.computeLength()];
+        this.writeTo(ByteBuffer.wrap(data));
         return data;
     }
 
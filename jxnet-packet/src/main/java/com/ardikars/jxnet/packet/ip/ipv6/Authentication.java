@@ -42,6 +42,7 @@ public class Authentication extends Packet {
 
     public Authentication setNextHeader(final IPProtocolType nextHeader) {
         this.nextHeader = nextHeader;
+        this.invalidatePacket();
         return this;
     }
 
@@ -78,6 +79,7 @@ public class Authentication extends Packet {
 
     public Authentication setPayload(final byte[] payload) {
         this.payload = payload;
+        this.invalidatePacket();
         return this;
     }
 
@@ -105,11 +107,12 @@ public class Authentication extends Packet {
     @Override
     public Packet setPacket(Packet packet) {
         this.payload = packet.toBytes();
+        this.invalidatePacket();
         return this;
     }
 
     @Override
-    public Packet getPacket() {
+    protected Packet decodePacket() {
         return this.nextHeader.decode(this.getPayload());
     }
 
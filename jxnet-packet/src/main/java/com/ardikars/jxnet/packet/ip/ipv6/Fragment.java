@@ -47,6 +47,7 @@ public class Fragment extends IPv6ExtensionHeader {
 
     public Fragment setNextHeader(final IPProtocolType nextHeader) {
         this.nextHeader = nextHeader;
+        this.invalidatePacket();
         return this;
     }
 
@@ -83,6 +84,7 @@ public class Fragment extends IPv6ExtensionHeader {
 
     public Fragment setPayload(final byte[] payload) {
         this.payload = payload;
+        this.invalidatePacket();
         return this;
     }
 
@@ -107,7 +109,7 @@ public class Fragment extends IPv6ExtensionHeader {
     }
 
     @Override
-    public Packet getPacket() {
+    protected Packet decodePacket() {
         if (this.getPayload() == null || this.getPayload().length == 0) return null;
         return this.nextHeader.decode(this.getPayload());
     }
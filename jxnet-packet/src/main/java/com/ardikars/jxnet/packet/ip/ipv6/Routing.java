@@ -51,6 +51,7 @@ public class Routing extends IPv6ExtensionHeader {
 
     public Routing setNextHeader(final IPProtocolType nextHeader) {
         this.nextHeader = nextHeader;
+        this.invalidatePacket();
         return this;
     }
 
@@ -96,6 +97,7 @@ public class Routing extends IPv6ExtensionHeader {
 
     public Routing setPayload(final byte[] payload) {
         this.payload = payload;
+        this.invalidatePacket();
         return this;
     }
 
@@ -124,7 +126,7 @@ public class Routing extends IPv6ExtensionHeader {
     }
 
     @Override
-    public Packet getPacket() {
+    protected Packet decodePacket() {
         if (this.getPayload() == null || this.getPayload().length == 0) return null;
         switch (this.getNextHeader().getValue()) {
             case 6: return TCP.newInstance(this.getPayload());
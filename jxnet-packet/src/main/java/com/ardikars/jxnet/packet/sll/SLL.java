@@ -83,6 +83,7 @@ public class SLL extends Packet {
 
     public SLL setProtocol(final ProtocolType protocol) {
         this.protocol = protocol;
+        this.invalidatePacket();
         return this;
     }
 
@@ -128,7 +129,7 @@ public class SLL extends Packet {
     }
 
     @Override
-    public Packet getPacket() {
+    protected Packet decodePacket() {
         return this.getProtocol().decode(this.nextPacket);
     }
 
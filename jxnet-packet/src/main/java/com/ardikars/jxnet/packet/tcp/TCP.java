@@ -138,12 +138,12 @@ public class TCP extends Packet {
 
     @Deprecated
     public byte[] getPayload() {
-        return this.nextPacket;
+        return this.getNextPacket();
     }
 
     @Deprecated
     public TCP setPayload(final byte[] payload) {
-        this.nextPacket = payload;
+        this.setNextPacket(payload);
         return this;
     }
 
@@ -188,22 +188,24 @@ public class TCP extends Packet {
         }
         switch (packet.getClass().getName()) {
             default:
-                this.nextPacket = packet.toBytes();
+                this.setNextPacket(packet.toBytes());
                 return this;
         }
     }
 
     @Override
-    public Packet getPacket() {
+    protected Packet decodePacket() {
         if (this.nextPacket == null || this.nextPacket.length == 0) return null;
         return UnknownPacket.newInstance(this.nextPacket);
     }
 
     @Override
-    public byte[] toBytes() {
-        byte[] data = new byte[TCP_HEADER_LENGTH + ((options == null) ? 0 : options.length) +
-                ((this.nextPacket == null) ? 0 : this.nextPacket.length)];
-        ByteBuffer buffer = ByteBuffer.wrap(data);
+    public int computeLength() {
+        return TCP_HEADER_LENGTH + ((options == null) ? 0 : options.length) + this.getNextPacketLength();
+    }
+
+    @Override
+    public void writeTo(final ByteBuffer buffer) {
         buffer.putShort(this.getSourcePort());
         buffer.putShort(this.getDestinationPort());
         buffer.putInt(this.getSequence());
@@ -214,8 +216,13 @@ public class TCP extends Packet {
         buffer.putShort(this.getUrgentPointer());
         if (this.getOptions() != null)
             buffer.put(this.getOptions());
-        if (this.nextPacket != null)
-            buffer.put(this.nextPacket);
+        this.writeNextPacket(buffer);
+    }
+
+    @Override
+    public byte[] toBytes() {
+        byte[] data = new byte[this.computeLength()];
+        this.writeTo(ByteBuffer.wrap(data));
         return data;
     }
 
@@ -0,0 +1,83 @@
+/**
+ * Copyright (C) 2017  Ardika Rommy Sanjaya
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+package com.ardikars.jxnet.packet.tcp;
+
+import com.ardikars.jxnet.packet.PacketView;
+
+/**
+ * Flyweight over a TCP header.
+ * @author Ardika Rommy Sanjaya
+ * @since 1.1.5
+ */
+public class TCPView extends PacketView {
+
+    public int getSourcePort() {
+        return this.getUnsignedShort(0);
+    }
+
+    public int getDestinationPort() {
+        return this.getUnsignedShort(2);
+    }
+
+    public int getSequence() {
+        return this.getInt(4);
+    }
+
+    public int getAcknowledge() {
+        return this.getInt(8);
+    }
+
+    /**
+     * Returning header length in 32 bit words.
+     * @return data offset.
+     */
+    public byte getDataOffset() {
+        return (byte) (this.getUnsignedByte(12) >> 4 & 0xf);
+    }
+
+    /**
+     * Returning the 9 flag bits (see TCPFlags.newInstance(short)).
+     * @return flags.
+     */
+    public short getFlags() {
+        return (short) (this.getUnsignedShort(12) & 0x1ff);
+    }
+
+    public int getWindowSize() {
+        return this.getUnsignedShort(14);
+    }
+
+    public int getChecksum() {
+        return this.getUnsignedShort(16);
+    }
+
+    public int getUrgentPointer() {
+        return this.getUnsignedShort(18);
+    }
+
+    @Override
+    protected int getMinimumLength() {
+        return TCP.TCP_HEADER_LENGTH;
+    }
+
+    @Override
+    public int getPayloadOffset() {
+        return this.offset + Math.max(this.getDataOffset() << 2, TCP.TCP_HEADER_LENGTH);
+    }
+
+}
@@ -109,12 +109,12 @@ public class UDP extends Packet {
 
     @Deprecated
     public byte[] getPayload() {
-        return this.nextPacket;
+        return this.getNextPacket();
     }
 
     @Deprecated
     public UDP setPayload(byte[] payload) {
-        this.nextPacket = payload;
+        this.setNextPacket(payload);
         return this;
     }
 
@@ -158,7 +158,7 @@ public class UDP extends Packet {
         }
         switch (packet.getClass().getName()) {
             default:
-                this.nextPacket = packet.toBytes();
+                this.setNextPacket(packet.toBytes());
                 return this;
         }
     }
@@ -168,22 +168,30 @@ public class UDP extends Packet {
      * @return packet.
      */
     @Override
-    public Packet getPacket() {
+    protected Packet decodePacket() {
         if (this.nextPacket == null || this.nextPacket.length == 0) return null;
         return UnknownPacket.newInstance(this.nextPacket);
     }
 
     @Override
-    public byte[] toBytes() {
-        byte[] data = new byte[UDP_HEADER_LENGTH + ((this.nextPacket == null) ? 0 : this.nextPacket.length)];
-        ByteBuffer buffer = ByteBuffer.wrap(data);
+    public int computeLength() {
+        return UDP_HEADER_LENGTH + this.getNextPacketLength();
+    }
+
+    @Override
+    public void writeTo(final ByteBuffer buffer) {
         buffer.putShort(this.getSourcePort());
         buffer.putShort(this.getDestinationPort());
-        this.length = (short) (UDP_HEADER_LENGTH + ((this.nextPacket == null) ? 0 : this.nextPacket.length));
+        this.length = (short) this.computeLength();
         buffer.putShort(this.getLength());
         buffer.putShort(this.getChecksum());
-        if (this.nextPacket != null)
-            buffer.put(this.nextPacket);
+        this.writeNextPacket(buffer);
+    }
+
+    @Override
+    public byte[] toBytes() {
+        byte[] data = new byte[this.computeLength()];
+        this.writeTo(ByteBuffer.wrap(data));
         return data;
     }
 
@@ -0,0 +1,59 @@
+/**
+ * Copyright (C) 2017  Ardika Rommy Sanjaya
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+package com.ardikars.jxnet.packet.udp;
+
+import com.ardikars.jxnet.packet.PacketView;
+
+/**
+ * Flyweight over a UDP header.
+ * @author Ardika Rommy Sanjaya
+ * @since 1.1.5
+ */
+public class UDPView extends PacketView {
+
+    public int getSourcePort() {
+        return this.getUnsignedShort(0);
+    }
+
+    public int getDestinationPort() {
+        return this.getUnsignedShort(2);
+    }
+
+    /**
+     * Returning length of header and payload.
+     * @return length.
+     */
+    public int getUdpLength() {
+        return this.getUnsignedShort(4);
+    }
+
+    public int getChecksum() {
+        return this.getUnsignedShort(6);
+    }
+
+    @Override
+    protected int getMinimumLength() {
+        return UDP.UDP_HEADER_LENGTH;
+    }
+
+    @Override
+    public int getPayloadOffset() {
+        return this.offset + UDP.UDP_HEADER_LENGTH;
+    }
+
+}
@@ -6,15 +6,147 @@ import com.ardikars.jxnet.packet.ip.IPv4;
 import com.ardikars.jxnet.packet.ip.IPv6;
 import com.ardikars.jxnet.packet.tcp.TCP;
 import com.ardikars.jxnet.packet.tcp.TCPFlags;
+import com.ardikars.jxnet.util.Checksum;
 import com.ardikars.jxnet.util.HexUtils;
+import org.junit.Assert;
+import org.junit.Test;
 
 import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+import java.util.Random;
 
 public class ChecksumTest {
 
     private static String HEX_STREAM = "" +
             "4c5e0c78508f40f02fa46abe08004500003497d8400040064fe3ac1001e59df00723d76201bb9439b553e802b0c6801000e5816c00000101080a000b228e5c026753";
 
+    private static final int IPV4_OFFSET = 14;
+    private static final int TCP_OFFSET = 34;
+
+    /**
+     * Reference RFC 1071 checksum, a 16 bit word at a time.
+     */
+    private static int reference(byte[]... pieces) {
+        long sum = 0;
+        for (byte[] piece : pieces) {
+            for (int i = 0; i < piece.length; i += 2) {
+                sum += ((piece[i] & 0xff) << 8) | (i + 1 < piece.length ? piece[i + 1] & 0xff : 0);
+            }
+        }
+        while ((sum >>> 16) != 0) {
+            sum = (sum & 0xffff) + (sum >>> 16);
+        }
+        return (int) (~sum & 0xffff);
+    }
+
+    private static int tcpChecksum(byte[] frame) {
+        ByteBuffer buffer = ByteBuffer.wrap(frame);
+        int length = frame.length - TCP_OFFSET;
+        long sum = Checksum.pseudoHeader(buffer.getInt(IPV4_OFFSET + 12), buffer.getInt(IPV4_OFFSET + 16), 6, length);
+        return Checksum.finish(Checksum.sum(sum, frame, TCP_OFFSET, length));
+    }
+
+    @Test
+    public void ipv4Header() {
+        byte[] frame = HexUtils.parseHex(HEX_STREAM);
+        Assert.assertEquals(0, Checksum.compute(frame, IPV4_OFFSET, 20));
+        frame[IPV4_OFFSET + 10] = 0;
+        frame[IPV4_OFFSET + 11] = 0;
+        Assert.assertEquals(0x4fe3, Checksum.compute(frame, IPV4_OFFSET, 20));
+    }
+
+    @Test
+    public void tcpPseudoHeader() {
+        Assert.assertEquals(0, tcpChecksum(HexUtils.parseHex(HEX_STREAM)));
+    }
+
+    @Test
+    public void incrementalUpdate() {
+        byte[] frame = HexUtils.parseHex(HEX_STREAM);
+        ByteBuffer buffer = ByteBuffer.wrap(frame);
+        int ipChecksum = buffer.getShort(IPV4_OFFSET + 10) & 0xffff;
+        int tcpChecksum = buffer.getShort(TCP_OFFSET + 16) & 0xffff;
+
+        // rewrite the source port
+        int oldPort = buffer.getShort(TCP_OFFSET) & 0xffff;
+        buffer.putShort(TCP_OFFSET, (short) 8080);
+        tcpChecksum = Checksum.updateShort(tcpChecksum, oldPort, 8080);
+        buffer.putShort(TCP_OFFSET + 16, (short) tcpChecksum);
+        Assert.assertEquals(0, tcpChecksum(frame));
+
+        // rewrite the source address, covered by both checksums
+        int oldAddress = buffer.getInt(IPV4_OFFSET + 12);
+        int newAddress = Inet4Address.valueOf("10.1.2.3").toInt();
+        buffer.putInt(IPV4_OFFSET + 12, newAddress);
+        buffer.putShort(IPV4_OFFSET + 10, (short) Checksum.updateInt(ipChecksum, oldAddress, newAddress));
+        buffer.putShort(TCP_OFFSET + 16, (short) Checksum.updateInt(tcpChecksum, oldAddress, newAddress));
+        Assert.assertEquals(0, Checksum.compute(frame, IPV4_OFFSET, 20));
+        Assert.assertEquals(0, tcpChecksum(frame));
+
+        byte[] oldBytes = new byte[] { 1, 2, 3, 4, 5, 6 };
+        byte[] newBytes = new byte[] { 6, 5, 4, 3, 2, 1 };
+        byte[] data = new byte[] { 9, 9, 1, 2, 3, 4, 5, 6, 7 };
+        int checksum = Checksum.compute(data, 0, data.length);
+        System.arraycopy(newBytes, 0, data, 2, newBytes.length);
+        Assert.assertEquals(Checksum.compute(data, 0, data.length), Checksum.update(checksum, oldBytes, newBytes));
+    }
+
+    @Test
+    public void wordAtATime() {
+        Random random = new Random(1);
+        for (int length = 0; length < 64; length++) {
+            byte[] data = new byte[length + 3];
+            random.nextBytes(data);
+            byte[] piece = new byte[length];
+            System.arraycopy(data, 3, piece, 0, length);
+            int expected = reference(piece);
+            Assert.assertEquals(expected, Checksum.compute(data, 3, length));
+            Assert.assertEquals(expected, Checksum.finish(Checksum.sum(0,
+                    ByteBuffer.wrap(data).order(ByteOrder.LITTLE_ENDIAN), 3, length)));
+            ByteBuffer direct = ByteBuffer.allocateDirect(data.length);
+            direct.put(data);
+            Assert.assertEquals(expected, Checksum.finish(Checksum.sum(0, direct, 3, length)));
+        }
+    }
+
+    @Test
+    public void ipv6PseudoHeader() {
+        Random random = new Random(2);
+        byte[] source = new byte[16];
+        byte[] destination = new byte[16];
+        byte[] segment = new byte[41];
+        random.nextBytes(source);
+        random.nextBytes(destination);
+        random.nextBytes(segment);
+        byte[] pseudo = new byte[8];
+        ByteBuffer.wrap(pseudo).putInt(segment.length).putInt(17);
+        Assert.assertEquals(reference(source, destination, pseudo, segment),
+                Checksum.finish(Checksum.sum(Checksum.pseudoHeader(source, destination, 17, segment.length),
+                        segment, 0, segment.length)));
+    }
+
+    @Test
+    public void ipv4SetPacket() {
+        TCP tcp = new TCP()
+                .setSourcePort((short) 38948)
+                .setDestinationPort((short) 443)
+                .setSequence(0x665426d5)
+                .setDataOffset((byte) 8)
+                .setFlags(TCPFlags.newInstance((short) 2))
+                .setWindowSize((short) 29200)
+                .setOptions(HexUtils.parseHex("0101080a000b228e5c026753"));
+        IPv4 iPv4 = new IPv4();
+        iPv4.setTtl((byte) 64);
+        iPv4.setSourceAddress(Inet4Address.valueOf("172.16.1.229"));
+        iPv4.setDestinationAddress(Inet4Address.valueOf("157.240.7.35"));
+        iPv4.setPacket(tcp);
+        byte[] ip = iPv4.toBytes();
+        Assert.assertEquals(0, Checksum.compute(ip, 0, 20));
+        byte[] frame = new byte[IPV4_OFFSET + ip.length];
+        System.arraycopy(ip, 0, frame, IPV4_OFFSET, ip.length);
+        Assert.assertEquals(0, tcpChecksum(frame));
+    }
+
     public static void main(String[] args) {
         Ethernet ethernet = new Ethernet()
                 .setDestinationMacAddress(MacAddress.DUMMY)
@@ -0,0 +1,34 @@
+package com.ardikars.test;
+
+import com.ardikars.jxnet.packet.Packet;
+import com.ardikars.jxnet.packet.ethernet.Ethernet;
+import com.ardikars.jxnet.packet.ethernet.ProtocolType;
+import com.ardikars.jxnet.packet.ip.IPv4;
+import com.ardikars.jxnet.packet.tcp.TCP;
+import com.ardikars.jxnet.util.HexUtils;
+import org.junit.Assert;
+import org.junit.Test;
+
+public class LazyDecode {
+
+    private static final String HEX_STREAM = "14cc20ccb9ecb827eb9a9c5f08004500003c8303400040061710c0a80196dea5ffc4e7661f9069206fa400000000a0027210a0d70000020405b40402080a0020eca70000000001030307";
+
+    @Test
+    public void run() {
+        Ethernet eth = Ethernet.newInstance(HexUtils.parseHex(HEX_STREAM));
+        Packet ipv4 = eth.getPacket();
+        Assert.assertTrue(ipv4 instanceof IPv4);
+        Assert.assertSame(ipv4, eth.getPacket());
+        Packet tcp = ipv4.getPacket();
+        Assert.assertTrue(tcp instanceof TCP);
+        Assert.assertSame(tcp, ipv4.getPacket());
+
+        // setters that change how the payload decodes drop the memoized layer
+        eth.setEthernetType(ProtocolType.IPV4);
+        Assert.assertNotSame(ipv4, eth.getPacket());
+        ipv4 = eth.getPacket();
+        eth.setPacket(new IPv4());
+        Assert.assertNotSame(ipv4, eth.getPacket());
+    }
+
+}
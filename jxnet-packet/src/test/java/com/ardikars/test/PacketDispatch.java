@@ -0,0 +1,30 @@
+package com.ardikars.test;
+
+import com.ardikars.jxnet.DataLinkType;
+import com.ardikars.jxnet.packet.Packet;
+import com.ardikars.jxnet.packet.PacketDispatcher;
+import com.ardikars.jxnet.packet.UnknownPacket;
+import com.ardikars.jxnet.packet.ethernet.Ethernet;
+import com.ardikars.jxnet.packet.ip.IPv4;
+import com.ardikars.jxnet.packet.tcp.TCP;
+import com.ardikars.jxnet.packet.udp.UDP;
+import com.ardikars.jxnet.util.HexUtils;
+import org.junit.Assert;
+import org.junit.Test;
+
+public class PacketDispatch {
+
+    private static final String HEX_STREAM = "14cc20ccb9ecb827eb9a9c5f08004500003c8303400040061710c0a80196dea5ffc4e7661f9069206fa400000000a0027210a0d70000020405b40402080a0020eca70000000001030307";
+
+    @Test
+    public void run() {
+        byte[] data = HexUtils.parseHex(HEX_STREAM);
+        Assert.assertTrue(PacketDispatcher.newInstance((Class<Packet>) null, 0).dispatch(DataLinkType.EN10MB, data) instanceof Ethernet);
+        Assert.assertTrue(PacketDispatcher.newInstance(IPv4.class, 0).dispatch(DataLinkType.EN10MB, data) instanceof IPv4);
+        Assert.assertTrue(PacketDispatcher.newInstance(TCP.class, 1).dispatch(DataLinkType.EN10MB, data) instanceof TCP);
+        Assert.assertNull(PacketDispatcher.newInstance(TCP.class, 2).dispatch(DataLinkType.EN10MB, data));
+        Assert.assertNull(PacketDispatcher.newInstance(UDP.class, 0).dispatch(DataLinkType.EN10MB, data));
+        Assert.assertTrue(PacketDispatcher.decode(DataLinkType.NULL, data) instanceof UnknownPacket);
+    }
+
+}
@@ -0,0 +1,108 @@
+package com.ardikars.test;
+
+import com.ardikars.jxnet.Jxnet;
+import com.ardikars.jxnet.MacAddress;
+import com.ardikars.jxnet.Pcap;
+import com.ardikars.jxnet.PcapPktHdr;
+import com.ardikars.jxnet.packet.PacketHelper;
+import com.ardikars.jxnet.packet.PacketViewHandler;
+import com.ardikars.jxnet.packet.ethernet.Ethernet;
+import com.ardikars.jxnet.packet.ethernet.EthernetView;
+import com.ardikars.jxnet.packet.ethernet.ProtocolType;
+import com.ardikars.jxnet.packet.ip.IPProtocolType;
+import com.ardikars.jxnet.packet.ip.IPv4;
+import com.ardikars.jxnet.packet.ip.IPv4View;
+import com.ardikars.jxnet.packet.tcp.TCP;
+import com.ardikars.jxnet.packet.tcp.TCPView;
+import org.junit.Assert;
+import org.junit.Test;
+
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+
+public class PacketViews {
+
+    @Test
+    public void run() {
+        StringBuilder errbuf = new StringBuilder();
+        Pcap pcap = Jxnet.PcapOpenOffline("../sample-capture/eth_ipv4_tcp.pcapng", errbuf);
+        if (pcap == null) {
+            System.err.println(errbuf.toString());
+            return;
+        }
+        EthernetView ethView = new EthernetView();
+        IPv4View ipView = new IPv4View();
+        TCPView tcpView = new TCPView();
+        PcapPktHdr pktHdr = new PcapPktHdr();
+        ByteBuffer buf;
+        int tcpCount = 0;
+        while ((buf = Jxnet.PcapNext(pcap, pktHdr)) != null) {
+            byte[] bytes = new byte[pktHdr.getCapLen()];
+            buf.get(bytes);
+            Ethernet eth = Ethernet.newInstance(bytes);
+            // views read network byte order whatever the order of the buffer
+            ByteBuffer wrapped = ByteBuffer.wrap(bytes).order(ByteOrder.LITTLE_ENDIAN);
+
+            Assert.assertTrue(ethView.wrap(wrapped, 0, bytes.length));
+            Assert.assertEquals(eth.getDestinationMacAddress(), MacAddress.valueOf(ethView.getDestinationMacAddress()));
+            Assert.assertEquals(eth.getSourceMacAddress(), MacAddress.valueOf(ethView.getSourceMacAddress()));
+            Assert.assertEquals(eth.getEthernetType().getValue().shortValue(), ethView.getEthernetType());
+            if (ethView.getEthernetType() != ProtocolType.IPV4.getValue()) {
+                continue;
+            }
+            IPv4 ipv4 = (IPv4) eth.getPacket();
+            Assert.assertTrue(ipView.wrap(ethView));
+            Assert.assertEquals(ipv4.getHeaderLength(), ipView.getHeaderLength());
+            Assert.assertEquals(ipv4.getTotalLength() & 0xffff, ipView.getTotalLength());
+            Assert.assertEquals(ipv4.getIdentification() & 0xffff, ipView.getIdentification());
+            Assert.assertEquals(ipv4.getTtl() & 0xff, ipView.getTtl());
+            Assert.assertEquals(ipv4.getSourceAddress().toInt(), ipView.getSourceAddress());
+            Assert.assertEquals(ipv4.getDestinationAddress().toInt(), ipView.getDestinationAddress());
+            Assert.assertEquals(ipv4.getTotalLength() - ipv4.getHeaderLength() * 4, ipView.getPayloadLength());
+            if (ipView.getProtocol() != IPProtocolType.TCP.getValue()) {
+                continue;
+            }
+            TCP tcp = (TCP) ipv4.getPacket();
+            Assert.assertTrue(tcpView.wrap(ipView));
+            Assert.assertEquals(tcp.getSourcePort() & 0xffff, tcpView.getSourcePort());
+            Assert.assertEquals(tcp.getDestinationPort() & 0xffff, tcpView.getDestinationPort());
+            Assert.assertEquals(tcp.getSequence(), tcpView.getSequence());
+            Assert.assertEquals(tcp.getAcknowledge(), tcpView.getAcknowledge());
+            Assert.assertEquals(tcp.getDataOffset(), tcpView.getDataOffset());
+            Assert.assertEquals(tcp.getWindowSize() & 0xffff, tcpView.getWindowSize());
+            Assert.assertEquals(tcp.getChecksum() & 0xffff, tcpView.getChecksum());
+            tcpCount++;
+        }
+        Assert.assertTrue(tcpCount > 0);
+        Assert.assertFalse(ethView.wrap(ByteBuffer.allocate(10), 0, 10));
+        Jxnet.PcapClose(pcap);
+    }
+
+    @Test
+    public void loop() {
+        StringBuilder errbuf = new StringBuilder();
+        Pcap pcap = Jxnet.PcapOpenOffline("../sample-capture/eth_ipv4_tcp.pcapng", errbuf);
+        if (pcap == null) {
+            System.err.println(errbuf.toString());
+            return;
+        }
+        IPv4View ipView = new IPv4View();
+        PcapPktHdr[] first = new PcapPktHdr[1];
+        int[] ipv4Count = new int[1];
+        PacketViewHandler<String> handler = (arg, pktHdr, ethernet) -> {
+            if (first[0] == null) {
+                first[0] = pktHdr;
+            }
+            Assert.assertSame(first[0], pktHdr);
+            Assert.assertEquals(pktHdr.getCapLen(), ethernet.getLength());
+            if (ethernet.getEthernetType() == ProtocolType.IPV4.getValue() && ipView.wrap(ethernet)) {
+                Assert.assertEquals(4, ipView.getVersion());
+                ipv4Count[0]++;
+            }
+        };
+        Assert.assertEquals(0, PacketHelper.loop(pcap, 10, handler, "Jxnet!"));
+        Assert.assertTrue(ipv4Count[0] > 0);
+        Jxnet.PcapClose(pcap);
+    }
+
+}
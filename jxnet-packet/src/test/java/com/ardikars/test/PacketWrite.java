@@ -0,0 +1,152 @@
+package com.ardikars.test;
+
+import com.ardikars.jxnet.Inet4Address;
+import com.ardikars.jxnet.Inet6Address;
+import com.ardikars.jxnet.MacAddress;
+import com.ardikars.jxnet.packet.Packet;
+import com.ardikars.jxnet.packet.ethernet.Ethernet;
+import com.ardikars.jxnet.packet.icmp.ICMPv6;
+import com.ardikars.jxnet.packet.icmp.icmpv6.ICMPv6EchoRequest;
+import com.ardikars.jxnet.packet.ip.IPv4;
+import com.ardikars.jxnet.packet.ip.IPv6;
+import com.ardikars.jxnet.packet.tcp.TCP;
+import com.ardikars.jxnet.packet.tcp.TCPFlags;
+import com.ardikars.jxnet.packet.udp.UDP;
+import com.ardikars.jxnet.util.Checksum;
+import org.junit.Assert;
+import org.junit.Test;
+
+import java.nio.ByteBuffer;
+import java.util.Arrays;
+
+public class PacketWrite {
+
+    private static final byte[] DATA = "GET / HTTP/1.1\r\n\r\n".getBytes();
+
+    private static Packet tcpFrame() {
+        TCP tcp = new TCP()
+                .setSourcePort((short) 38948)
+                .setDestinationPort((short) 80)
+                .setSequence(0x665426d5)
+                .setDataOffset((byte) 5)
+                .setFlags(TCPFlags.newInstance((short) 0x18))
+                .setWindowSize((short) 29200)
+                .setPayload(DATA);
+        IPv4 ipv4 = new IPv4();
+        ipv4.setTtl((byte) 64);
+        ipv4.setSourceAddress(Inet4Address.valueOf("172.16.1.229"));
+        ipv4.setDestinationAddress(Inet4Address.valueOf("157.240.7.35"));
+        return Packet.PacketBuilder()
+                .add(new Ethernet()
+                        .setDestinationMacAddress(MacAddress.BROADCAST)
+                        .setSourceMacAddress(MacAddress.DUMMY))
+                .add(ipv4)
+                .add(tcp)
+                .build();
+    }
+
+    @Test
+    public void singlePass() {
+        Packet frame = tcpFrame();
+        int length = frame.computeLength();
+        Assert.assertEquals(14 + 20 + 20 + DATA.length, length);
+
+        ByteBuffer buffer = ByteBuffer.allocateDirect(length + 8);
+        buffer.position(8);
+        frame.writeTo(buffer);
+        Assert.assertEquals(length + 8, buffer.position());
+
+        byte[] written = new byte[length];
+        buffer.position(8);
+        buffer.get(written);
+        Assert.assertArrayEquals(frame.toBytes(), written);
+
+        // IPv4 header checksum and TCP checksum are filled in place
+        ByteBuffer bytes = ByteBuffer.wrap(written);
+        Assert.assertEquals(0, Checksum.compute(written, 14, 20));
+        long pseudo = Checksum.pseudoHeader(bytes.getInt(26), bytes.getInt(30), 6, length - 34);
+        Assert.assertEquals(0, Checksum.finish(Checksum.sum(pseudo, written, 34, length - 34)));
+        Assert.assertArrayEquals(DATA, Arrays.copyOfRange(written, 54, length));
+    }
+
+    @Test
+    public void payloadChangesAfterSetPacket() {
+        TCP tcp = new TCP().setFlags(TCPFlags.newInstance((short) 2));
+        IPv4 ipv4 = new IPv4();
+        ipv4.setPacket(tcp);
+        // the payload is serialized when the packet is written
+        tcp.setSourcePort((short) 1234);
+        ipv4.setSourceAddress(Inet4Address.valueOf("10.0.0.1"));
+        byte[] bytes = ipv4.toBytes();
+        Assert.assertEquals(1234, ByteBuffer.wrap(bytes).getShort(20));
+        Assert.assertEquals(1234, ((TCP) ipv4.getPacket()).getSourcePort());
+        long pseudo = Checksum.pseudoHeader(ipv4.getSourceAddress().toInt(), ipv4.getDestinationAddress().toInt(),
+                6, bytes.length - 20);
+        Assert.assertEquals(0, Checksum.finish(Checksum.sum(pseudo, bytes, 20, bytes.length - 20)));
+
+        // reading the payload does not freeze it
+        Assert.assertSame(tcp, ipv4.getPacket());
+        tcp.setDestinationPort((short) 80);
+        ipv4.setDestinationAddress(Inet4Address.valueOf("10.0.0.2"));
+        bytes = ipv4.toBytes();
+        Assert.assertEquals(80, ByteBuffer.wrap(bytes).getShort(22));
+        pseudo = Checksum.pseudoHeader(ipv4.getSourceAddress().toInt(), ipv4.getDestinationAddress().toInt(),
+                6, bytes.length - 20);
+        Assert.assertEquals(0, Checksum.finish(Checksum.sum(pseudo, bytes, 20, bytes.length - 20)));
+    }
+
+    @Test
+    public void ipv6Udp() {
+        UDP udp = new UDP()
+                .setSourcePort((short) 5353)
+                .setDestinationPort((short) 5353)
+                .setPayload(DATA);
+        IPv6 ipv6 = new IPv6();
+        ipv6.setSourceAddress(Inet6Address.valueOf("fe80::1"));
+        ipv6.setDestinationAddress(Inet6Address.valueOf("ff02::fb"));
+        ipv6.setPacket(udp);
+        byte[] bytes = ipv6.toBytes();
+        Assert.assertEquals(ipv6.computeLength(), bytes.length);
+        ByteBuffer buffer = ByteBuffer.wrap(bytes);
+        Assert.assertEquals(8 + DATA.length, buffer.getShort(4));
+        Assert.assertEquals(8 + DATA.length, buffer.getShort(44));
+        Assert.assertArrayEquals(ipv6.getDestinationAddress().toBytes(), Arrays.copyOfRange(bytes, 24, 40));
+        long pseudo = Checksum.pseudoHeader(ipv6.getSourceAddress().toBytes(),
+                ipv6.getDestinationAddress().toBytes(), 17, bytes.length - 40);
+        Assert.assertEquals(0, Checksum.finish(Checksum.sum(pseudo, bytes, 40, bytes.length - 40)));
+    }
+
+    @Test
+    public void ipv6Icmp() {
+        ICMPv6 icmp = new ICMPv6();
+        icmp.setTypeAndCode(ICMPv6EchoRequest.ECHO_REQUEST);
+        icmp.setPayload(DATA);
+        IPv6 ipv6 = new IPv6();
+        ipv6.setSourceAddress(Inet6Address.valueOf("fe80::1"));
+        ipv6.setDestinationAddress(Inet6Address.valueOf("fe80::2"));
+        ipv6.setPacket(icmp);
+        byte[] bytes = ipv6.toBytes();
+        Assert.assertEquals(58, bytes[6]);
+        long pseudo = Checksum.pseudoHeader(ipv6.getSourceAddress().toBytes(),
+                ipv6.getDestinationAddress().toBytes(), 58, bytes.length - 40);
+        Assert.assertEquals(0, Checksum.finish(Checksum.sum(pseudo, bytes, 40, bytes.length - 40)));
+    }
+
+    @Test
+    public void padding() {
+        Ethernet ethernet = new Ethernet().setPadding(true);
+        ethernet.setPayload(new byte[] { 1, 2, 3 });
+        Assert.assertEquals(60, ethernet.computeLength());
+        ByteBuffer buffer = ByteBuffer.allocateDirect(60);
+        while (buffer.hasRemaining()) {
+            buffer.put((byte) 0xff);
+        }
+        buffer.clear();
+        ethernet.writeTo(buffer);
+        Assert.assertEquals(60, buffer.position());
+        for (int i = 17; i < 60; i++) {
+            Assert.assertEquals(0, buffer.get(i));
+        }
+    }
+
+}
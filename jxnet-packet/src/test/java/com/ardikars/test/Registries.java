@@ -0,0 +1,88 @@
+package com.ardikars.test;
+
+import com.ardikars.jxnet.TwoKeyMap;
+import com.ardikars.jxnet.packet.ethernet.ProtocolType;
+import com.ardikars.jxnet.packet.icmp.ICMPTypeAndCode;
+import com.ardikars.jxnet.packet.icmp.ICMPUnknownTypeAndCode;
+import com.ardikars.jxnet.packet.icmp.icmpv4.ICMPv4DestinationUnreachable;
+import com.ardikars.jxnet.packet.icmp.icmpv4.ICMPv4EchoRequest;
+import com.ardikars.jxnet.packet.ip.IPProtocolType;
+import org.junit.Assert;
+import org.junit.Test;
+
+public class Registries {
+
+    @Test
+    public void ipProtocolType() {
+        Assert.assertSame(IPProtocolType.TCP, IPProtocolType.getInstance((byte) 6));
+        Assert.assertSame(IPProtocolType.UDP, IPProtocolType.getInstance(Byte.valueOf((byte) 17)));
+        Assert.assertSame(IPProtocolType.UNKNOWN, IPProtocolType.getInstance((byte) 253));
+        Assert.assertSame(IPProtocolType.UNKNOWN, IPProtocolType.getInstance((Byte) null));
+
+        IPProtocolType experimental = new IPProtocolType((byte) 254, "Experimentation and testing") { };
+        Assert.assertNull(IPProtocolType.register(experimental));
+        Assert.assertSame(experimental, IPProtocolType.getInstance((byte) 254));
+    }
+
+    @Test
+    public void protocolType() {
+        Assert.assertSame(ProtocolType.IPV4, ProtocolType.getInstance((short) 0x0800));
+        Assert.assertSame(ProtocolType.IPV6, ProtocolType.getInstance(Short.valueOf((short) 0x86dd)));
+        Assert.assertSame(ProtocolType.UNKNOWN, ProtocolType.getInstance((short) 0x9000));
+
+        // IEEE 802.3 length fields
+        ProtocolType length = ProtocolType.getInstance((short) 46);
+        Assert.assertEquals(46, length.getValue().shortValue());
+        Assert.assertSame(length, ProtocolType.getInstance((short) 46));
+
+        ProtocolType lldp = new ProtocolType((short) 0x88cc, "LLDP");
+        Assert.assertNull(ProtocolType.register(lldp));
+        Assert.assertSame(lldp, ProtocolType.getInstance((short) 0x88cc));
+    }
+
+    @Test
+    public void icmpTypeAndCode() {
+        Assert.assertSame(ICMPv4EchoRequest.ECHO_REQUEST, ICMPTypeAndCode.getTypeAndCode((byte) 8, (byte) 0));
+        Assert.assertSame(ICMPv4DestinationUnreachable.FRAGMENTATION_REQUIRED,
+                ICMPTypeAndCode.getTypeAndCode(Byte.valueOf((byte) 3), Byte.valueOf((byte) 4)));
+        Assert.assertSame(ICMPUnknownTypeAndCode.UNKNOWN, ICMPTypeAndCode.getTypeAndCode((byte) 8, (byte) 1));
+        Assert.assertSame(ICMPUnknownTypeAndCode.UNKNOWN, ICMPTypeAndCode.getTypeAndCode((byte) 42, (byte) 0));
+        Assert.assertSame(ICMPUnknownTypeAndCode.UNKNOWN, ICMPTypeAndCode.getTypeAndCode(null, (Byte) (byte) 0));
+    }
+
+    @Test
+    public void icmpRegistryView() {
+        Photuris.register((byte) 0);
+        Assert.assertSame(Photuris.PHOTURIS, ICMPTypeAndCode.getTypeAndCode((byte) 40, (byte) 0));
+        Assert.assertSame(ICMPv4EchoRequest.ECHO_REQUEST,
+                Photuris.lookup(TwoKeyMap.newInstance((byte) 8, (byte) 0)));
+        Photuris.unregister((byte) 0);
+        Assert.assertSame(ICMPUnknownTypeAndCode.UNKNOWN, ICMPTypeAndCode.getTypeAndCode((byte) 40, (byte) 0));
+    }
+
+    /**
+     * A subclass registering through the protected map, as the ICMP subclasses used to.
+     */
+    private static final class Photuris extends ICMPTypeAndCode {
+
+        private static final Photuris PHOTURIS = new Photuris((byte) 0, "Bad SPI");
+
+        private Photuris(Byte code, String name) {
+            super((byte) 40, code, name);
+        }
+
+        private static void register(Byte code) {
+            registry.put(TwoKeyMap.newInstance((byte) 40, code), PHOTURIS);
+        }
+
+        private static void unregister(Byte code) {
+            registry.remove(TwoKeyMap.newInstance((byte) 40, code));
+        }
+
+        private static ICMPTypeAndCode lookup(TwoKeyMap<Byte, Byte> key) {
+            return registry.get(key);
+        }
+
+    }
+
+}